@@ -1,12 +1,19 @@
 import React, { useState, useEffect } from 'react';
 import { LineChart, Line, BarChart, Bar, Scatter, XAxis, YAxis, CartesianGrid, Tooltip, Legend, ResponsiveContainer, Area, AreaChart, Cell } from 'recharts';
 import { Upload, TrendingUp, TrendingDown, DollarSign, Clock, AlertCircle } from 'lucide-react';
+import { indexFelixResults, equityLevelRows, resultsToDashboard } from '../lib/felixResults';
+
+const EQUITY_CHART_POINTS = 2000;
 
 const TradingBacktestAnalysis = () => {
     const [basketData, setBasketData] = useState([]);
     const [tradeData, setTradeData] = useState([]);
     const [equityData, setEquityData] = useState([]);
     const [activeTab, setActiveTab] = useState('overview');
+    // Results file uploads: chart range (ns) and the pyramid level it was read from
+    const [resultsIndex, setResultsIndex] = useState(null);
+    const [equityRange, setEquityRange] = useState(null);
+    const [equityLevel, setEquityLevel] = useState(null);
 
     const handleFileUpload = (event, dataType) => {
         const file = event.target.files[0];
@@ -27,12 +34,58 @@ const TradingBacktestAnalysis = () => {
 
                 if (dataType === 'basket') setBasketData(data);
                 else if (dataType === 'trade') setTradeData(data);
-                else if (dataType === 'equity') setEquityData(data);
+                else if (dataType === 'equity') {
+                    setEquityData(data);
+                    setResultsIndex(null);
+                }
             };
             reader.readAsText(file);
         }
     };
 
+    // Engine results file: fills, trades and equity curve in one binary upload
+    const handleResultsUpload = (event) => {
+        const file = event.target.files[0];
+        if (file) {
+            const reader = new FileReader();
+            reader.onload = (e) => {
+                try {
+                    const index = indexFelixResults(e.target.result);
+                    const data = resultsToDashboard(index);
+                    setBasketData(data.basketData);
+                    setTradeData(data.tradeData);
+                    setEquityData(data.equityData);
+                    setResultsIndex(index);
+                    setEquityRange(null);
+                } catch (err) {
+                    console.error(`Could not read results file: ${err.message}`);
+                }
+            };
+            reader.readAsArrayBuffer(file);
+        }
+    };
+
+    // Re-read the equity curve at the level that fits the zoomed range
+    useEffect(() => {
+        if (!resultsIndex) return;
+        const start = equityRange ? equityRange.start : null;
+        const end = equityRange ? equityRange.end : null;
+        const { level, rows } = equityLevelRows(resultsIndex, start, end, EQUITY_CHART_POINTS);
+        setEquityLevel(level);
+        setEquityData(rows);
+    }, [resultsIndex, equityRange]);
+
+    // Zoom by `scale` around the middle of the range, or pan by `shift` spans
+    const zoomEquity = (scale, shift = 0) => {
+        if (!resultsIndex || equityData.length < 2) return;
+        const first = equityData[0].t;
+        const last = equityData[equityData.length - 1].t;
+        const span = last - first;
+        const mid = first + span / 2n + BigInt(Math.round(shift * Number(span)));
+        const half = BigInt(Math.max(1, Math.round(Number(span) * scale / 2)));
+        setEquityRange({ start: mid > half ? mid - half : 0n, end: mid + half });
+    };
+
     const verifyCommissionSlippage = () => {
         if (tradeData.length === 0) return null;
 
@@ -112,7 +165,10 @@ const TradingBacktestAnalysis = () => {
 
         return equityData.map((row, idx) => {
             const equity = parseFloat(row.total_equity) || runningEquity;
-            peak = Math.max(peak, equity);
+            // Downsampled rows (results file, equity_curve_lod*.csv) carry the drawdown
+            // of the full curve; a running peak over the kept points would understate it
+            const stored = parseFloat(row.drawdown);
+            peak = stored >= 0 && stored < 1 ? equity / (1 - stored) : Math.max(peak, equity);
             const drawdown = ((equity - peak) / peak) * 100;
 
             return {
@@ -194,6 +250,22 @@ const TradingBacktestAnalysis = () => {
 
                 {/* File Upload Section */}
                 <div className="grid grid-cols-1 gap-6 mb-8">
+                    <div className="border-2 border-dashed border-gray-200 rounded-lg p-10 hover:border-blue-500 transition-colors group cursor-pointer">
+                        <label className="flex flex-col items-center justify-center cursor-pointer w-full h-full">
+                            <Upload className="w-12 h-12 text-gray-300 group-hover:text-blue-500 mb-4 transition-colors" />
+                            <span className="text-xl font-medium text-gray-600 mb-2">Upload Engine Results</span>
+                            <span className="text-sm text-gray-400">
+                                results.fxr (fills, trades and equity curve in one file)
+                            </span>
+                            <input
+                                type="file"
+                                accept=".fxr"
+                                onChange={handleResultsUpload}
+                                className="hidden"
+                            />
+                        </label>
+                    </div>
+
                     <div className="border-2 border-dashed border-gray-200 rounded-lg p-10 hover:border-blue-500 transition-colors group cursor-pointer">
                         <label className="flex flex-col items-center justify-center cursor-pointer w-full h-full">
                             <Upload className="w-12 h-12 text-gray-300 group-hover:text-blue-500 mb-4 transition-colors" />
@@ -326,6 +398,16 @@ const TradingBacktestAnalysis = () => {
 
                 {activeTab === 'equity' && (
                     <div className="space-y-6">
+                        {resultsIndex && (
+                            <div className="flex items-center gap-2 text-sm">
+                                <button onClick={() => zoomEquity(0.5)} className="px-3 py-1 bg-gray-100 rounded hover:bg-gray-200">Zoom In</button>
+                                <button onClick={() => zoomEquity(2)} className="px-3 py-1 bg-gray-100 rounded hover:bg-gray-200">Zoom Out</button>
+                                <button onClick={() => zoomEquity(1, -0.5)} className="px-3 py-1 bg-gray-100 rounded hover:bg-gray-200">◀</button>
+                                <button onClick={() => zoomEquity(1, 0.5)} className="px-3 py-1 bg-gray-100 rounded hover:bg-gray-200">▶</button>
+                                <button onClick={() => setEquityRange(null)} className="px-3 py-1 bg-gray-100 rounded hover:bg-gray-200">Reset</button>
+                                <span className="text-gray-500">{equityLevel}: {equityData.length} points</span>
+                            </div>
+                        )}
                         <div>
                             <h3 className="text-lg font-semibold mb-4">Equity Curve</h3>
                             <ResponsiveContainer width="100%" height={300}>
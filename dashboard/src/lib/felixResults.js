@@ -0,0 +1,329 @@
+// Reader for the engine's columnar results file (engine/include/felix/results_file.hpp).
+// Tables are indexed first and decoded on demand, so a chart reads only the
+// equity pyramid level it shows.
+//
+// Layout (little endian):
+//   header  "FELIXRES" | u32 version | u32 reserved
+//   chunk   u8 name_len | table name | u32 rows | u8 columns, then per column
+//           u8 name_len | column name | u8 type | u8 codec | u32 byte size | data
+//
+// Types: 0 u8, 1 u32, 2 u64, 3 f64. Codecs: 0 raw, 1 zigzag varint deltas
+// (integers), 2 XOR'd doubles with a (leading << 4 | trailing) zero-byte header.
+// u64 columns decode to BigUint64Array, the others to Uint8Array / Uint32Array /
+// Float64Array.
+
+const MAGIC = 'FELIXRES';
+const VERSION = 1;
+const TYPE_U8 = 0;
+const TYPE_U32 = 1;
+const TYPE_U64 = 2;
+const TYPE_F64 = 3;
+const CODEC_RAW = 0;
+const CODEC_DELTA_VARINT = 1;
+const CODEC_XOR_DOUBLE = 2;
+
+const WIDTH = { [TYPE_U8]: 1, [TYPE_U32]: 4, [TYPE_U64]: 8, [TYPE_F64]: 8 };
+const U64_MASK = (1n << 64n) - 1n;
+
+const newColumn = (type, rows) => {
+    if (type === TYPE_U8) return new Uint8Array(rows);
+    if (type === TYPE_U32) return new Uint32Array(rows);
+    if (type === TYPE_U64) return new BigUint64Array(rows);
+    return new Float64Array(rows);
+};
+
+const decodeRaw = (view, offset, type, rows) => {
+    const out = newColumn(type, rows);
+    for (let i = 0; i < rows; i++) {
+        const at = offset + i * WIDTH[type];
+        if (type === TYPE_U8) out[i] = view.getUint8(at);
+        else if (type === TYPE_U32) out[i] = view.getUint32(at, true);
+        else if (type === TYPE_U64) out[i] = view.getBigUint64(at, true);
+        else out[i] = view.getFloat64(at, true);
+    }
+    return out;
+};
+
+const decodeDeltas = (bytes, type, rows) => {
+    const out = newColumn(type, rows);
+    let pos = 0;
+    if (type === TYPE_U64) {
+        let prev = 0n;
+        for (let i = 0; i < rows; i++) {
+            let zz = 0n;
+            let shift = 0n;
+            let b;
+            do {
+                b = bytes[pos++];
+                zz |= BigInt(b & 0x7f) << shift;
+                shift += 7n;
+            } while (b & 0x80);
+            const delta = (zz >> 1n) ^ -(zz & 1n);
+            prev = (prev + delta) & U64_MASK;
+            out[i] = prev;
+        }
+    } else {
+        // u8 / u32 values: every delta fits a double exactly
+        let prev = 0;
+        for (let i = 0; i < rows; i++) {
+            let zz = 0;
+            let scale = 1;
+            let b;
+            do {
+                b = bytes[pos++];
+                zz += (b & 0x7f) * scale;
+                scale *= 128;
+            } while (b & 0x80);
+            prev += zz % 2 ? -(zz + 1) / 2 : zz / 2;
+            out[i] = prev;
+        }
+    }
+    if (pos !== bytes.length) throw new Error('results file: bad varint column');
+    return out;
+};
+
+const decodeDoubles = (bytes, rows) => {
+    const out = new Float64Array(rows);
+    const scratch = new DataView(new ArrayBuffer(8));
+    let lo = 0;
+    let hi = 0;
+    let pos = 0;
+    for (let i = 0; i < rows; i++) {
+        const header = bytes[pos++];
+        const lead = header >> 4;
+        const trail = header & 0x0f;
+        let xlo = 0;
+        let xhi = 0;
+        for (let b = trail; b < 8 - lead; b++) {
+            const byte = bytes[pos++];
+            if (b < 4) xlo |= byte << (8 * b);
+            else xhi |= byte << (8 * (b - 4));
+        }
+        lo = (lo ^ xlo) >>> 0;
+        hi = (hi ^ xhi) >>> 0;
+        scratch.setUint32(0, lo, true);
+        scratch.setUint32(4, hi, true);
+        out[i] = scratch.getFloat64(0, true);
+    }
+    if (pos !== bytes.length) throw new Error('results file: bad double column');
+    return out;
+};
+
+const concatColumns = (a, b) => {
+    const out = new a.constructor(a.length + b.length);
+    out.set(a);
+    out.set(b, a.length);
+    return out;
+};
+
+// Chunk layout of every table, without decoding any column; a truncated
+// trailing chunk is ignored. Decoded tables are cached on the index.
+export const indexFelixResults = (buffer) => {
+    const view = new DataView(buffer);
+    const bytes = new Uint8Array(buffer);
+    const text = (at, len) => String.fromCharCode(...bytes.subarray(at, at + len));
+
+    if (bytes.length < 16 || text(0, 8) !== MAGIC || view.getUint32(8, true) !== VERSION) {
+        throw new Error('Not a Felix results file');
+    }
+
+    const tables = {};
+    let pos = 16;
+    while (pos < bytes.length) {
+        try {
+            const nameLen = bytes[pos];
+            const name = text(pos + 1, nameLen);
+            pos += 1 + nameLen;
+            const rows = view.getUint32(pos, true);
+            const columnCount = bytes[pos + 4];
+            pos += 5;
+
+            const columns = [];
+            for (let c = 0; c < columnCount; c++) {
+                const colLen = bytes[pos];
+                const colName = text(pos + 1, colLen);
+                pos += 1 + colLen;
+                const type = bytes[pos];
+                const codec = bytes[pos + 1];
+                const size = view.getUint32(pos + 2, true);
+                pos += 6;
+                if (pos + size > bytes.length) throw new Error('truncated');
+                columns.push({ name: colName, type, codec, offset: pos, size });
+                pos += size;
+            }
+
+            if (!tables[name]) tables[name] = { rows: 0, chunks: [] };
+            tables[name].rows += rows;
+            tables[name].chunks.push({ rows, columns });
+        } catch (err) {
+            console.warn(`Results file: stopped at byte ${pos} (${err.message})`);
+            break;
+        }
+    }
+    return { buffer, tables, cache: {} };
+};
+
+// { rows, columns: { name: TypedArray } } for one table, or null
+export const readFelixTable = (index, name) => {
+    if (index.cache[name]) return index.cache[name];
+    const table = index.tables[name];
+    if (!table) return null;
+
+    const view = new DataView(index.buffer);
+    const bytes = new Uint8Array(index.buffer);
+    let columns = null;
+    for (const chunk of table.chunks) {
+        const decoded = {};
+        for (const { name: colName, type, codec, offset, size } of chunk.columns) {
+            const data = bytes.subarray(offset, offset + size);
+            if (codec === CODEC_RAW) decoded[colName] = decodeRaw(view, offset, type, chunk.rows);
+            else if (codec === CODEC_DELTA_VARINT) decoded[colName] = decodeDeltas(data, type, chunk.rows);
+            else if (codec === CODEC_XOR_DOUBLE) decoded[colName] = decodeDoubles(data, chunk.rows);
+            else throw new Error(`unknown codec ${codec}`);
+        }
+        if (!columns) {
+            columns = decoded;
+        } else {
+            for (const key of Object.keys(columns)) {
+                columns[key] = concatColumns(columns[key], decoded[key]);
+            }
+        }
+    }
+    index.cache[name] = { rows: table.rows, columns };
+    return index.cache[name];
+};
+
+// Every table decoded: { table: { rows, columns: { name: TypedArray } } }
+export const readFelixResults = (buffer) => {
+    const index = indexFelixResults(buffer);
+    const tables = {};
+    for (const name of Object.keys(index.tables)) {
+        tables[name] = readFelixTable(index, name);
+    }
+    return tables;
+};
+
+// Equity pyramid tables (engine downsample.hpp), coarsest first, then the full curve
+export const equityLevels = (index) => {
+    const levels = Object.keys(index.tables)
+        .filter(name => name.startsWith('equity_lod'))
+        .sort((a, b) => parseInt(a.slice(10)) - parseInt(b.slice(10)));
+    if (index.tables.equity) levels.push('equity');
+    return levels.map(name => ({ name, rows: index.tables[name].rows }));
+};
+
+// Full curve with drawdown from the running peak, in the pyramid's columns
+const fullEquityLevel = (index) => {
+    if (index.cache.equity_full) return index.cache.equity_full;
+    const { rows, columns } = readFelixTable(index, 'equity');
+    const drawdown = new Float64Array(rows);
+    const position = new BigUint64Array(rows);
+    let peak = rows > 0 ? columns.equity[0] : 0;
+    for (let i = 0; i < rows; i++) {
+        peak = Math.max(peak, columns.equity[i]);
+        drawdown[i] = peak > 0 ? (peak - columns.equity[i]) / peak : 0;
+        position[i] = BigInt(i);
+    }
+    index.cache.equity_full = {
+        rows,
+        columns: { index: position, timestamp: columns.timestamp, equity: columns.equity, drawdown }
+    };
+    return index.cache.equity_full;
+};
+
+const lowerBound = (values, target) => {
+    let lo = 0;
+    let hi = values.length;
+    while (lo < hi) {
+        const mid = (lo + hi) >> 1;
+        if (values[mid] < target) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+};
+
+const timeLabel = (ns, spanNs) => {
+    const iso = new Date(Number(ns / 1000000n)).toISOString();
+    return spanNs > 3n * 86400n * 1000000000n ? iso.slice(0, 10) : iso.slice(5, 19).replace('T', ' ');
+};
+
+// Equity rows between start and end (ns BigInts, null = open) from the
+// coarsest level with at least `points` rows there; only that level is decoded
+export const equityLevelRows = (index, start, end, points = 2000) => {
+    const levels = equityLevels(index);
+    if (levels.length === 0) return { level: null, rows: [] };
+
+    const total = levels[levels.length - 1].rows;
+    let share = 1;
+    if (levels.length > 1 && (start !== null || end !== null)) {
+        const coarse = readFelixTable(index, levels[0].name).columns;
+        const lo = start === null ? 0 : lowerBound(coarse.timestamp, start);
+        const hi = end === null ? coarse.timestamp.length : lowerBound(coarse.timestamp, end + 1n);
+        const first = coarse.index[Math.max(lo - 1, 0)];
+        const last = coarse.index[Math.min(hi, coarse.index.length - 1)];
+        share = Number(last - first + 1n) / Math.max(total, 1);
+    }
+
+    const level = levels.find(l => l.rows * share >= points) || levels[levels.length - 1];
+    const { columns } = level.name === 'equity' ? fullEquityLevel(index) : readFelixTable(index, level.name);
+    const ts = columns.timestamp;
+    const lo = start === null ? 0 : lowerBound(ts, start);
+    const hi = end === null ? ts.length : lowerBound(ts, end + 1n);
+    const capital = columns.equity.length > 0 ? columns.equity[0] : 0;
+    const span = hi > lo ? ts[hi - 1] - ts[lo] : 0n;
+
+    const rows = [];
+    for (let i = lo; i < hi; i++) {
+        rows.push({
+            t: ts[i],
+            date: timeLabel(ts[i], span),
+            total_equity: columns.equity[i],
+            capital,
+            drawdown: columns.drawdown[i]
+        });
+    }
+    return { level: level.name, rows };
+};
+
+const nsToDate = (ns) => new Date(Number(ns / 1000000n)).toISOString().slice(0, 10);
+
+// Rows in the shape of the dashboard's CSV uploads (basket summary, trade log,
+// equity curve); the equity curve is read from the pyramid at chart resolution
+export const resultsToDashboard = (index) => {
+    const equityData = equityLevelRows(index, null, null).rows;
+    const tables = {
+        trades: readFelixTable(index, 'trades'),
+        fills: readFelixTable(index, 'fills')
+    };
+
+    // Closed round trips stand in for baskets
+    const basketData = [];
+    const trades = tables.trades;
+    if (trades) {
+        const { exit_time, holding_ns, pnl } = trades.columns;
+        for (let i = 0; i < trades.rows; i++) {
+            basketData.push({
+                date: nsToDate(exit_time[i]),
+                net_pnl: pnl[i],
+                duration_seconds: Math.max(0.001, Number(holding_ns[i]) / 1e9)
+            });
+        }
+    }
+
+    // One trade-log row per fill; slippage is in bps (one bp counted as a pip)
+    const tradeData = [];
+    const fills = tables.fills;
+    if (fills) {
+        const { order_id, volume, slippage } = fills.columns;
+        for (let i = 0; i < fills.rows; i++) {
+            tradeData.push({
+                basket_id: `order-${order_id[i]}`,
+                trade_num: String(i + 1),
+                lot_size: volume[i],
+                slippage_pips: slippage[i]
+            });
+        }
+    }
+
+    return { basketData, tradeData, equityData };
+};
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace felix {
+
+/**
+ * Column Codecs - Section 8.4
+ * Shared by the equity store and the results file. Integers are stored as
+ * zigzag varint deltas (small for timestamps, ids and repeated values);
+ * doubles are XOR'd with the previous value, and a header byte holds the
+ * number of leading (high nibble) and trailing (low nibble) zero bytes,
+ * followed by the remaining middle bytes. Decoders take a read cursor and
+ * advance it past the column.
+ */
+inline void put_varint(std::vector<uint8_t>& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+inline uint64_t get_varint(const uint8_t*& p) {
+    uint64_t value = 0;
+    int shift = 0;
+    while (*p & 0x80) {
+        value |= static_cast<uint64_t>(*p++ & 0x7F) << shift;
+        shift += 7;
+    }
+    value |= static_cast<uint64_t>(*p++) << shift;
+    return value;
+}
+
+inline void encode_deltas(std::vector<uint8_t>& out, const uint64_t* values, size_t count) {
+    uint64_t prev = 0;
+    for (size_t i = 0; i < count; ++i) {
+        int64_t delta = static_cast<int64_t>(values[i] - prev);
+        put_varint(out, (static_cast<uint64_t>(delta) << 1) ^ static_cast<uint64_t>(delta >> 63));
+        prev = values[i];
+    }
+}
+
+inline void decode_deltas(const uint8_t*& p, size_t count, std::vector<uint64_t>& out) {
+    uint64_t prev = 0;
+    for (size_t i = 0; i < count; ++i) {
+        uint64_t zz = get_varint(p);
+        prev += (zz >> 1) ^ (~(zz & 1) + 1);
+        out.push_back(prev);
+    }
+}
+
+inline void encode_doubles(std::vector<uint8_t>& out, const double* values, size_t count) {
+    uint64_t prev = 0;
+    for (size_t i = 0; i < count; ++i) {
+        uint64_t bits = std::bit_cast<uint64_t>(values[i]);
+        uint64_t x = bits ^ prev;
+        prev = bits;
+        if (x == 0) {
+            out.push_back(0x80);
+            continue;
+        }
+        int lead = std::countl_zero(x) / 8;
+        int trail = std::countr_zero(x) / 8;
+        out.push_back(static_cast<uint8_t>((lead << 4) | trail));
+        for (int b = trail; b < 8 - lead; ++b) {
+            out.push_back(static_cast<uint8_t>(x >> (8 * b)));
+        }
+    }
+}
+
+inline void decode_doubles(const uint8_t*& p, size_t count, std::vector<double>& out) {
+    uint64_t prev = 0;
+    for (size_t i = 0; i < count; ++i) {
+        uint8_t header = *p++;
+        int lead = header >> 4;
+        int trail = header & 0x0F;
+        uint64_t x = 0;
+        for (int b = trail; b < 8 - lead; ++b) {
+            x |= static_cast<uint64_t>(*p++) << (8 * b);
+        }
+        prev ^= x;
+        out.push_back(std::bit_cast<double>(prev));
+    }
+}
+
+} // namespace felix
@@ -1,6 +1,8 @@
 #pragma once
 
+#include "felix/symbol_table.hpp"
 #include "felix/tick_record.hpp"
+#include <memory>
 #include <vector>
 #include <string>
 
@@ -8,7 +10,10 @@ namespace felix {
 
 /**
  * DataStream - Section 4.1
- * Memory-mapped binary tick data access
+ * Memory-mapped binary tick data access.
+ * Ticks are shared: view() returns a stream over a sub-range of the same
+ * memory with its own cursor, so windows over one dataset (walk-forward
+ * folds) cost no copies and can be replayed concurrently.
  */
 class DataStream {
 public:
@@ -25,11 +30,26 @@ public:
     const TickRecord& peek() const;
     void reset();
     
+    // Bulk access for scans that look ahead of the cursor
+    const TickRecord* data() const;
+    
+    // Zero-copy sub-range [begin, end) of this stream, cursor at its start.
+    // Ticks keep the symbol indices of the full dataset.
+    DataStream view(size_t begin, size_t end) const;
+    // First index with timestamp >= ts (ticks are in timestamp order)
+    size_t lower_bound(uint64_t timestamp) const;
+    
     // Current position
     size_t current_index() const { return current_index_; }
+    
+    // Symbols seen in the file, in first-appearance order
+    const SymbolTable& symbols() const { return symbols_; }
 
 private:
-    std::vector<TickRecord> ticks_;
+    std::shared_ptr<const std::vector<TickRecord>> storage_;
+    const TickRecord* ticks_ = nullptr;   // First tick of this stream / view
+    size_t size_ = 0;
+    SymbolTable symbols_;
     size_t current_index_;
 };
 
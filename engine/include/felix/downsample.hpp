@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace felix {
+
+/**
+ * Downsampling - Section 8.4
+ * Both return ascending indices into the input and always keep the first
+ * and last point.
+ * - lttb_indices: Largest-Triangle-Three-Buckets, `threshold` points that
+ *   keep the visual shape of the line
+ * - extrema_indices: per bucket, the points with the lowest and highest
+ *   value (at most 2 * buckets + 2 points)
+ * Inputs no longer than the requested size are returned whole.
+ */
+std::vector<size_t> lttb_indices(const double* x, const double* y, size_t count, size_t threshold);
+std::vector<size_t> extrema_indices(const double* y, size_t count, size_t buckets);
+
+struct EquityPyramidConfig {
+    uint32_t base_points = 2048;     // Coarsest level (0 = no pyramid)
+    uint32_t factor = 4;             // Each level has factor x the points of the previous one
+};
+
+/**
+ * Equity Level Point - one kept point of the full-resolution curve
+ * Drawdown is measured against the running peak of the full curve, so it
+ * is exact at every level.
+ */
+struct EquityLevelPoint {
+    uint64_t index = 0;              // Row in the full curve
+    uint64_t timestamp = 0;
+    double equity = 0.0;
+    double drawdown = 0.0;           // Fraction below the running peak
+};
+
+/**
+ * Equity Pyramid - Section 8.4
+ *
+ * Multi-resolution equity and drawdown series for charts. Level k spans
+ * the whole curve with at most base_points * factor^k points: half chosen
+ * by LTTB on equity, the other half the equity and drawdown extremes of
+ * each bucket, so peaks and the deepest drawdowns survive at every zoom.
+ * The finest level is at least `factor` times smaller than the curve; a
+ * chart that needs more detail uses the curve itself. Coarsest level first.
+ */
+struct EquityPyramid {
+    std::vector<std::vector<EquityLevelPoint>> levels;
+};
+
+EquityPyramid build_equity_pyramid(const uint64_t* timestamps, const double* equity, size_t count,
+                                   const EquityPyramidConfig& config);
+
+} // namespace felix
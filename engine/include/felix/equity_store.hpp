@@ -0,0 +1,125 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace felix {
+
+/**
+ * Equity Point - Section 4.2
+ */
+struct EquityPoint {
+    uint64_t timestamp = 0;
+    double equity = 0.0;
+    double cash = 0.0;
+    double unrealized_pnl = 0.0;
+};
+
+/**
+ * Equity Sampling - Section 8.4
+ * Which mark-to-market steps are recorded on the equity curve
+ */
+enum class EquitySampling {
+    EVERY_TICK,     // Every mark-to-market step
+    EVERY_N_TICKS,  // Every N-th mark-to-market step
+    INTERVAL,       // At most once per interval_ns of stream time
+    ON_CHANGE,      // When equity moved by more than min_change since the last point
+    ON_FILL         // First mark-to-market step after a fill
+};
+
+struct EquityRecordingConfig {
+    EquitySampling sampling = EquitySampling::EVERY_TICK;
+    uint64_t every_n_ticks = 1;
+    uint64_t interval_ns = 0;
+    double min_change = 0.0;
+    size_t block_size = 4096;       // Points per compressed block
+    std::string spill_path;         // Non-empty: sealed blocks are written here
+};
+
+/**
+ * Equity Store - Section 8.4
+ *
+ * Columnar equity curve: points are buffered per column in an open block,
+ * which is sealed into a compressed block once full (timestamps as zigzag
+ * varint deltas, doubles XOR'd against the previous value with zero bytes
+ * trimmed). With a spill file, sealed blocks are handed to a background
+ * writer and dropped from memory, so resident size stays bounded by one
+ * open block plus the writer queue.
+ */
+class EquityStore {
+public:
+    explicit EquityStore(size_t block_size = 4096);
+    ~EquityStore();
+
+    EquityStore(const EquityStore&) = delete;
+    EquityStore& operator=(const EquityStore&) = delete;
+
+    // Start spilling sealed blocks to path (truncated); existing sealed blocks are written too
+    bool open_spill(const std::string& path);
+
+    void append(const EquityPoint& point);
+
+    size_t size() const { return sealed_count_ + open_ts_.size(); }
+    bool empty() const { return size() == 0; }
+    const EquityPoint& back() const { return last_; }
+
+    // Decoded views - blocks are decoded column by column
+    std::vector<EquityPoint> points() const;
+    std::vector<uint64_t> timestamps() const;
+    std::vector<double> equity_values() const;
+
+    size_t resident_bytes() const;
+    size_t spilled_bytes() const { return spill_offset_; }
+    bool spilling() const { return writer_.joinable(); }
+
+private:
+    enum Column : size_t { kTimestamp = 0, kEquity, kCash, kUnrealized, kColumns };
+
+    struct Block {
+        uint32_t count = 0;
+        uint32_t column_bytes[kColumns] = {};
+        uint64_t file_offset = 0;
+        std::vector<uint8_t> data;      // Empty once spilled
+    };
+
+    void seal_block();
+    void enqueue_spill(Block& block);
+    void writer_main();
+    void wait_for_writer() const;
+
+    // Raw bytes of one column of a sealed block (from memory or the spill file)
+    std::vector<uint8_t> load_column(const Block& block, size_t column) const;
+    void decode_timestamps(const Block& block, std::vector<uint64_t>& out) const;
+    void decode_doubles(const Block& block, size_t column, std::vector<double>& out) const;
+
+    size_t block_size_;
+    size_t sealed_count_ = 0;
+    EquityPoint last_;
+    std::vector<Block> blocks_;
+
+    // Open block, one vector per column
+    std::vector<uint64_t> open_ts_;
+    std::vector<double> open_equity_;
+    std::vector<double> open_cash_;
+    std::vector<double> open_unrealized_;
+
+    // Spill state - the writer thread owns out_
+    std::string spill_path_;
+    uint64_t spill_offset_ = 0;
+    std::ofstream out_;
+    std::thread writer_;
+    mutable std::mutex mutex_;
+    mutable std::condition_variable cv_;
+    std::deque<std::vector<uint8_t>> queue_;
+    bool writing_ = false;
+    bool stop_ = false;
+};
+
+} // namespace felix
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace felix {
+
+/**
+ * EWMA Volatility - Section 8.3
+ * RiskMetrics-style exponentially weighted variance of tick log returns.
+ * O(1) per update, no history kept.
+ */
+class EwmaVolatility {
+public:
+    void update(double price);
+    void set_decay(double lambda) { lambda_ = lambda; }
+
+    double variance() const { return variance_; }
+    double sigma() const;                 // Per-tick std dev of log returns
+    uint64_t samples() const { return samples_; }
+
+private:
+    double lambda_ = 0.94;
+    double last_price_ = 0.0;
+    double variance_ = 0.0;
+    uint64_t samples_ = 0;
+};
+
+/**
+ * Rolling Volume - Section 8.3
+ * Average daily traded volume over the last N trading days.
+ * Days are bucketed by tick timestamp (ns); only days with ticks count.
+ */
+class RollingVolume {
+public:
+    static constexpr size_t kMaxDays = 64;
+    static constexpr uint64_t kNsPerDay = 86400ULL * 1000000000ULL;
+
+    void update(uint64_t timestamp, double volume);
+    void set_window(uint32_t days);
+
+    double adv() const;                   // Falls back to today's volume until a day completes
+    double today_volume() const { return today_volume_; }
+
+private:
+    std::array<double, kMaxDays> days_{};
+    size_t window_ = 20;
+    size_t head_ = 0;                     // Next slot to write
+    size_t count_ = 0;                    // Completed days in window
+    double window_sum_ = 0.0;
+    uint64_t current_day_ = 0;
+    double today_volume_ = 0.0;
+    bool started_ = false;
+};
+
+} // namespace felix
@@ -1,17 +1,62 @@
 #pragma once
 
 #include "felix/datastream.hpp"
+#include "felix/indicators.hpp"
+#include "felix/journal.hpp"
 #include "felix/matching.hpp"
 #include "felix/portfolio.hpp"
+#include "felix/results_file.hpp"
 #include "felix/risk.hpp"
 #include "felix/tick_record.hpp"
+#include "felix/tick_window.hpp"
+#include "felix/trigger_scan.hpp"
 #include <functional>
 #include <memory>
+#include <vector>
 
 namespace felix {
 
 // Forward declare strategy wrapper
 class StrategyWrapper;
+struct SignalSchedule;
+struct NativeCallbacks;
+
+/**
+ * Wake Filter - Section 5.3
+ * Native wake conditions for the strategy. When enabled, the strategy is
+ * woken only on ticks whose last price crosses a level or when the timer
+ * elapses, so the event loop can fast-forward through everything else.
+ * An enabled filter with no conditions never wakes the strategy.
+ */
+struct WakeFilter {
+    bool enabled = false;
+    double price_above = 0.0;    // Wake when last price >= level (0 = off)
+    double price_below = 0.0;    // Wake when last price <= level (0 = off)
+    uint64_t interval_ns = 0;    // Wake once this long has passed since the last wake (0 = off)
+};
+
+/**
+ * Strategy Slot - Section 7
+ * One strategy of a multi-strategy run and its own book. The book gets
+ * the strategy's fills and is marked to market every tick, so it holds the
+ * strategy's positions, equity curve, trades and metrics.
+ */
+struct StrategySlot {
+    StrategyWrapper* strategy = nullptr;
+    Portfolio* book = nullptr;
+};
+
+/**
+ * Capital Mode - Section 7 / 8.4
+ * SHARED: the strategies trade one pool; pre-trade risk checks see the
+ * combined portfolio. ISOLATED: each strategy trades its own book's cash
+ * and positions; pre-trade checks see only that book. Drawdown and daily
+ * loss limits always apply to the combined portfolio.
+ */
+enum class CapitalMode : uint8_t {
+    SHARED,
+    ISOLATED
+};
 
 /**
  * Event Loop - Section 5.2 of design.txt
@@ -29,14 +74,54 @@ public:
     void set_matching_engine(MatchingEngine* engine);
     void set_portfolio(Portfolio* portfolio);
     void set_risk_engine(RiskEngine* risk_engine);
+    // Updated with every tick before the strategy sees it; reset when a run starts
+    void set_indicators(IndicatorSet* indicators) { indicators_ = indicators; }
+    // Recent ticks / bars per symbol, same lifecycle as the indicators
+    void set_tick_window(TickWindow* window) { tick_window_ = window; }
 
     // Run the backtest - processes all events in order
     void run(DataStream& stream, StrategyWrapper& strategy);
+    
+    // Run precomputed signals with a native strategy - no per-tick callbacks
+    // (signal_strategy.hpp). Returns the number of orders submitted.
+    uint64_t run_signals(DataStream& stream, const SignalSchedule& schedule);
 
+    // Run a strategy given as C ABI callbacks (native_strategy.hpp) - no
+    // interpreter involved. Returns the number of orders submitted.
+    uint64_t run_native(DataStream& stream, const NativeCallbacks& callbacks);
+
+    // Run several strategies in one pass (Section 7): each tick updates market
+    // state once, then wakes every strategy in slot order. Orders are tagged
+    // with the slot's 1-based id and fills routed to its book; the loop's
+    // portfolio is the combined book (the pool, or the sum of the books'
+    // capital when ISOLATED) and carries the risk engine.
+    void run_multi(DataStream& stream, const std::vector<StrategySlot>& strategies,
+                   CapitalMode capital = CapitalMode::SHARED);
+
+    // Fast-forward (Section 5.3): skip order processing and strategy calls on
+    // ticks that provably cannot trigger; results match tick-by-tick runs
+    void set_fast_forward(bool enabled) { fast_forward_ = enabled; }
+    void set_wake_filter(const WakeFilter& filter) { wake_filter_ = filter; }
+    const WakeFilter& wake_filter() const { return wake_filter_; }
+    
+    // Binary run journal: orders, fills, risk halts and state hashes (see journal.hpp)
+    void set_journal_config(const JournalConfig& config) { journal_config_ = config; }
+    const JournalConfig& journal_config() const { return journal_config_; }
+    uint64_t journal_records() const { return journal_.records_written(); }
+
+    // Columnar results file (see results_file.hpp): the portfolio's fills,
+    // closed trades and equity points are streamed to it during the run
+    void set_results_config(const ResultsFileConfig& config) { results_config_ = config; }
+    const ResultsFileConfig& results_config() const { return results_config_; }
+
+    // Console logging of run progress and fills (on by default)
+    void set_verbose(bool verbose) { verbose_ = verbose; }
+    
     // Statistics
     uint64_t ticks_processed() const { return ticks_processed_; }
     uint64_t orders_processed() const { return orders_processed_; }
     uint64_t fills_generated() const { return fills_generated_; }
+    uint64_t ticks_fast_forwarded() const { return ticks_fast_forwarded_; }
 
 private:
     // Process a single tick event
@@ -50,17 +135,51 @@ private:
     
     // Check risk limits and handle violations
     void check_risk_limits(StrategyWrapper& strategy);
+    
+    // Per-tick bookkeeping after the tick's events (halt check, progress)
+    void finish_tick();
+
+    // Append what the portfolio recorded since the last call to the results file
+    void stream_results();
+    
+    // Fast-forward helpers - Section 5.3
+    bool wake_filter_matches(const TickRecord& tick) const;
+    bool can_fast_forward(const StrategyWrapper& strategy) const;
+    void build_trigger_envelope(const DataStream& stream, const StrategyWrapper& strategy);
+    void process_quiet_tick(const TickRecord& tick, StrategyWrapper& strategy);
 
     MatchingEngine* matching_engine_ = nullptr;
     Portfolio* portfolio_ = nullptr;
     RiskEngine* risk_engine_ = nullptr;
+    IndicatorSet* indicators_ = nullptr;
+    TickWindow* tick_window_ = nullptr;
+    std::vector<Portfolio*> books_;   // Per-strategy books of a multi-strategy run
 
     uint64_t ticks_processed_ = 0;
     uint64_t orders_processed_ = 0;
     uint64_t fills_generated_ = 0;
     
-    double peak_equity_ = 0.0;
     bool risk_halted_ = false;
+    bool verbose_ = true;
+    
+    // Fast-forward state
+    bool fast_forward_ = false;
+    WakeFilter wake_filter_;
+    uint64_t last_wake_ts_ = 0;
+    uint64_t ticks_fast_forwarded_ = 0;
+    TriggerEnvelope envelope_;
+    
+    // Run journal
+    JournalConfig journal_config_;
+    RunJournal journal_;
+    uint64_t current_timestamp_ = 0;
+
+    // Results file, and how much of the portfolio's logs it has seen
+    ResultsFileConfig results_config_;
+    ResultsWriter results_;
+    size_t results_fills_ = 0;
+    size_t results_trades_ = 0;
+    size_t results_equity_ = 0;
 };
 
 /**
@@ -19,7 +19,8 @@ enum class OrderType {
     MARKET,
     LIMIT,
     STOP,
-    STOP_LIMIT
+    STOP_LIMIT,
+    TRAILING_STOP
 };
 
 /**
@@ -48,6 +49,30 @@ struct Order {
     uint64_t activation_time = 0;  // When order becomes active (after latency)
     OrderStatus status = OrderStatus::PENDING;
     double queue_position = 0.0;   // For queue modeling (Section 6.2)
+    double filled_size = 0.0;      // Cumulative filled quantity (PARTIAL orders)
+    uint32_t fill_count = 0;       // Fills generated so far
+
+    // Contingent orders (Section 6.4)
+    double stop_price = 0.0;       // STOP_LIMIT trigger (price is the limit)
+    double trail_offset = 0.0;     // TRAILING_STOP distance from the water mark
+    double trail_anchor = 0.0;     // High-water (SELL) / low-water (BUY) mark
+    bool trail_percent = false;    // trail_offset is a fraction of the water mark
+    uint64_t parent_id = 0;        // Bracket entry this exit leg belongs to
+    uint32_t oco_group = 0;        // Legs sharing one exit quantity (0 = none)
+    uint32_t child_group = 0;      // Group armed by this order's fills (bracket entry)
+    uint32_t strategy_id = 0;      // Submitting strategy in multi-strategy runs (0 = untagged)
+
+    double remaining() const { return size - filled_size; }
+};
+
+/**
+ * Bracket Order - Section 6.4
+ * Entry plus stop-loss and take-profit exits linked as an OCO pair
+ */
+struct BracketOrder {
+    uint64_t entry_id = 0;
+    uint64_t stop_loss_id = 0;      // 0 if no stop-loss leg
+    uint64_t take_profit_id = 0;    // 0 if no take-profit leg
 };
 
 /**
@@ -61,6 +86,7 @@ struct Fill {
     double volume = 0.0;
     uint64_t timestamp = 0;
     double slippage = 0.0;  // Slippage in basis points
+    uint32_t strategy_id = 0;  // From the order (multi-strategy runs)
 };
 
 } // namespace felix
\ No newline at end of file
@@ -0,0 +1,257 @@
+#pragma once
+
+#include "felix/symbol_table.hpp"
+#include "felix/tick_record.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <variant>
+#include <vector>
+
+namespace felix {
+
+/**
+ * Indicators - Section 7
+ *
+ * Incremental technical indicators for strategies. Every update is O(1):
+ * windowed indicators keep running sums over a fixed ring of the last N
+ * inputs, rolling min / max keep a monotonic deque, and RSI / ATR use
+ * Wilder smoothing. value() is NaN until the indicator is ready().
+ */
+
+// Fixed-capacity ring of the last N values
+class RollingWindow {
+public:
+    explicit RollingWindow(uint32_t period = 1);
+
+    // Appends x; returns true and sets evicted when the window was full
+    bool push(double x, double& evicted);
+
+    size_t size() const { return count_; }
+    size_t capacity() const { return values_.size(); }
+    bool full() const { return count_ == values_.size(); }
+
+private:
+    std::vector<double> values_;
+    size_t head_ = 0;                     // Oldest value when full
+    size_t count_ = 0;
+};
+
+class Sma {
+public:
+    explicit Sma(uint32_t period = 1) : window_(period) {}
+    void update(double x);
+    bool ready() const { return window_.full(); }
+    double value() const;
+
+private:
+    RollingWindow window_;
+    double sum_ = 0.0;
+};
+
+// Seeded with the SMA of the first N inputs, then alpha = 2 / (N + 1)
+class Ema {
+public:
+    explicit Ema(uint32_t period = 1);
+    void update(double x);
+    bool ready() const { return count_ >= period_; }
+    double value() const;
+
+private:
+    uint32_t period_;
+    double alpha_;
+    double value_ = 0.0;
+    uint32_t count_ = 0;
+};
+
+// Linear weights 1..N, newest heaviest
+class Wma {
+public:
+    explicit Wma(uint32_t period = 1) : window_(period) {}
+    void update(double x);
+    bool ready() const { return window_.full(); }
+    double value() const;
+
+private:
+    RollingWindow window_;
+    double sum_ = 0.0;
+    double weighted_sum_ = 0.0;
+};
+
+// Windowed mean and population std dev (Welford add / replace)
+class RollingStats {
+public:
+    explicit RollingStats(uint32_t period = 1) : window_(period) {}
+    void update(double x);
+    bool ready() const { return window_.full(); }
+    double mean() const { return mean_; }
+    double stddev() const;
+    double zscore(double x) const;     // 0 for a flat window
+
+private:
+    RollingWindow window_;
+    double mean_ = 0.0;
+    double m2_ = 0.0;
+};
+
+// Wilder RSI over price changes, 0..100
+class Rsi {
+public:
+    explicit Rsi(uint32_t period = 14) : period_(period) {}
+    void update(double x);
+    bool ready() const { return changes_ >= period_; }
+    double value() const;
+
+private:
+    uint32_t period_;
+    double last_ = 0.0;
+    double avg_gain_ = 0.0;
+    double avg_loss_ = 0.0;
+    uint32_t changes_ = 0;
+    bool started_ = false;
+};
+
+// Wilder average of the true range; on raw ticks high = low = close
+class Atr {
+public:
+    explicit Atr(uint32_t period = 14) : period_(period) {}
+    void update(double high, double low, double close);
+    bool ready() const { return count_ >= period_; }
+    double value() const;
+
+private:
+    uint32_t period_;
+    double prev_close_ = 0.0;
+    double value_ = 0.0;
+    uint32_t count_ = 0;
+};
+
+// Volume-weighted average price over the last N inputs (0 = cumulative)
+class Vwap {
+public:
+    explicit Vwap(uint32_t period = 0);
+    void update(double price, double volume);
+    bool ready() const { return volume_ > 0.0 && (period_ == 0 || prices_.full()); }
+    double value() const;
+
+private:
+    uint32_t period_;
+    RollingWindow prices_;                // price * volume
+    RollingWindow volumes_;
+    double pv_ = 0.0;
+    double volume_ = 0.0;
+};
+
+// Rolling min (or max) over the last N inputs via a monotonic deque
+class RollingExtreme {
+public:
+    RollingExtreme(uint32_t period = 1, bool maximum = false);
+    void update(double x);
+    bool ready() const { return seen_ >= period_; }
+    double value() const;
+
+private:
+    struct Entry {
+        uint64_t seq;
+        double value;
+    };
+    // Ring of period_ entries; values are monotonic from front to back
+    std::vector<Entry> deque_;
+    size_t front_ = 0;
+    size_t size_ = 0;
+    uint32_t period_;
+    bool maximum_;
+    uint64_t seen_ = 0;
+};
+
+/**
+ * Indicator Kind / Spec - Section 7
+ * BOLLINGER's value is the middle band; upper / lower are middle +/- param
+ * std devs. ZSCORE is (x - mean) / std of the window including x.
+ * With bar_ns > 0 the indicator is fed one OHLCV time bar per interval
+ * (close, plus high / low for ATR and volume for VWAP) when the bar
+ * completes; otherwise every tick is an input.
+ */
+enum class IndicatorKind : uint8_t {
+    SMA,
+    EMA,
+    WMA,
+    STDDEV,
+    BOLLINGER,
+    RSI,
+    ATR,
+    VWAP,
+    MIN,
+    MAX,
+    ZSCORE
+};
+
+struct IndicatorSpec {
+    IndicatorKind kind = IndicatorKind::SMA;
+    uint32_t symbol_id = 0;
+    uint32_t period = 20;               // VWAP: 0 = cumulative
+    double param = 2.0;                 // BOLLINGER band width in std devs
+    uint64_t bar_ns = 0;                // 0 = update on every tick
+};
+
+/**
+ * Indicator Set - Section 7
+ *
+ * Indicators attached per symbol. The event loop updates the set with each
+ * tick before the strategy is called (set_indicators), so a strategy reads
+ * current values by handle instead of recomputing them. Outputs live in
+ * contiguous arrays indexed by handle.
+ */
+class IndicatorSet {
+public:
+    static constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+
+    // Returns the handle (dense index, in insertion order)
+    uint32_t add(const IndicatorSpec& spec);
+    void clear();
+
+    void update(const TickRecord& tick);
+    // Resets every indicator to its initial state (specs are kept)
+    void reset();
+
+    size_t size() const { return specs_.size(); }
+    const IndicatorSpec& spec(uint32_t handle) const { return specs_[handle]; }
+    bool ready(uint32_t handle) const { return ready_[handle] != 0; }
+    double value(uint32_t handle) const { return values_[handle]; }
+    double upper(uint32_t handle) const { return upper_[handle]; }
+    double lower(uint32_t handle) const { return lower_[handle]; }
+
+    const std::vector<double>& values() const { return values_; }
+    const std::vector<double>& upper_values() const { return upper_; }
+    const std::vector<double>& lower_values() const { return lower_; }
+    uint64_t updates() const { return updates_; }
+
+private:
+    using State = std::variant<Sma, Ema, Wma, RollingStats, Rsi, Atr, Vwap, RollingExtreme>;
+
+    struct Bar {
+        uint64_t bucket = 0;
+        double high = 0.0;
+        double low = 0.0;
+        double close = 0.0;
+        double volume = 0.0;
+        bool open = false;
+    };
+
+    static State make_state(const IndicatorSpec& spec);
+    void feed(uint32_t handle, double high, double low, double close, double volume);
+
+    std::vector<IndicatorSpec> specs_;
+    std::vector<State> states_;
+    std::vector<Bar> bars_;
+    std::vector<double> values_;
+    std::vector<double> upper_;
+    std::vector<double> lower_;
+    std::vector<uint8_t> ready_;
+
+    SymbolTable symbols_;                          // Symbols with indicators
+    std::vector<std::vector<uint32_t>> by_symbol_; // Dense symbol index -> handles
+    uint64_t updates_ = 0;
+};
+
+} // namespace felix
@@ -0,0 +1,131 @@
+#pragma once
+
+#include "felix/execution.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace felix {
+
+/**
+ * Journal Event - Section 5.2
+ */
+enum class JournalEvent : uint8_t {
+    RUN_START,      // id = ticks in the stream, then as STATE_HASH
+    ORDER_SUBMIT,   // Accepted into the book: kind = OrderType, a = price, b = size, aux = stop / trail
+    ORDER_CLOSE,    // Left the book (at timestamp): kind = OrderStatus, a = price, b = filled size
+    FILL,           // a = price, b = volume, aux = slippage bps
+    RISK_HALT,      // kind = RiskRule, a = equity, b = peak equity
+    STATE_HASH,     // id = ticks processed, aux = portfolio state hash, a = equity, b = cash
+    RUN_END         // Same fields as STATE_HASH, after the last tick
+};
+
+enum class RiskRule : uint8_t;   // risk.hpp
+
+/**
+ * Journal Record - fixed 48 bytes, written as-is (little endian)
+ * Fields not used by an event are zero, so records compare bytewise.
+ */
+struct JournalRecord {
+    uint64_t timestamp = 0;
+    uint64_t id = 0;               // Order id, or tick count for run / hash events
+    uint64_t aux = 0;              // Event specific (hash, or a double's bits)
+    double a = 0.0;
+    double b = 0.0;
+    uint32_t symbol_id = 0;
+    JournalEvent event = JournalEvent::RUN_START;
+    uint8_t side = 0;
+    uint8_t kind = 0;
+    uint8_t flags = 0;             // ORDER_SUBMIT: 1 = percent trailing offset
+};
+static_assert(sizeof(JournalRecord) == 48, "journal records are a fixed on-disk size");
+
+struct JournalConfig {
+    std::string path;                   // Empty: no journal
+    uint64_t hash_interval_ticks = 10000; // STATE_HASH every N ticks (0 = only at the end)
+};
+
+/**
+ * Run Journal - Section 5.2
+ *
+ * Append-only binary log of what a run did: orders entering and leaving
+ * the book, fills, risk halts and periodic hashes of the portfolio state.
+ * Records are buffered and written in chunks. Two runs of the same engine
+ * on the same data produce byte-identical journals, so regressions show up
+ * as the first differing record instead of a CSV comparison after the fact.
+ */
+class RunJournal {
+public:
+    RunJournal() = default;
+    ~RunJournal();
+
+    RunJournal(const RunJournal&) = delete;
+    RunJournal& operator=(const RunJournal&) = delete;
+
+    // Truncates path and writes the file header
+    bool open(const std::string& path);
+    void close();
+    bool is_open() const { return out_.is_open(); }
+
+    void append(const JournalRecord& record);
+    void order_submitted(const Order& order);
+    void order_closed(const Order& order, OrderStatus status, uint64_t timestamp);
+    void fill(const Fill& fill);
+    void risk_halt(RiskRule reason, uint64_t timestamp, double equity, double peak_equity);
+    void state(JournalEvent event, uint64_t timestamp, uint64_t ticks, uint64_t hash,
+               double equity, double cash);
+
+    uint64_t records_written() const { return records_; }
+
+private:
+    void flush();
+
+    static constexpr size_t kBufferRecords = 4096;
+    std::ofstream out_;
+    std::vector<JournalRecord> buffer_;
+    uint64_t records_ = 0;
+};
+
+/**
+ * Journal Reader - streams records back (for diffing or replay)
+ */
+class JournalReader {
+public:
+    bool open(const std::string& path);
+    bool next(JournalRecord& record);
+    uint64_t records_read() const { return records_; }
+
+private:
+    std::ifstream in_;
+    uint64_t records_ = 0;
+};
+
+// Whole journal in memory
+std::vector<JournalRecord> read_journal(const std::string& path);
+
+/**
+ * Journal Diff - first record at which two journals disagree
+ */
+struct JournalDiff {
+    bool identical = false;
+    bool error = false;            // A file was missing or not a journal
+    uint64_t records_compared = 0;
+    uint64_t index = 0;            // Record index of the divergence
+    bool has_left = false;         // False when the left journal ended first
+    bool has_right = false;
+    JournalRecord left;
+    JournalRecord right;
+    std::string message;
+};
+
+// Streaming, record-by-record exact comparison
+JournalDiff diff_journals(const std::string& left_path, const std::string& right_path);
+
+const char* journal_event_name(JournalEvent event);
+
+// FNV-1a over raw bytes, chainable through seed
+uint64_t hash_bytes(const void* data, size_t size, uint64_t seed = 0xcbf29ce484222325ULL);
+
+} // namespace felix
@@ -1,10 +1,15 @@
 #pragma once
 #include "felix/risk.hpp"
+#include "felix/aligned.hpp"
+#include "felix/estimators.hpp"
 #include "felix/execution.hpp"
+#include "felix/journal.hpp"
+#include "felix/shared_log.hpp"
+#include "felix/symbol_table.hpp"
 #include "felix/tick_record.hpp"
+#include "felix/trigger_scan.hpp"
+#include <utility>
 #include <vector>
-#include <unordered_map>
-#include <random>
 
 namespace felix {
 
@@ -14,9 +19,12 @@ namespace felix {
 struct SlippageConfig {
     double fixed_bps = 0.0;           // Fixed slippage in basis points
     double volatility_mult = 0.0;      // Multiplier for volatility-based slippage
-    double size_impact = 0.0;          // Impact of order size
+    double size_impact = 0.0;          // Impact of order size (bps per unit of size/ADV)
     bool use_stochastic = false;       // Enable random slippage component
     double stochastic_std = 0.0;       // Std dev for stochastic slippage
+    uint64_t seed = 0;                 // Run seed for the counter-based RNG
+    double vol_decay = 0.94;           // EWMA lambda for tick volatility
+    uint32_t adv_window_days = 20;     // Trading days in the ADV window
 };
 
 /**
@@ -27,16 +35,63 @@ struct LatencyConfig {
     uint64_t engine_latency_ns = 0;    // Time from submission to activation
 };
 
+/**
+ * Liquidity Configuration - Section 6.2
+ * Caps fills at the displayed top-of-book size; the remainder either
+ * sweeps simulated depth or rests as a PARTIAL order until the next tick.
+ */
+struct LiquidityConfig {
+    bool cap_to_displayed = false;     // Fill at most bid_size/ask_size per tick
+    uint32_t sweep_levels = 0;         // Simulated levels beyond the touch (0 = rest remainder)
+    double level_spacing_bps = 1.0;    // Price step between simulated levels
+};
+
 /**
  * Market State - Current state for a symbol
+ * One cache-line aligned slot per dense symbol index
  */
-struct MarketState {
+struct alignas(kCacheLineSize) MarketState {
+    bool has_data = false;             // Set once the first tick arrives
     double last_price = 0.0;
     double bid = 0.0;
     double ask = 0.0;
     double bid_size = 0.0;
     double ask_size = 0.0;
     uint64_t last_timestamp = 0;
+
+    // Liquidity consumed by our own fills since the last tick (Section 6.2)
+    double bid_available = 0.0;
+    double ask_available = 0.0;
+    double bid_swept = 0.0;
+    double ask_swept = 0.0;
+
+    // Streaming estimators for the slippage model (Section 8.3)
+    EwmaVolatility volatility;
+    RollingVolume volume;
+};
+
+/**
+ * Contingent Group - Section 6.4
+ * Exit quantity shared by OCO legs. A bracket entry arms the group as it
+ * fills; every leg fill consumes it, so siblings shrink and then cancel.
+ * Once none of its orders is pending the slot is reused by the next group.
+ */
+struct ContingentGroup {
+    double armed_qty = 0.0;            // Quantity the legs may exit
+    double exited_qty = 0.0;           // Quantity exited by any leg
+    bool entry_done = false;           // No further arming (entry finished, or plain OCO)
+    uint32_t live_orders = 0;          // Pending orders referencing the group
+
+    double open_qty() const { return armed_qty - exited_qty; }
+};
+
+/**
+ * Submit Result - Section 6.1
+ * Outcome of one order of a batch; order_id is 0 when rejected
+ */
+struct SubmitResult {
+    uint64_t order_id = 0;
+    RiskRule reject = RiskRule::COUNT;   // Rejecting rule, COUNT if accepted
 };
 
 /**
@@ -46,6 +101,7 @@ struct MarketState {
  * - Latency modeling (Section 8.1)
  * - Slippage modeling (Section 8.3)
  * - Queue position simulation (Section 6.2)
+ * - Contingent orders: STOP_LIMIT, trailing stops, OCO, brackets (Section 6.4)
  */
 class MatchingEngine {
 public:
@@ -54,6 +110,10 @@ public:
     // Configuration
     void set_latency_config(const LatencyConfig& config);
     void set_slippage_config(const SlippageConfig& config);
+    void set_liquidity_config(const LiquidityConfig& config);
+    
+    // Symbol registration - pre-sizes dense state from the loaded stream
+    void register_symbols(const SymbolTable& symbols);
     
     // Market state updates
     void update_market_state(const TickRecord& tick);
@@ -61,50 +121,105 @@ public:
     // Order management
     uint64_t submit_order(Order order);
     bool cancel_order(uint64_t order_id);
+    // Basket submission - one risk pass over the batch (RiskEngine::check_batch)
+    std::vector<SubmitResult> submit_orders(std::vector<Order> orders);
+    
+    // Contingent orders - Section 6.4
+    std::pair<uint64_t, uint64_t> submit_oco(Order first, Order second);
+    BracketOrder submit_bracket(Order entry, double stop_loss, double take_profit,
+                                double trail_offset = 0.0, bool trail_percent = false);
     
-    // Order processing - returns fills
-    std::vector<Fill> process_pending_orders(uint64_t current_timestamp);
+    // Order processing - returns fills (buffer reused, valid until next call)
+    const std::vector<Fill>& process_pending_orders(uint64_t current_timestamp);
     
     // Market data queries
     double get_best_bid(uint32_t symbol_id) const;
     double get_best_ask(uint32_t symbol_id) const;
     double get_last_price(uint32_t symbol_id) const;
+    double get_volatility(uint32_t symbol_id) const;
+    double get_adv(uint32_t symbol_id) const;
+    
+    // Fast-forward support - Section 5.3
+    // Adds the price levels / times at which any pending order could act
+    void collect_triggers(TriggerEnvelope& envelope, const SymbolTable& symbols) const;
     
     // Order book queries
     size_t pending_order_count() const;
     const std::vector<Order>& get_pending_orders() const;
-
-    void set_risk_limits(const RiskLimits& limits) {
-       risk_limits_ = limits;
-       has_risk_limits_ = true;
-    }
+    // Allocated contingent group slots (closed groups are recycled)
+    size_t contingent_group_slots() const { return groups_.size(); }
     
+    // Orders that left the book (filled, cancelled, rejected) in completion order
+    const std::vector<Order>& order_history() const { return order_history_.items(); }
+    std::shared_ptr<const std::vector<Order>> order_history_snapshot() const { return order_history_.snapshot(); }
+
     void set_risk_engine(RiskEngine* risk_engine);
     void set_portfolio(Portfolio* portfolio);
+    // Orders entering / leaving the book are recorded here while set (Section 5.2)
+    void set_journal(RunJournal* journal) { journal_ = journal; }
+    // Per-order console logging (on by default)
+    void set_verbose(bool verbose) { verbose_ = verbose; }
+    // Multi-strategy runs (Section 7): orders submitted while set are tagged
+    // with this strategy id (0 = leave orders as submitted)
+    void set_active_strategy(uint32_t strategy_id) { active_strategy_ = strategy_id; }
+    uint32_t active_strategy() const { return active_strategy_; }
 
 private:
+    static constexpr double kMinFillSize = 1e-9;
+
     // Order matching functions
     RiskEngine* risk_engine_ = nullptr;
     Portfolio* portfolio_ = nullptr;
+    RunJournal* journal_ = nullptr;
     bool match_market_order(const Order& order, const MarketState& market, Fill& fill);
     bool match_limit_order(const Order& order, const MarketState& market, Fill& fill);
     bool match_stop_order(const Order& order, const MarketState& market, Fill& fill);
-    bool has_risk_limits_ = false;
-    RiskLimits risk_limits_;
-    // Apply slippage to fill
-    void apply_slippage(Fill& fill, const Order& order, const MarketState& market);
+    bool match_stop_limit_order(Order& order, const MarketState& market, Fill& fill);
+    bool match_trailing_stop(Order& order, const MarketState& market, Fill& fill);
+    
+    // Submission helpers
+    void stamp_order(Order& order);
+    bool risk_accepts(const Order& order) const;
+    uint64_t enqueue_order(Order& order, bool log = true);
+    uint32_t create_group(double armed_qty, bool entry_done);
+    void release_group(uint32_t group);
+    void remove_closed_legs();
+    void archive_order(const Order& order, OrderStatus status);
+    // Dense state slot for a symbol (nullptr until its first tick)
+    MarketState* find_market_state(uint32_t symbol_id);
+    const MarketState* find_market_state(uint32_t symbol_id) const;
+    MarketState& market_state_slot(uint32_t symbol_id);
+    
+    bool process_active_order(Order& order, uint64_t current_timestamp);
+    // Split an executable order into fills against displayed/simulated liquidity
+    void execute_order(Order& order, MarketState& market, double touch_price, double quantity,
+                       uint64_t timestamp);
+    void emit_fill(Order& order, const MarketState& market, double price, double volume, uint64_t timestamp);
+    // Slippage: deterministic terms per fill, stochastic term batched per call
+    double deterministic_slippage_bps(const Order& order, const MarketState& market) const;
+    void apply_slippage(std::vector<Fill>& fills);
     
     // Configuration
     SlippageConfig slippage_config_;
     LatencyConfig latency_config_;
+    LiquidityConfig liquidity_config_;
     
     // State
-    std::unordered_map<uint32_t, MarketState> market_states_;
+    SymbolTable symbols_;
+    AlignedVector<MarketState> market_states_;   // Indexed by symbols_ dense index
     std::vector<Order> pending_orders_;
+    std::vector<ContingentGroup> groups_;   // Indexed by Order::oco_group - 1
+    std::vector<uint32_t> free_groups_;     // Closed group ids, reused by create_group
+    bool groups_dirty_ = false;
+    uint64_t clock_ = 0;                    // Latest tick / processing time seen
+    bool verbose_ = true;
+    uint32_t active_strategy_ = 0;
+    std::vector<Fill> fills_;
+    std::vector<uint32_t> fill_seqs_;   // Per-order fill number, keys the RNG counter
+    std::vector<uint64_t> rng_streams_;
+    std::vector<double> normals_;
+    SharedLog<Order> order_history_;
     uint64_t next_order_id_;
-    
-    // Random generator for stochastic slippage
-    mutable std::mt19937 rng_;
 };
 
 } // namespace felix
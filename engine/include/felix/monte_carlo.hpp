@@ -0,0 +1,74 @@
+#pragma once
+
+#include "felix/datastream.hpp"
+#include "felix/signal_strategy.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace felix {
+
+/**
+ * Monte Carlo Config - Section 8.4
+ * Path p draws its random numbers from Philox keyed by (seed, p), so each
+ * path is reproducible on its own and results do not depend on threads.
+ */
+struct MonteCarloConfig {
+    uint32_t paths = 1000;
+    uint64_t seed = 0;
+    unsigned threads = 0;                 // 0 = hardware concurrency
+    bool with_replacement = false;        // Trades: bootstrap instead of shuffle
+    uint32_t block_size = 20;             // Returns: moving-block length
+    std::vector<double> percentiles = {1.0, 5.0, 25.0, 50.0, 75.0, 95.0, 99.0};
+    double risk_free_rate = 0.0;
+    double periods_per_year = 252.0;
+};
+
+/**
+ * Execution Perturbation - Section 8.1 / 8.3
+ * Per path: fixed slippage += |N(0, slippage_bps_std)|, strategy latency
+ * += U[0, latency_jitter_ns], and a distinct stochastic slippage seed.
+ */
+struct ExecutionPerturbation {
+    double slippage_bps_std = 0.0;
+    uint64_t latency_jitter_ns = 0;
+};
+
+/**
+ * Monte Carlo Result - Section 8.4
+ * Per-path metrics in path order, and their percentiles (linear
+ * interpolation, same as numpy.percentile) in config order.
+ */
+struct MonteCarloResult {
+    std::vector<double> percentiles;
+    std::vector<double> final_equity;
+    std::vector<double> max_drawdown;     // Fraction of the peak
+    std::vector<double> sharpe;
+    std::vector<double> final_equity_pct;
+    std::vector<double> max_drawdown_pct;
+    std::vector<double> sharpe_pct;
+};
+
+/**
+ * Monte Carlo Engine - Section 8.4
+ *
+ * Robustness distributions from one backtest, every path on a thread pool:
+ * - monte_carlo_trades: closed-trade P&Ls replayed in shuffled order (or
+ *   resampled with replacement) from initial_equity
+ * - monte_carlo_returns: moving-block bootstrap of an equity curve's
+ *   simple returns, compounded from its first point
+ * - monte_carlo_execution: the signal backtest re-run with perturbed
+ *   slippage and latency
+ * Paths are evaluated with the online PerformanceTracker, so no path keeps
+ * its equity curve.
+ */
+MonteCarloResult monte_carlo_trades(const double* pnls, size_t count, double initial_equity,
+                                    const MonteCarloConfig& config);
+MonteCarloResult monte_carlo_returns(const double* equity, size_t count,
+                                     const MonteCarloConfig& config);
+MonteCarloResult monte_carlo_execution(const DataStream& stream, const double* signals,
+                                       const SignalBacktestConfig& backtest,
+                                       const ExecutionPerturbation& perturbation,
+                                       const MonteCarloConfig& config);
+
+} // namespace felix
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "felix/event_loop.hpp"
+#include "felix/matching.hpp"
+#include "felix/portfolio.hpp"
+#include "felix/strategy_abi.h"
+#include <cstdint>
+
+namespace felix {
+
+/**
+ * Native Callbacks - Section 7
+ * C ABI entry points of an externally compiled strategy (strategy_abi.h);
+ * any of them may be null. state is passed back unchanged.
+ */
+struct NativeCallbacks {
+    felix_on_tick_fn on_tick = nullptr;
+    felix_on_bar_fn on_bar = nullptr;
+    felix_on_fill_fn on_fill = nullptr;
+    void* state = nullptr;
+};
+
+/**
+ * Native Strategy - Section 7
+ *
+ * Adapts C ABI callbacks to StrategyWrapper. Ticks and fills are handed
+ * over in place (felix_tick / felix_fill share the engine's layouts) and
+ * orders come back through the felix_api table, so a run stays entirely
+ * in native code.
+ */
+class NativeStrategy : public StrategyWrapper {
+public:
+    NativeStrategy(const NativeCallbacks& callbacks, MatchingEngine& engine, Portfolio& portfolio);
+
+    void on_start() override {}
+    void on_tick(const TickRecord& tick) override;
+    void on_bar(const TickRecord& bar) override;
+    void on_fill(const Fill& fill) override;
+    void on_end() override {}
+    bool should_wake(const TickRecord&) override { return callbacks_.on_tick != nullptr; }
+
+    uint64_t orders_submitted() const { return orders_submitted_; }
+    uint64_t orders_rejected() const { return orders_rejected_; }
+
+    // The felix_api table (same for every run)
+    static const felix_api& api();
+
+private:
+    static uint64_t submit(felix_context* ctx, uint32_t symbol_id, int32_t side, int32_t order_type,
+                           double size, double price, uint64_t timestamp);
+    static int32_t cancel(felix_context* ctx, uint64_t order_id);
+    static double position(felix_context* ctx, uint32_t symbol_id);
+    static double cash(felix_context* ctx);
+    static double equity(felix_context* ctx);
+    static NativeStrategy& self(felix_context* ctx) { return *static_cast<NativeStrategy*>(ctx->engine); }
+
+    NativeCallbacks callbacks_;
+    MatchingEngine& engine_;
+    Portfolio& portfolio_;
+    felix_context context_;
+    uint64_t timestamp_ = 0;                 // Current tick, for timestamp-0 submissions
+    uint64_t orders_submitted_ = 0;
+    uint64_t orders_rejected_ = 0;
+};
+
+} // namespace felix
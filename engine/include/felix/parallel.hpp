@@ -0,0 +1,63 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace felix {
+
+// 0 = one worker per hardware thread
+inline unsigned resolve_threads(unsigned threads) {
+    return threads ? threads : std::max(1u, std::thread::hardware_concurrency());
+}
+
+/**
+ * Parallel For - runs task(i) for every i in [0, count) on up to `threads`
+ * workers (the calling thread is one of them). Tasks are handed out one at
+ * a time, so uneven task costs balance themselves. Results must not depend
+ * on which worker runs a task. If a task throws, no further tasks start,
+ * every worker is joined and the first exception is rethrown here.
+ */
+template <typename Task>
+void parallel_for(size_t count, unsigned threads, Task task) {
+    std::atomic<size_t> next{0};
+    std::exception_ptr error;
+    std::mutex error_mutex;
+    auto worker = [&]() {
+        try {
+            for (size_t i = next++; i < count; i = next++) {
+                task(i);
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(error_mutex);
+            if (!error) error = std::current_exception();
+            next = count;   // Hand out nothing more
+        }
+    };
+
+    // Joined however this frame is left: a joinable std::thread must not be destroyed
+    struct Joiner {
+        std::vector<std::thread>& pool;
+        ~Joiner() {
+            for (auto& t : pool) {
+                if (t.joinable()) t.join();
+            }
+        }
+    };
+    size_t workers = std::min<size_t>(resolve_threads(threads), count);
+    std::vector<std::thread> pool;
+    {
+        Joiner joiner{pool};
+        for (size_t w = 1; w < workers; ++w) {
+            pool.emplace_back(worker);
+        }
+        worker();
+    }
+    if (error) std::rethrow_exception(error);
+}
+
+} // namespace felix
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace felix {
+
+/**
+ * Performance Summary - Section 8.4
+ * Same definitions as python/felix/analytics/metrics.py: simple per-point
+ * returns, population standard deviations, Sortino over negative returns,
+ * drawdown relative to the running peak, CAGR from the point count.
+ */
+struct PerformanceSummary {
+    uint64_t points = 0;
+    double initial_equity = 0.0;
+    double final_equity = 0.0;
+    double total_return_pct = 0.0;
+    double mean_return = 0.0;         // Per point
+    double volatility = 0.0;          // Per-point std dev of returns
+    double sharpe_ratio = 0.0;
+    double sortino_ratio = 0.0;
+    double max_drawdown = 0.0;        // Fraction of the peak
+    uint64_t max_drawdown_peak = 0;   // Point indices
+    uint64_t max_drawdown_trough = 0;
+    double cagr = 0.0;
+
+    uint64_t total_trades = 0;
+    double win_rate = 0.0;
+    double avg_win = 0.0;
+    double avg_loss = 0.0;
+    double profit_factor = 0.0;
+};
+
+/**
+ * Performance Tracker - Section 8.4
+ *
+ * Online metrics: Welford moments of returns (all and negative-only),
+ * running peak / max drawdown and trade win/loss tallies. O(1) per point,
+ * so a run's metrics are ready without keeping or revisiting its curve.
+ */
+class PerformanceTracker {
+public:
+    void update(double equity);
+    void on_trade(double pnl);
+
+    PerformanceSummary summary(double risk_free_rate = 0.0, double periods_per_year = 252.0) const;
+
+private:
+    uint64_t points_ = 0;
+    double first_equity_ = 0.0;
+    double last_equity_ = 0.0;
+
+    // Return moments
+    uint64_t returns_ = 0;
+    double mean_ = 0.0;
+    double m2_ = 0.0;
+    uint64_t downside_ = 0;
+    double downside_mean_ = 0.0;
+    double downside_m2_ = 0.0;
+
+    // Drawdown
+    double peak_ = 0.0;
+    uint64_t peak_index_ = 0;
+    double max_drawdown_ = 0.0;
+    uint64_t max_drawdown_peak_ = 0;
+    uint64_t max_drawdown_trough_ = 0;
+
+    // Trades
+    uint64_t trades_ = 0;
+    uint64_t wins_ = 0;
+    uint64_t losses_ = 0;
+    double win_sum_ = 0.0;
+    double loss_sum_ = 0.0;
+};
+
+// Batch metrics over an equity array (AVX2 return moments when available)
+PerformanceSummary compute_performance(const double* equity, size_t n,
+                                       double risk_free_rate = 0.0, double periods_per_year = 252.0);
+
+} // namespace felix
@@ -1,8 +1,17 @@
 #pragma once
 
+#include "felix/aligned.hpp"
+#include "felix/equity_store.hpp"
+#include "felix/performance.hpp"
+#include "felix/revaluation.hpp"
+#include "felix/shared_log.hpp"
 #include "felix/execution.hpp"
+#include "felix/symbol_table.hpp"
+#include "felix/trade_ledger.hpp"
+#include <cmath>
+#include <cstdint>
+#include <memory>
 #include <vector>
-#include <unordered_map>
 
 namespace felix {
 
@@ -16,13 +25,23 @@ struct Position {
 };
 
 /**
- * Equity Point - Section 4.2
+ * Compensated running sum (Neumaier) - keeps incrementally maintained
+ * totals within rounding of a full recomputation over long runs
  */
-struct EquityPoint {
-    uint64_t timestamp = 0;
-    double equity = 0.0;
-    double cash = 0.0;
-    double unrealized_pnl = 0.0;
+struct RunningSum {
+    double sum = 0.0;
+    double compensation = 0.0;
+
+    void add(double value) {
+        double t = sum + value;
+        if (std::abs(sum) >= std::abs(value)) {
+            compensation += (sum - t) + value;
+        } else {
+            compensation += (value - t) + sum;
+        }
+        sum = t;
+    }
+    double value() const { return sum + compensation; }
 };
 
 /**
@@ -33,41 +52,119 @@ struct EquityPoint {
  * - Cash, margin, equity
  * - Realized & unrealized P&L
  * - Equity curve for analytics
+ *
+ * Market value, cost basis and realized P&L are kept as running totals
+ * updated from per-symbol deltas, so price updates are O(1) and equity
+ * reads do not walk the positions.
  */
 class Portfolio {
 public:
     explicit Portfolio(double initial_cash);
     
+    // Symbol registration - pre-sizes dense state from the loaded stream
+    void register_symbols(const SymbolTable& symbols);
+    
     // Fill processing
     void on_fill(const Fill& fill);
     
     // Price updates for mark-to-market
-    void update_prices(uint64_t symbol_id, double price);
+    void update_prices(uint32_t symbol_id, double price);
+    // Batch update (e.g. a bar close across the universe), then one full-book revaluation
+    void update_prices(const uint32_t* symbol_ids, const double* prices, size_t count);
     
     // Equity tracking - Section 8.4
+    // Records a point when the sampling policy selects this mark-to-market step
     void append_equity_point(uint64_t timestamp);
+    // Records the last skipped step, so the curve always ends at the final state
+    void flush_equity_curve();
+    // False if the spill file cannot be opened; the curve then stays in memory
+    bool set_equity_recording_config(const EquityRecordingConfig& config);
+    const EquityRecordingConfig& equity_recording_config() const { return recording_; }
     
     // Accessors
     double cash() const { return cash_; }
     double initial_cash() const { return initial_cash_; }
-    double equity() const;
-    double unrealized_pnl(uint64_t symbol_id, double current_price) const;
-    double total_unrealized_pnl() const;
-    double total_realized_pnl() const;
+    double equity() const { return cash_ + market_value_.value(); }
+    double market_value() const { return market_value_.value(); }
+    double unrealized_pnl(uint32_t symbol_id, double current_price) const;
+    double total_unrealized_pnl() const { return market_value_.value() - cost_basis_.value(); }
+    double total_realized_pnl() const { return realized_pnl_.value(); }
+    
+    // Debug mode - cross-check the running totals against a full recomputation
+    // after every update; mismatches are logged and counted
+    void set_consistency_check(bool enabled) { consistency_check_ = enabled; }
+    bool consistency_check() const { return consistency_check_; }
+    uint64_t consistency_mismatches() const { return consistency_mismatches_; }
+    
+    Position get_position(uint32_t symbol_id) const;
+    
+    // Full-book net/gross/long/short breakdown at last prices (vectorized scan)
+    BookExposure exposure() const;
+    // Hash of cash and every position's quantity, avg price and realized P&L (run journal)
+    uint64_t state_hash() const;
+    std::vector<EquityPoint> equity_curve() const { return equity_curve_->points(); }
+    const EquityStore& equity_store() const { return *equity_curve_; }
+    
+    // Zero-copy export (Section 7) - snapshots stay valid while held
+    std::shared_ptr<const std::vector<EquityPoint>> equity_snapshot() const;
+    std::shared_ptr<const std::vector<Fill>> fill_snapshot() const { return fill_log_.snapshot(); }
+    const std::vector<Fill>& fills() const { return fill_log_.items(); }
     
-    const Position& get_position(uint64_t symbol_id) const;
-    const std::vector<EquityPoint>& equity_curve() const { return equity_curve_; }
+    // Round-trip trades built from the fills (Section 4.2)
+    void set_trade_matching(LotMatching matching) { ledger_.set_matching(matching); }
+    const TradeLedger& trade_ledger() const { return ledger_; }
+    const std::vector<Trade>& trades() const { return ledger_.trades(); }
+    
+    // Online metrics over the recorded equity points and closed trades (Section 8.4)
+    PerformanceSummary performance_summary(double risk_free_rate = 0.0, double periods_per_year = 252.0) const {
+        return performance_.summary(risk_free_rate, periods_per_year);
+    }
     
     // For Python bindings - vectorized access
     std::vector<uint64_t> get_timestamps() const;
     std::vector<double> get_equity_values() const;
 
 private:
+    // Dense index for a symbol, growing the per-symbol arrays on first use
+    uint32_t slot(uint32_t symbol_id);
+    
+    // Replace one symbol's contribution to the running totals
+    void revalue(uint32_t index);
+    // Recompute every symbol's contribution and rebase the running totals
+    void revalue_all();
+    void verify_totals();
+    bool should_record(uint64_t timestamp, double equity);
+    void record_point(const EquityPoint& point);
+
     double cash_;
     double initial_cash_;
-    std::unordered_map<uint64_t, Position> positions_;
-    std::unordered_map<uint64_t, double> last_prices_;
-    std::vector<EquityPoint> equity_curve_;
+    SymbolTable symbols_;
+
+    // Position store, structure of arrays indexed by symbols_ dense index
+    AlignedVector<double> quantities_;
+    AlignedVector<double> avg_prices_;
+    AlignedVector<double> realized_pnls_;
+    AlignedVector<double> last_prices_;
+    AlignedVector<double> market_values_;   // quantity * last price per symbol
+    AlignedVector<double> cost_values_;     // quantity * avg price per symbol
+    RunningSum market_value_;
+    RunningSum cost_basis_;
+    RunningSum realized_pnl_;
+    bool consistency_check_ = false;
+    uint64_t consistency_mismatches_ = 0;
+
+    // Equity curve sampling state
+    EquityRecordingConfig recording_;
+    std::unique_ptr<EquityStore> equity_curve_;
+    uint64_t mtm_steps_ = 0;
+    uint64_t unrecorded_timestamp_ = 0;
+    bool has_unrecorded_ = false;
+    bool filled_since_record_ = false;
+    // Decoded equity curve, rebuilt when points were recorded since the last export
+    mutable std::shared_ptr<const std::vector<EquityPoint>> equity_cache_;
+    SharedLog<Fill> fill_log_;
+    TradeLedger ledger_;
+    PerformanceTracker performance_;
 };
 
 } // namespace felix
\ No newline at end of file
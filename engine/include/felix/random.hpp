@@ -0,0 +1,60 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace felix {
+
+/**
+ * Counter-based RNG - Section 8.3
+ * Philox4x32-10 (Salmon et al., "Parallel Random Numbers: As Easy as 1, 2, 3").
+ * Stateless: every output is a pure function of (key, counter), so a draw
+ * can be regenerated in isolation and does not depend on call order or
+ * thread scheduling.
+ */
+class Philox4x32 {
+public:
+    using Counter = std::array<uint32_t, 4>;
+    using Key = std::array<uint32_t, 2>;
+
+    static constexpr int kRounds = 10;
+
+    static Counter generate(Counter ctr, Key key) {
+        for (int r = 0; r < kRounds; ++r) {
+            ctr = round(ctr, key);
+            key[0] += kWeyl0;
+            key[1] += kWeyl1;
+        }
+        return ctr;
+    }
+
+private:
+    static constexpr uint32_t kMul0 = 0xD2511F53u;
+    static constexpr uint32_t kMul1 = 0xCD9E8D57u;
+    static constexpr uint32_t kWeyl0 = 0x9E3779B9u;
+    static constexpr uint32_t kWeyl1 = 0xBB67AE85u;
+
+    static Counter round(const Counter& c, const Key& k) {
+        uint64_t p0 = static_cast<uint64_t>(kMul0) * c[0];
+        uint64_t p1 = static_cast<uint64_t>(kMul1) * c[2];
+        return {static_cast<uint32_t>(p1 >> 32) ^ c[1] ^ k[0], static_cast<uint32_t>(p1),
+                static_cast<uint32_t>(p0 >> 32) ^ c[3] ^ k[1], static_cast<uint32_t>(p0)};
+    }
+};
+
+/**
+ * Standard normal draw for (seed, stream, index).
+ * The slippage model uses stream = order_id and index = fill number.
+ */
+double philox_normal(uint64_t seed, uint64_t stream, uint32_t index);
+
+/**
+ * Batch version: out[i] = philox_normal(seed, streams[i], indices[i]).
+ * The integer rounds run lane-parallel so the compiler can vectorize them;
+ * results are bit-identical to the scalar function.
+ */
+void philox_normal_batch(uint64_t seed, const uint64_t* streams, const uint32_t* indices,
+                         double* out, size_t n);
+
+} // namespace felix
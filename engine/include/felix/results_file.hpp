@@ -0,0 +1,133 @@
+#pragma once
+
+#include "felix/downsample.hpp"
+#include "felix/equity_store.hpp"
+#include "felix/execution.hpp"
+#include "felix/trade_ledger.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace felix {
+
+class Portfolio;
+
+/**
+ * Results Column - Section 8.4
+ * Logical type of a column (what readers decode to) and how its bytes are
+ * stored (column_codec.hpp).
+ */
+enum class ColumnType : uint8_t {
+    U8,
+    U32,
+    U64,
+    F64
+};
+
+enum class ColumnCodec : uint8_t {
+    RAW,            // Fixed width little endian (1 / 4 / 8 bytes per value)
+    DELTA_VARINT,   // Integers: zigzag varint deltas, restarting every chunk
+    XOR_DOUBLE      // F64: XOR with the previous value, zero bytes trimmed
+};
+
+struct ResultsFileConfig {
+    std::string path;                // Empty: no results file (event loop)
+    bool compress = true;            // False: RAW columns
+    uint32_t chunk_rows = 65536;     // Rows per table chunk
+    EquityPyramidConfig pyramid;     // Downsampled equity levels (base_points = 0: none)
+};
+
+/**
+ * Results Writer - Section 8.4
+ *
+ * Columnar binary file of a run's fills, closed trades and equity curve,
+ * for analysis without CSV parsing. Layout (little endian):
+ *
+ *   header  "FELIXRES" | u32 version | u32 reserved
+ *   chunk   u8 name_len | table name | u32 rows | u8 columns, then per column
+ *           u8 name_len | column name | u8 ColumnType | u8 ColumnCodec |
+ *           u32 byte size | data
+ *
+ * Tables are "fills", "trades" and "equity" with the fields of Fill, Trade
+ * and EquityPoint (side as u8), and "equity_lod0".."equity_lodN" with the
+ * fields of EquityLevelPoint for the equity pyramid, coarsest first, so a
+ * chart can decode only the level it shows. Rows are buffered per table and written a
+ * chunk at a time, so a file can be appended to while a run is going and
+ * every chunk decodes on its own. Readers concatenate each table's chunks
+ * in file order and ignore a truncated trailing chunk.
+ */
+class ResultsWriter {
+public:
+    ResultsWriter() = default;
+    ~ResultsWriter();
+
+    ResultsWriter(const ResultsWriter&) = delete;
+    ResultsWriter& operator=(const ResultsWriter&) = delete;
+
+    // Truncates config.path and writes the file header
+    bool open(const ResultsFileConfig& config);
+    // Writes the partial chunks
+    void close();
+    bool is_open() const { return out_.is_open(); }
+
+    void append(const Fill& fill);
+    void append(const Trade& trade);
+    void append(const EquityPoint& point);
+    // Everything the portfolio recorded: fills, trades, the equity curve and its pyramid
+    void append(const Portfolio& portfolio);
+    // Pyramid of a finished curve per config.pyramid, written immediately
+    void append_equity_pyramid(const EquityStore& curve);
+
+    uint64_t fills_written() const { return fill_rows_; }
+    uint64_t trades_written() const { return trade_rows_; }
+    uint64_t equity_written() const { return equity_rows_; }
+    size_t pyramid_levels() const { return pyramid_levels_; }
+    uint64_t bytes_written() const { return bytes_; }
+
+private:
+    void flush_fills();
+    void flush_trades();
+    void flush_equity();
+    void write(const std::vector<uint8_t>& chunk);
+
+    ResultsFileConfig config_;
+    std::ofstream out_;
+    std::vector<Fill> fills_;
+    std::vector<Trade> trades_;
+    std::vector<EquityPoint> equity_;
+    uint64_t fill_rows_ = 0;
+    uint64_t trade_rows_ = 0;
+    uint64_t equity_rows_ = 0;
+    uint64_t bytes_ = 0;
+    size_t pyramid_levels_ = 0;
+};
+
+// One-shot export of a finished run
+bool write_results(const std::string& path, const Portfolio& portfolio, bool compress = true);
+
+/**
+ * Results Reader - Section 8.4
+ * A table's chunks concatenated, each column decoded to u64 (integer
+ * types) or double.
+ */
+struct ResultsColumn {
+    std::string name;
+    ColumnType type = ColumnType::U64;
+    std::vector<uint64_t> ints;
+    std::vector<double> doubles;
+};
+
+struct ResultsTable {
+    std::string name;
+    uint64_t rows = 0;
+    std::vector<ResultsColumn> columns;
+};
+
+// Tables in order of first appearance; empty when the file is missing or not a
+// results file. With `only`, chunks of other tables are skipped undecoded.
+std::vector<ResultsTable> read_results(const std::string& path,
+                                       const std::vector<std::string>& only = {});
+
+} // namespace felix
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace felix {
+
+/**
+ * Book Exposure - Section 4.2
+ * Totals over every open position at its last price
+ */
+struct BookExposure {
+    double market_value = 0.0;      // Net: sum of quantity * last price
+    double cost_basis = 0.0;        // Sum of quantity * avg price
+    double unrealized_pnl = 0.0;
+    double gross_exposure = 0.0;    // Sum of |market value|
+    double long_exposure = 0.0;
+    double short_exposure = 0.0;    // Negative or zero
+    uint64_t long_positions = 0;
+    uint64_t short_positions = 0;
+};
+
+/**
+ * Revaluation kernels - Section 4.2
+ *
+ * Stream the structure-of-arrays position store once (AVX-512 / AVX2 /
+ * scalar, chosen at compile time). Positions with |quantity| <= 1e-9 count
+ * as flat. revalue_book also writes each symbol's market value and cost
+ * so the portfolio's incremental totals can be rebased on the result.
+ */
+BookExposure compute_exposure(const double* quantity, const double* avg_price,
+                              const double* last_price, size_t n);
+
+BookExposure revalue_book(const double* quantity, const double* avg_price,
+                          const double* last_price, double* market_value,
+                          double* cost_value, size_t n);
+
+} // namespace felix
@@ -2,6 +2,8 @@
 
 #include "felix/execution.hpp"
 #include "felix/portfolio.hpp"
+#include <array>
+#include <limits>
 
 namespace felix {
 
@@ -12,42 +14,118 @@ struct RiskLimits {
     double max_drawdown = 0.20;       // Maximum drawdown (20% default)
     double max_position_size = 1000;   // Maximum position per symbol
     double max_order_size = 500;       // Maximum single order size
-    // double max_notional = 0;           // Maximum notional value (0 = unlimited)
-    // double max_daily_loss = 0;         // Maximum daily loss (0 = unlimited)
-    double max_notional = 1000000.0;
-    double max_daily_loss = 50000.0;
+    double max_notional = 1000000.0;   // Maximum order notional (0 = unlimited)
+    double max_daily_loss = 50000.0;   // Maximum loss since the day's open (0 = unlimited)
+    uint64_t day_offset_ns = 0;        // Daily rollover at UTC midnight + offset
 };
 
+/**
+ * Risk Rule - Section 8.4
+ * Pre-trade rules reject orders; DRAWDOWN and DAILY_LOSS halt the run.
+ * Once halted (by either of those or halt()), HALTED rejects every order
+ * that would grow a position; exits are still accepted.
+ */
+enum class RiskRule : uint8_t {
+    HALTED,
+    ORDER_SIZE,
+    NOTIONAL,
+    CASH,
+    POSITION,
+    DRAWDOWN,
+    DAILY_LOSS,
+    COUNT
+};
+
+const char* risk_rule_name(RiskRule rule);
+
 /**
  * Risk Engine - Section 8.4
+ *
+ * One rule pipeline for the whole run. Limits are compiled once into
+ * thresholds (disabled limits become +inf), pre-trade rules are evaluated
+ * together into a violation mask, and equity-driven state (peak, drawdown,
+ * daily P&L) is updated once per tick from the equity the event loop
+ * already has. The day rolls over when a tick's timestamp enters a new
+ * day. Rejections and the halt reason are counted per rule.
  */
 class RiskEngine {
 public:
     explicit RiskEngine(const RiskLimits& limits);
-    
-    // Pre-trade checks
-    // bool check_order(const Order& order, const Portfolio& portfolio);
-    bool check_order(const Order& order, double portfolio_cash, double current_equity, double initial_capital) const;
-    bool check_drawdown(const Portfolio& portfolio, double peak_equity);
-    bool check_position_limit(const Portfolio& portfolio, uint32_t symbol_id, double proposed_size);
-    bool check_daily_loss(double pnl_change);
-    bool is_halted() const { return halted_; }
-    void check_and_update_halt(double current_equity, double initial_capital, double daily_pnl);
-    
+
+    void set_limits(const RiskLimits& limits);
+    const RiskLimits& limits() const { return limits_; }
+
+    // Pre-trade checks - true when every rule passes; rejections are counted
+    bool check_order(const Order& order, double portfolio_cash, double position_quantity);
+    bool check_order(const Order& order, const Portfolio& portfolio);
+    // Batch against one portfolio snapshot: accepted buys consume cash and every
+    // accepted order moves its symbol's projected position, so later orders see
+    // earlier ones. results[i] is the first violated rule, or COUNT if accepted.
+    size_t check_batch(const Order* orders, size_t count, const Portfolio& portfolio, RiskRule* results);
+    // Violated rules as a bit mask (bit i = RiskRule i), without counting
+    uint32_t violations(const Order& order, double portfolio_cash, double position_quantity) const;
+
+    // Run state - start() at the beginning of a run (clears halts and
+    // rejection counters), on_equity() once per tick. Returns true while halted.
+    void start(double equity);
+    bool on_equity(uint64_t timestamp, double equity);
+
+    // Standalone checks (for strategies tracking their own peak)
+    bool check_drawdown(const Portfolio& portfolio, double peak_equity) const;
+    bool check_position_limit(const Portfolio& portfolio, uint32_t symbol_id, double proposed_size) const;
+
     // State management
+    bool is_halted() const { return halted_; }
     void halt();
     void reset();
     void reset_daily();
-    // bool is_halted() const;
-    
-    const RiskLimits& limits() const { return limits_; }
+
+    // Incremental state
+    double peak_equity() const { return peak_equity_; }
+    double drawdown() const { return drawdown_; }
+    double daily_pnl() const { return last_equity_ - day_start_equity_; }
+    uint64_t day() const { return day_; }
+
+    // Counters
+    uint64_t rejections(RiskRule rule) const { return rejections_[static_cast<size_t>(rule)]; }
+    uint64_t total_rejections() const;
+    uint64_t orders_checked() const { return orders_checked_; }
+    RiskRule halt_reason() const { return halt_reason_; }
+
+    // Console logging of halts and lifts (on by default)
+    void set_verbose(bool verbose) { verbose_ = verbose; }
 
 private:
+    static constexpr double kUnlimited = std::numeric_limits<double>::infinity();
+    static constexpr uint64_t kNoDay = std::numeric_limits<uint64_t>::max();
+    static constexpr uint64_t kDayNs = 86'400'000'000'000ULL;
+
+    // Limits with disabled entries replaced by +inf
+    struct Thresholds {
+        double order_size = kUnlimited;
+        double notional = kUnlimited;
+        double position = kUnlimited;
+        double drawdown = kUnlimited;
+        double daily_loss = kUnlimited;
+    };
+
+    void halt_for(RiskRule reason);
+
     RiskLimits limits_;
+    Thresholds thresholds_;
     bool halted_ = false;
-    double daily_pnl_;
-    uint64_t last_day_;
+    RiskRule halt_reason_ = RiskRule::COUNT;   // COUNT = not halted
+    bool started_ = false;
+    bool verbose_ = true;
+
     double peak_equity_ = 0.0;
+    double last_equity_ = 0.0;
+    double day_start_equity_ = 0.0;
+    double drawdown_ = 0.0;
+    uint64_t day_ = kNoDay;
+
+    std::array<uint64_t, static_cast<size_t>(RiskRule::COUNT)> rejections_{};
+    uint64_t orders_checked_ = 0;
 };
 
-} // namespace felix
\ No newline at end of file
+} // namespace felix
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace felix {
+
+/**
+ * Shared Log - Section 7
+ *
+ * Append-only record buffer whose storage can be handed out as a snapshot
+ * (e.g. wrapped as a NumPy array without copying). Appends go into spare
+ * capacity, which never moves existing records; only when the buffer must
+ * grow while a snapshot is still held is the storage detached into a new
+ * allocation, leaving the snapshot's memory valid.
+ */
+template <typename T>
+class SharedLog {
+public:
+    SharedLog() : items_(std::make_shared<std::vector<T>>()) {}
+
+    void push_back(const T& item) {
+        if (items_->size() == items_->capacity() && items_.use_count() > 1) {
+            detach();
+        }
+        items_->push_back(item);
+    }
+
+    void reserve(size_t n) {
+        if (items_.use_count() > 1) detach();
+        items_->reserve(n);
+    }
+
+    size_t size() const { return items_->size(); }
+    bool empty() const { return items_->empty(); }
+    const std::vector<T>& items() const { return *items_; }
+
+    // Snapshot sharing this log's storage; covers the first size() records
+    std::shared_ptr<const std::vector<T>> snapshot() const { return items_; }
+
+private:
+    void detach() {
+        auto next = std::make_shared<std::vector<T>>();
+        next->reserve(items_->capacity() > 0 ? 2 * items_->capacity() : 16);
+        next->assign(items_->begin(), items_->end());
+        items_ = std::move(next);
+    }
+
+    std::shared_ptr<std::vector<T>> items_;
+};
+
+} // namespace felix
@@ -0,0 +1,118 @@
+#pragma once
+
+#include "felix/datastream.hpp"
+#include "felix/event_loop.hpp"
+#include "felix/matching.hpp"
+#include "felix/portfolio.hpp"
+#include "felix/risk.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace felix {
+
+/**
+ * Signal Mode - Section 7
+ */
+enum class SignalMode {
+    TARGET_POSITION,   // Value is the desired position; the difference is traded
+    ORDER_QUANTITY     // Value is a signed market order quantity
+};
+
+/**
+ * Signal Schedule - Section 7
+ *
+ * Precomputed signals (e.g. from NumPy) for EventLoop::run_signals. Values
+ * are not owned. Without timestamps there is one value per tick in stream
+ * order, applied to that tick's symbol. With timestamps (ascending), value i
+ * applies at the first tick at or after timestamps[i] - e.g. one per bar -
+ * to symbol_ids[i], or to that tick's symbol when symbol_ids is null.
+ * NaN values are skipped. With cancel_unfilled, a new signal for a symbol
+ * first cancels this strategy's unfilled orders for it.
+ */
+struct SignalSchedule {
+    SignalMode mode = SignalMode::TARGET_POSITION;
+    const double* values = nullptr;
+    size_t count = 0;
+    const uint64_t* timestamps = nullptr;
+    const uint32_t* symbol_ids = nullptr;
+    double min_trade_size = 1e-9;      // Smaller rebalances are not traded
+    bool cancel_unfilled = false;      // Replace resting orders instead of netting them
+};
+
+/**
+ * Signal Strategy - Section 7
+ *
+ * Native strategy that turns a SignalSchedule into market orders, so a
+ * signal-driven backtest runs without Python callbacks. Orders go through
+ * the matching engine as usual (risk, latency, slippage). Target positions
+ * are netted against the position plus this strategy's unfilled orders,
+ * so latency does not cause double trading; orders that close unfilled
+ * (cancelled or rejected) stop counting once they leave the book.
+ */
+class SignalStrategy : public StrategyWrapper {
+public:
+    SignalStrategy(const DataStream& stream, const SignalSchedule& schedule,
+                   MatchingEngine& engine, Portfolio& portfolio);
+
+    void on_start() override;
+    void on_tick(const TickRecord& tick) override;
+    void on_bar(const TickRecord&) override {}
+    void on_fill(const Fill& fill) override;
+    void on_end() override {}
+    bool should_wake(const TickRecord& tick) override;
+
+    uint64_t signals_applied() const { return signals_applied_; }
+    uint64_t orders_submitted() const { return orders_submitted_; }
+    uint64_t orders_rejected() const { return orders_rejected_; }
+
+private:
+    void apply(uint32_t symbol_id, double value, uint64_t timestamp);
+    void reconcile();
+
+    const DataStream& stream_;
+    SignalSchedule schedule_;
+    MatchingEngine& engine_;
+    Portfolio& portfolio_;
+
+    size_t cursor_ = 0;                      // Next timed signal
+    std::vector<double> outstanding_;        // Signed unfilled quantity per dense symbol index
+    std::unordered_map<uint64_t, uint32_t> working_;   // Open order id -> dense symbol index
+    size_t history_seen_ = 0;                // Engine order history already reconciled
+    uint64_t signals_applied_ = 0;
+    uint64_t orders_submitted_ = 0;
+    uint64_t orders_rejected_ = 0;
+};
+
+/**
+ * Signal Backtest - Section 7
+ * Settings for a self-contained native run over per-tick signals, as used
+ * by walk-forward folds and Monte Carlo re-runs: every run builds its own
+ * engine, portfolio and event loop, starts flat with initial_capital and
+ * logs nothing, so many can run concurrently on one DataStream.
+ */
+struct SignalBacktestConfig {
+    double initial_capital = 100000.0;
+    SlippageConfig slippage;
+    LatencyConfig latency;
+    bool use_risk = false;                 // Apply risk_limits
+    RiskLimits risk_limits;
+    EquityRecordingConfig recording;       // spill_path is ignored
+    SignalMode mode = SignalMode::TARGET_POSITION;
+    double min_trade_size = 1e-9;
+    double risk_free_rate = 0.0;
+    double periods_per_year = 252.0;
+};
+
+struct SignalBacktestRun {
+    PerformanceSummary summary;
+    std::vector<EquityPoint> curve;        // Only with keep_curve
+    uint64_t orders = 0;
+};
+
+// signals[i] applies to stream tick i (stream.size() values)
+SignalBacktestRun run_signal_backtest(const DataStream& stream, const double* signals,
+                                      const SignalBacktestConfig& config, bool keep_curve = false);
+
+} // namespace felix
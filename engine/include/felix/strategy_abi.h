@@ -0,0 +1,85 @@
+/*
+ * Native Strategy ABI - Section 7
+ *
+ * Plain C interface for strategies compiled outside the engine (C, Rust,
+ * Numba @cfunc, ctypes). The event loop calls the callbacks directly, so a
+ * run needs neither the GIL nor the interpreter.
+ *
+ * felix_tick and felix_fill have the exact layout of the engine's
+ * TickRecord and Fill (the same records the NumPy exports use), so
+ * callbacks read the engine's own data in place. Orders are submitted
+ * through ctx->api; every call goes through the matching engine as usual
+ * (risk, latency, slippage).
+ */
+#ifndef FELIX_STRATEGY_ABI_H
+#define FELIX_STRATEGY_ABI_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define FELIX_STRATEGY_ABI_VERSION 1
+
+/* Side / order type values, as in felix::Side and felix::OrderType */
+enum { FELIX_BUY = 0, FELIX_SELL = 1 };
+enum { FELIX_MARKET = 0, FELIX_LIMIT = 1, FELIX_STOP = 2 };
+
+typedef struct felix_tick {
+    uint64_t timestamp;
+    uint32_t symbol_id;
+    float price;
+    float bid;
+    float ask;
+    float bid_size;
+    float ask_size;
+    uint32_t volume;
+    uint32_t symbol_index;
+} felix_tick;
+
+typedef struct felix_fill {
+    uint64_t order_id;
+    uint32_t symbol_id;
+    int32_t side;
+    double price;
+    double volume;
+    uint64_t timestamp;
+    double slippage;                /* bps */
+    uint32_t strategy_id;
+} felix_fill;
+
+typedef struct felix_context felix_context;
+
+/*
+ * Order submission and book queries. submit returns the order id, or 0
+ * when the order is rejected; price is the limit / stop level (ignored
+ * for FELIX_MARKET) and timestamp 0 means the current tick's time.
+ * cancel returns 1 when the order was still pending.
+ */
+typedef struct felix_api {
+    uint32_t version;
+    uint64_t (*submit)(felix_context* ctx, uint32_t symbol_id, int32_t side, int32_t order_type,
+                       double size, double price, uint64_t timestamp);
+    int32_t (*cancel)(felix_context* ctx, uint64_t order_id);
+    double (*position)(felix_context* ctx, uint32_t symbol_id);
+    double (*cash)(felix_context* ctx);
+    double (*equity)(felix_context* ctx);
+} felix_api;
+
+/* One per run; valid only during callbacks */
+struct felix_context {
+    const felix_api* api;
+    void* engine;                   /* Opaque */
+};
+
+/* state is the user pointer given with the callbacks */
+typedef void (*felix_on_tick_fn)(felix_context* ctx, const felix_tick* tick, void* state);
+typedef void (*felix_on_bar_fn)(felix_context* ctx, const felix_tick* bar, void* state);
+typedef void (*felix_on_fill_fn)(felix_context* ctx, const felix_fill* fill, void* state);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FELIX_STRATEGY_ABI_H */
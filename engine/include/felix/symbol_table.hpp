@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace felix {
+
+/**
+ * SymbolTable - Section 4.1
+ * Maps external symbol ids to dense indices [0, size()).
+ * Built once at load time; per-tick lookups are a single array load.
+ * Ids beyond kDirectLimit fall back to a hash map.
+ */
+class SymbolTable {
+public:
+    static constexpr uint32_t kNoIndex = UINT32_MAX;
+    static constexpr uint32_t kDirectLimit = 1u << 20;
+
+    // Returns the dense index, assigning the next one for a new symbol
+    uint32_t intern(uint32_t symbol_id);
+
+    // Returns kNoIndex for unknown symbols
+    uint32_t find(uint32_t symbol_id) const {
+        if (symbol_id < kDirectLimit) {
+            return (symbol_id < direct_.size()) ? direct_[symbol_id] : kNoIndex;
+        }
+        auto it = sparse_.find(symbol_id);
+        return (it != sparse_.end()) ? it->second : kNoIndex;
+    }
+
+    uint32_t symbol_id(uint32_t index) const { return symbols_[index]; }
+    const std::vector<uint32_t>& symbols() const { return symbols_; }
+    size_t size() const { return symbols_.size(); }
+    bool empty() const { return symbols_.empty(); }
+
+private:
+    std::vector<uint32_t> direct_;                    // symbol_id -> index
+    std::unordered_map<uint32_t, uint32_t> sparse_;   // Large ids only
+    std::vector<uint32_t> symbols_;                   // index -> symbol_id
+};
+
+} // namespace felix
@@ -13,7 +13,7 @@ struct TickRecord {
     float bid_size;         // 4 bytes
     float ask_size;         // 4 bytes
     uint32_t volume;        // 4 bytes
-    uint32_t padding;       // 4 bytes
+    uint32_t symbol_index;  // 4 bytes - dense index, stamped by DataStream::load (padding on disk)
 };
 #pragma pack(pop)
 
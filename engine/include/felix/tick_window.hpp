@@ -0,0 +1,108 @@
+#pragma once
+
+#include "felix/symbol_table.hpp"
+#include "felix/tick_record.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace felix {
+
+/**
+ * Mirrored Ring - Section 4.1
+ * Fixed-capacity ring where every element is written twice, at i and
+ * i + capacity. The last size() elements are then always one contiguous
+ * run, so they can be handed out as a plain array without copying.
+ */
+template <typename T>
+class MirroredRing {
+public:
+    explicit MirroredRing(size_t capacity = 0) : buffer_(2 * capacity), capacity_(capacity) {}
+
+    void push(const T& value) {
+        if (capacity_ == 0) return;
+        buffer_[head_] = value;
+        buffer_[head_ + capacity_] = value;
+        head_ = (head_ + 1 == capacity_) ? 0 : head_ + 1;
+        count_ = std::min(count_ + 1, capacity_);
+    }
+
+    void clear() { head_ = count_ = 0; }
+
+    // Oldest first; valid until the next push
+    const T* data() const { return buffer_.data() + head_ + capacity_ - count_; }
+    size_t size() const { return count_; }
+    size_t capacity() const { return capacity_; }
+
+private:
+    std::vector<T> buffer_;
+    size_t capacity_;
+    size_t head_ = 0;     // Next write slot
+    size_t count_ = 0;
+};
+
+/**
+ * Window Bar - one completed OHLCV time bar (48 bytes)
+ */
+struct WindowBar {
+    uint64_t timestamp = 0;       // Bar start (multiple of bar_ns)
+    uint32_t symbol_id = 0;
+    uint32_t ticks = 0;
+    double open = 0.0;
+    double high = 0.0;
+    double low = 0.0;
+    double close = 0.0;
+    double volume = 0.0;
+};
+
+struct TickWindowConfig {
+    uint32_t tick_capacity = 1024;  // Last N ticks per symbol (0 = off)
+    uint32_t bar_capacity = 0;      // Last N completed bars per symbol (0 = off)
+    uint64_t bar_ns = 60'000'000'000ULL;
+};
+
+/**
+ * Tick Window - Section 4.1
+ *
+ * Recent market history kept by the engine: the last N ticks and, with
+ * bars enabled, the last N completed time bars of every symbol, each in a
+ * mirrored ring. The event loop updates it before the strategy is called,
+ * so strategies read history as contiguous arrays instead of keeping
+ * their own lists. Memory is 2 x capacity records per symbol.
+ */
+class TickWindow {
+public:
+    explicit TickWindow(const TickWindowConfig& config = TickWindowConfig{});
+
+    void set_config(const TickWindowConfig& config);
+    const TickWindowConfig& config() const { return config_; }
+
+    // Sizes the per-symbol rings up front (the event loop calls this at run start)
+    void register_symbols(const SymbolTable& symbols);
+    void update(const TickRecord& tick);
+    void clear();
+
+    // Oldest first; count is set to the number of records (0 for unknown symbols).
+    // Pointers stay valid until the next update().
+    const TickRecord* ticks(uint32_t symbol_id, size_t& count) const;
+    const WindowBar* bars(uint32_t symbol_id, size_t& count) const;
+
+    size_t symbol_count() const { return symbols_.size(); }
+
+private:
+    struct Slot {
+        MirroredRing<TickRecord> ticks;
+        MirroredRing<WindowBar> bars;
+        WindowBar pending;            // Bar in progress
+        bool bar_open = false;
+    };
+
+    Slot& slot(uint32_t symbol_id);
+
+    TickWindowConfig config_;
+    SymbolTable symbols_;
+    std::vector<Slot> slots_;
+};
+
+} // namespace felix
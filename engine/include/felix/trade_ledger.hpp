@@ -0,0 +1,92 @@
+#pragma once
+
+#include "felix/execution.hpp"
+#include "felix/shared_log.hpp"
+#include "felix/symbol_table.hpp"
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <vector>
+
+namespace felix {
+
+/**
+ * Lot Matching - Section 4.2
+ * How closing fills are paired with the open lots they close
+ */
+enum class LotMatching {
+    AVERAGE_COST,   // One lot per symbol at the average entry price (matches Portfolio)
+    FIFO            // Oldest lot closed first, each at its own entry price
+};
+
+/**
+ * Trade - Section 4.2
+ * One closed round trip (or the closed part of one)
+ */
+struct Trade {
+    uint64_t entry_order_id = 0;
+    uint64_t exit_order_id = 0;
+    uint64_t entry_time = 0;
+    uint64_t exit_time = 0;
+    uint64_t holding_ns = 0;
+    uint32_t symbol_id = 0;
+    Side side = Side::BUY;          // BUY = long round trip, SELL = short
+    double quantity = 0.0;
+    double entry_price = 0.0;
+    double exit_price = 0.0;
+    double pnl = 0.0;
+    double return_pct = 0.0;        // pnl relative to entry notional, in percent
+};
+
+/**
+ * Trade Ledger - Section 4.2
+ *
+ * Pairs fills into round trips as they arrive: fills in the direction of
+ * the open position add lots, opposing fills close lots (partially if
+ * needed) and any excess flips the position into a new lot. Closed trades
+ * are appended to a shared log so they can be exported without copying.
+ */
+class TradeLedger {
+public:
+    explicit TradeLedger(LotMatching matching = LotMatching::AVERAGE_COST);
+
+    // Changing the matching rule applies to lots opened afterwards
+    void set_matching(LotMatching matching) { matching_ = matching; }
+    LotMatching matching() const { return matching_; }
+
+    void on_fill(const Fill& fill);
+
+    const std::vector<Trade>& trades() const { return trades_.items(); }
+    std::shared_ptr<const std::vector<Trade>> snapshot() const { return trades_.snapshot(); }
+    size_t size() const { return trades_.size(); }
+    double realized_pnl() const { return realized_pnl_; }
+
+    // Signed quantity still open for a symbol
+    double open_quantity(uint32_t symbol_id) const;
+
+private:
+    static constexpr double kMinQuantity = 1e-9;
+
+    struct Lot {
+        double quantity = 0.0;      // Unsigned; direction is the book's
+        double price = 0.0;
+        uint64_t timestamp = 0;
+        uint64_t order_id = 0;
+    };
+
+    struct Book {
+        std::deque<Lot> lots;
+        double position = 0.0;      // Signed open quantity
+    };
+
+    void open_lot(Book& book, const Fill& fill, double quantity);
+    void close_lot(Lot& lot, const Fill& fill, double quantity, double direction);
+
+    LotMatching matching_;
+    SymbolTable symbols_;
+    std::vector<Book> books_;       // Indexed by symbols_ dense index
+    SharedLog<Trade> trades_;
+    double realized_pnl_ = 0.0;
+};
+
+} // namespace felix
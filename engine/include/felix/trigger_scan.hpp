@@ -0,0 +1,36 @@
+#pragma once
+
+#include "felix/aligned.hpp"
+#include "felix/tick_record.hpp"
+#include <cstddef>
+#include <cstdint>
+
+namespace felix {
+
+/**
+ * Trigger Envelope - Section 5.3
+ * Per-symbol price band (indexed by TickRecord::symbol_index) plus the
+ * earliest timer. A tick whose price, bid and ask all sit strictly inside
+ * its symbol's band, before the timer, cannot fill a resting order or wake
+ * the strategy. Bands are stored as floats rounded outward, so the float
+ * test never misses a trigger the exact double comparison would catch.
+ */
+struct TriggerEnvelope {
+    AlignedVector<float> lo;           // Trigger if a price is <= lo
+    AlignedVector<float> hi;           // Trigger if a price is >= hi
+    uint64_t next_time = UINT64_MAX;   // Trigger at or after this timestamp
+
+    void reset(size_t num_symbols);
+    void trigger_at_or_below(uint32_t index, double price);
+    void trigger_at_or_above(uint32_t index, double price);
+    void trigger_always(uint32_t index);
+    void trigger_at_time(uint64_t timestamp);
+};
+
+/**
+ * Index of the first tick in [0, n) that may trigger, or n if none.
+ * Uses an AVX2 gather kernel when available, scalar otherwise.
+ */
+size_t find_first_trigger(const TickRecord* ticks, size_t n, const TriggerEnvelope& envelope);
+
+} // namespace felix
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "felix/datastream.hpp"
+#include "felix/equity_store.hpp"
+#include "felix/matching.hpp"
+#include "felix/performance.hpp"
+#include "felix/risk.hpp"
+#include "felix/signal_strategy.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace felix {
+
+/**
+ * Walk-Forward Metric - Section 8.4
+ * In-sample selection score; higher is better (MAX_DRAWDOWN is negated).
+ */
+enum class WalkForwardMetric : uint8_t {
+    SHARPE,
+    SORTINO,
+    TOTAL_RETURN,
+    CAGR,
+    MAX_DRAWDOWN,
+    PROFIT_FACTOR
+};
+
+double walk_forward_score(const PerformanceSummary& summary, WalkForwardMetric metric);
+
+/**
+ * Walk-Forward Config - Section 8.4
+ * Folds step by the out-of-sample length, so out-of-sample windows tile
+ * the data without overlap. Rolling folds use the last in_sample_ns
+ * before each out-of-sample window; anchored folds grow from the first
+ * tick. Every run starts flat with initial_capital.
+ */
+struct WalkForwardConfig {
+    uint64_t in_sample_ns = 0;
+    uint64_t out_of_sample_ns = 0;
+    bool anchored = false;
+    WalkForwardMetric metric = WalkForwardMetric::SHARPE;
+    unsigned threads = 0;                  // 0 = hardware concurrency
+    bool verbose = true;                   // Progress lines on stdout (errors always go to stderr)
+
+    double initial_capital = 100000.0;
+    SlippageConfig slippage;
+    LatencyConfig latency;
+    bool use_risk = false;                 // Apply risk_limits in every run
+    RiskLimits risk_limits;
+    EquityRecordingConfig recording;       // spill_path is ignored
+    SignalMode mode = SignalMode::TARGET_POSITION;
+    double min_trade_size = 1e-9;
+    double risk_free_rate = 0.0;
+    double periods_per_year = 252.0;
+};
+
+struct WalkForwardFold {
+    uint64_t in_sample_start = 0;          // Timestamps, [start, end)
+    uint64_t in_sample_end = 0;
+    uint64_t out_of_sample_start = 0;
+    uint64_t out_of_sample_end = 0;
+    size_t in_sample_ticks = 0;
+    size_t out_of_sample_ticks = 0;
+    uint32_t best_candidate = 0;
+    double in_sample_score = 0.0;
+    PerformanceSummary in_sample;          // Of the best candidate
+    PerformanceSummary out_of_sample;
+    uint64_t out_of_sample_orders = 0;
+};
+
+struct WalkForwardResult {
+    size_t candidates = 0;
+    std::vector<WalkForwardFold> folds;
+    std::vector<double> scores;            // In-sample, folds x candidates (row-major)
+    std::vector<EquityPoint> equity_curve; // initial_capital at the first out-of-sample start,
+                                           // then the out-of-sample curves compounded end to end
+    PerformanceSummary out_of_sample;      // Over the stitched curve
+};
+
+/**
+ * Walk-Forward Driver - Section 8.4
+ *
+ * Each candidate is one parameter set's precomputed signals over the whole
+ * stream (one value per tick, see SignalSchedule). For every fold, all
+ * candidates run natively on the in-sample window, the best by the metric
+ * then runs on the out-of-sample window, and the out-of-sample equity
+ * curves are stitched together. Windows are DataStream views of the one
+ * loaded dataset; all in-sample runs of all folds, and then all
+ * out-of-sample runs, are spread over a thread pool.
+ */
+WalkForwardResult walk_forward(const DataStream& stream,
+                               const std::vector<const double*>& candidates,
+                               const WalkForwardConfig& config);
+
+} // namespace felix
@@ -0,0 +1,118 @@
+#include "felix/downsample.hpp"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace felix {
+
+namespace {
+
+std::vector<size_t> all_indices(size_t count) {
+    std::vector<size_t> out(count);
+    std::iota(out.begin(), out.end(), size_t{0});
+    return out;
+}
+
+} // namespace
+
+std::vector<size_t> lttb_indices(const double* x, const double* y, size_t count, size_t threshold) {
+    if (threshold >= count || count <= 2) return all_indices(count);
+    if (threshold < 3) return {0, count - 1};
+
+    std::vector<size_t> out;
+    out.reserve(threshold);
+    out.push_back(0);
+
+    // Interior points split into threshold - 2 buckets; each bucket keeps the
+    // point forming the largest triangle with the last kept point and the
+    // average of the next bucket
+    const double width = static_cast<double>(count - 2) / static_cast<double>(threshold - 2);
+    size_t selected = 0;
+    for (size_t b = 0; b < threshold - 2; ++b) {
+        size_t begin = 1 + static_cast<size_t>(std::floor(b * width));
+        size_t end = std::min(1 + static_cast<size_t>(std::floor((b + 1) * width)), count - 1);
+
+        size_t next_begin = end;
+        size_t next_end = std::min(1 + static_cast<size_t>(std::floor((b + 2) * width)), count);
+        double avg_x = 0.0, avg_y = 0.0;
+        for (size_t i = next_begin; i < next_end; ++i) {
+            avg_x += x[i];
+            avg_y += y[i];
+        }
+        const double n = static_cast<double>(next_end - next_begin);
+        avg_x /= n;
+        avg_y /= n;
+
+        const double ax = x[selected], ay = y[selected];
+        double best_area = -1.0;
+        size_t best = begin;
+        for (size_t i = begin; i < end; ++i) {
+            double area = std::abs((ax - avg_x) * (y[i] - ay) - (ax - x[i]) * (avg_y - ay));
+            if (area > best_area) {
+                best_area = area;
+                best = i;
+            }
+        }
+        out.push_back(best);
+        selected = best;
+    }
+    out.push_back(count - 1);
+    return out;
+}
+
+std::vector<size_t> extrema_indices(const double* y, size_t count, size_t buckets) {
+    if (count <= 2 || buckets == 0 || 2 * buckets + 2 >= count) return all_indices(count);
+
+    std::vector<size_t> out;
+    out.reserve(2 * buckets + 2);
+    out.push_back(0);
+    const double width = static_cast<double>(count - 2) / static_cast<double>(buckets);
+    for (size_t b = 0; b < buckets; ++b) {
+        size_t begin = 1 + static_cast<size_t>(std::floor(b * width));
+        size_t end = std::min(1 + static_cast<size_t>(std::floor((b + 1) * width)), count - 1);
+        if (begin >= end) continue;
+        auto [lo, hi] = std::minmax_element(y + begin, y + end);
+        size_t a = static_cast<size_t>(lo - y), c = static_cast<size_t>(hi - y);
+        out.push_back(std::min(a, c));
+        if (a != c) out.push_back(std::max(a, c));
+    }
+    out.push_back(count - 1);
+    return out;
+}
+
+EquityPyramid build_equity_pyramid(const uint64_t* timestamps, const double* equity, size_t count,
+                                   const EquityPyramidConfig& config) {
+    EquityPyramid pyramid;
+    if (config.base_points < 8 || count <= config.base_points) return pyramid;
+    const size_t factor = std::max<uint32_t>(config.factor, 2);
+
+    // Full-resolution drawdown, and x relative to the first timestamp so
+    // nanosecond times keep their precision as doubles
+    std::vector<double> drawdown(count), x(count);
+    double peak = equity[0];
+    for (size_t i = 0; i < count; ++i) {
+        peak = std::max(peak, equity[i]);
+        drawdown[i] = peak > 0.0 ? (peak - equity[i]) / peak : 0.0;
+        x[i] = static_cast<double>(timestamps[i] - timestamps[0]);
+    }
+
+    for (size_t points = config.base_points; points * factor <= count; points *= factor) {
+        // Half the budget for shape, a quarter each for equity and drawdown extremes
+        std::vector<size_t> keep = lttb_indices(x.data(), equity, count, points / 2);
+        const size_t buckets = points / 8;
+        for (size_t i : extrema_indices(equity, count, buckets)) keep.push_back(i);
+        for (size_t i : extrema_indices(drawdown.data(), count, buckets)) keep.push_back(i);
+        std::sort(keep.begin(), keep.end());
+        keep.erase(std::unique(keep.begin(), keep.end()), keep.end());
+
+        std::vector<EquityLevelPoint> level;
+        level.reserve(keep.size());
+        for (size_t i : keep) {
+            level.push_back(EquityLevelPoint{i, timestamps[i], equity[i], drawdown[i]});
+        }
+        pyramid.levels.push_back(std::move(level));
+    }
+    return pyramid;
+}
+
+} // namespace felix
@@ -0,0 +1,372 @@
+#include "felix/indicators.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace felix {
+
+namespace {
+constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+}
+
+// ========== RollingWindow ==========
+
+RollingWindow::RollingWindow(uint32_t period)
+    : values_(std::max<uint32_t>(period, 1), 0.0) {}
+
+bool RollingWindow::push(double x, double& evicted) {
+    if (count_ < values_.size()) {
+        values_[(head_ + count_) % values_.size()] = x;
+        ++count_;
+        return false;
+    }
+    evicted = values_[head_];
+    values_[head_] = x;
+    head_ = (head_ + 1) % values_.size();
+    return true;
+}
+
+// ========== Moving averages ==========
+
+void Sma::update(double x) {
+    double evicted;
+    if (window_.push(x, evicted)) {
+        sum_ -= evicted;
+    }
+    sum_ += x;
+}
+
+double Sma::value() const {
+    return ready() ? sum_ / static_cast<double>(window_.capacity()) : kNaN;
+}
+
+Ema::Ema(uint32_t period)
+    : period_(std::max<uint32_t>(period, 1))
+    , alpha_(2.0 / (static_cast<double>(period_) + 1.0)) {}
+
+void Ema::update(double x) {
+    if (count_ < period_) {
+        // Running mean of the first N inputs seeds the average
+        ++count_;
+        value_ += (x - value_) / static_cast<double>(count_);
+        return;
+    }
+    value_ += alpha_ * (x - value_);
+}
+
+double Ema::value() const {
+    return ready() ? value_ : kNaN;
+}
+
+void Wma::update(double x) {
+    double evicted;
+    if (window_.push(x, evicted)) {
+        // Every weight drops by one (the oldest to zero); x enters at N
+        weighted_sum_ += static_cast<double>(window_.capacity()) * x - sum_;
+        sum_ += x - evicted;
+    } else {
+        weighted_sum_ += static_cast<double>(window_.size()) * x;
+        sum_ += x;
+    }
+}
+
+double Wma::value() const {
+    if (!ready()) return kNaN;
+    double n = static_cast<double>(window_.capacity());
+    return weighted_sum_ / (n * (n + 1.0) / 2.0);
+}
+
+// ========== RollingStats ==========
+
+void RollingStats::update(double x) {
+    double evicted;
+    if (window_.push(x, evicted)) {
+        double old_mean = mean_;
+        double delta = x - evicted;
+        mean_ += delta / static_cast<double>(window_.capacity());
+        m2_ += delta * (x - mean_ + evicted - old_mean);
+        if (m2_ < 0.0) m2_ = 0.0;   // Rounding on flat windows
+    } else {
+        double delta = x - mean_;
+        mean_ += delta / static_cast<double>(window_.size());
+        m2_ += delta * (x - mean_);
+    }
+}
+
+double RollingStats::stddev() const {
+    if (window_.size() == 0) return kNaN;
+    return std::sqrt(m2_ / static_cast<double>(window_.size()));
+}
+
+double RollingStats::zscore(double x) const {
+    double sd = stddev();
+    return (sd > 0.0) ? (x - mean_) / sd : 0.0;
+}
+
+// ========== Wilder RSI / ATR ==========
+
+void Rsi::update(double x) {
+    if (!started_) {
+        last_ = x;
+        started_ = true;
+        return;
+    }
+    double change = x - last_;
+    last_ = x;
+    double gain = std::max(change, 0.0);
+    double loss = std::max(-change, 0.0);
+
+    if (changes_ < period_) {
+        // Simple average of the first N changes, then Wilder smoothing
+        ++changes_;
+        avg_gain_ += (gain - avg_gain_) / static_cast<double>(changes_);
+        avg_loss_ += (loss - avg_loss_) / static_cast<double>(changes_);
+        return;
+    }
+    double n = static_cast<double>(period_);
+    avg_gain_ = (avg_gain_ * (n - 1.0) + gain) / n;
+    avg_loss_ = (avg_loss_ * (n - 1.0) + loss) / n;
+}
+
+double Rsi::value() const {
+    if (!ready()) return kNaN;
+    if (avg_loss_ == 0.0) {
+        return (avg_gain_ == 0.0) ? 50.0 : 100.0;
+    }
+    return 100.0 - 100.0 / (1.0 + avg_gain_ / avg_loss_);
+}
+
+void Atr::update(double high, double low, double close) {
+    double range = high - low;
+    if (count_ > 0) {
+        range = std::max({range, std::abs(high - prev_close_), std::abs(low - prev_close_)});
+    }
+    prev_close_ = close;
+
+    if (count_ < period_) {
+        ++count_;
+        value_ += (range - value_) / static_cast<double>(count_);
+        return;
+    }
+    double n = static_cast<double>(period_);
+    value_ = (value_ * (n - 1.0) + range) / n;
+}
+
+double Atr::value() const {
+    return ready() ? value_ : kNaN;
+}
+
+// ========== VWAP ==========
+
+Vwap::Vwap(uint32_t period)
+    : period_(period), prices_(period), volumes_(period) {}
+
+void Vwap::update(double price, double volume) {
+    double pv = price * volume;
+    if (period_ > 0) {
+        double old_pv, old_volume;
+        if (prices_.push(pv, old_pv)) pv_ -= old_pv;
+        if (volumes_.push(volume, old_volume)) volume_ -= old_volume;
+    }
+    pv_ += pv;
+    volume_ += volume;
+}
+
+double Vwap::value() const {
+    return ready() ? pv_ / volume_ : kNaN;
+}
+
+// ========== RollingExtreme ==========
+
+RollingExtreme::RollingExtreme(uint32_t period, bool maximum)
+    : deque_(std::max<uint32_t>(period, 1))
+    , period_(std::max<uint32_t>(period, 1))
+    , maximum_(maximum) {}
+
+void RollingExtreme::update(double x) {
+    const size_t capacity = deque_.size();
+    uint64_t seq = seen_++;
+
+    // Drop the front once it leaves the window
+    if (size_ > 0 && deque_[front_].seq + period_ <= seq) {
+        front_ = (front_ + 1) % capacity;
+        --size_;
+    }
+    // Drop entries x dominates; they can never be the extreme again
+    while (size_ > 0) {
+        const Entry& back = deque_[(front_ + size_ - 1) % capacity];
+        if (maximum_ ? back.value > x : back.value < x) break;
+        --size_;
+    }
+    deque_[(front_ + size_) % capacity] = Entry{seq, x};
+    ++size_;
+}
+
+double RollingExtreme::value() const {
+    return ready() ? deque_[front_].value : kNaN;
+}
+
+// ========== IndicatorSet ==========
+
+IndicatorSet::State IndicatorSet::make_state(const IndicatorSpec& spec) {
+    switch (spec.kind) {
+        case IndicatorKind::SMA: return Sma(spec.period);
+        case IndicatorKind::EMA: return Ema(spec.period);
+        case IndicatorKind::WMA: return Wma(spec.period);
+        case IndicatorKind::STDDEV:
+        case IndicatorKind::BOLLINGER:
+        case IndicatorKind::ZSCORE: return RollingStats(spec.period);
+        case IndicatorKind::RSI: return Rsi(spec.period);
+        case IndicatorKind::ATR: return Atr(spec.period);
+        case IndicatorKind::VWAP: return Vwap(spec.period);
+        case IndicatorKind::MIN: return RollingExtreme(spec.period, false);
+        case IndicatorKind::MAX: return RollingExtreme(spec.period, true);
+    }
+    return Sma(spec.period);
+}
+
+uint32_t IndicatorSet::add(const IndicatorSpec& spec) {
+    uint32_t handle = static_cast<uint32_t>(specs_.size());
+    specs_.push_back(spec);
+    states_.push_back(make_state(spec));
+    bars_.emplace_back();
+    values_.push_back(kNaN);
+    upper_.push_back(kNaN);
+    lower_.push_back(kNaN);
+    ready_.push_back(0);
+
+    uint32_t index = symbols_.intern(spec.symbol_id);
+    if (index >= by_symbol_.size()) {
+        by_symbol_.resize(index + 1);
+    }
+    by_symbol_[index].push_back(handle);
+    return handle;
+}
+
+void IndicatorSet::clear() {
+    *this = IndicatorSet();
+}
+
+void IndicatorSet::reset() {
+    for (uint32_t h = 0; h < specs_.size(); ++h) {
+        states_[h] = make_state(specs_[h]);
+        bars_[h] = Bar{};
+        values_[h] = upper_[h] = lower_[h] = kNaN;
+        ready_[h] = 0;
+    }
+    updates_ = 0;
+}
+
+void IndicatorSet::update(const TickRecord& tick) {
+    uint32_t index = symbols_.find(tick.symbol_id);
+    if (index == SymbolTable::kNoIndex) return;
+
+    const double price = tick.price;
+    const double volume = tick.volume;
+    for (uint32_t h : by_symbol_[index]) {
+        const uint64_t bar_ns = specs_[h].bar_ns;
+        if (bar_ns == 0) {
+            feed(h, price, price, price, volume);
+            continue;
+        }
+        // Time bars: the previous bar is complete once a tick lands in a new interval
+        Bar& bar = bars_[h];
+        uint64_t bucket = tick.timestamp / bar_ns;
+        if (bar.open && bucket != bar.bucket) {
+            feed(h, bar.high, bar.low, bar.close, bar.volume);
+            bar.open = false;
+        }
+        if (!bar.open) {
+            bar = Bar{bucket, price, price, price, volume, true};
+        } else {
+            bar.high = std::max(bar.high, price);
+            bar.low = std::min(bar.low, price);
+            bar.close = price;
+            bar.volume += volume;
+        }
+    }
+}
+
+void IndicatorSet::feed(uint32_t handle, double high, double low, double close, double volume) {
+    ++updates_;
+    const IndicatorSpec& spec = specs_[handle];
+    State& state = states_[handle];
+    double value = kNaN;
+    bool ready = false;
+
+    switch (spec.kind) {
+        case IndicatorKind::SMA: {
+            auto& s = std::get<Sma>(state);
+            s.update(close);
+            ready = s.ready();
+            value = s.value();
+            break;
+        }
+        case IndicatorKind::EMA: {
+            auto& s = std::get<Ema>(state);
+            s.update(close);
+            ready = s.ready();
+            value = s.value();
+            break;
+        }
+        case IndicatorKind::WMA: {
+            auto& s = std::get<Wma>(state);
+            s.update(close);
+            ready = s.ready();
+            value = s.value();
+            break;
+        }
+        case IndicatorKind::STDDEV:
+        case IndicatorKind::BOLLINGER:
+        case IndicatorKind::ZSCORE: {
+            auto& s = std::get<RollingStats>(state);
+            s.update(close);
+            ready = s.ready();
+            if (!ready) break;
+            if (spec.kind == IndicatorKind::STDDEV) {
+                value = s.stddev();
+            } else if (spec.kind == IndicatorKind::ZSCORE) {
+                value = s.zscore(close);
+            } else {
+                double band = spec.param * s.stddev();
+                value = s.mean();
+                upper_[handle] = value + band;
+                lower_[handle] = value - band;
+            }
+            break;
+        }
+        case IndicatorKind::RSI: {
+            auto& s = std::get<Rsi>(state);
+            s.update(close);
+            ready = s.ready();
+            value = s.value();
+            break;
+        }
+        case IndicatorKind::ATR: {
+            auto& s = std::get<Atr>(state);
+            s.update(high, low, close);
+            ready = s.ready();
+            value = s.value();
+            break;
+        }
+        case IndicatorKind::VWAP: {
+            auto& s = std::get<Vwap>(state);
+            s.update(close, volume);
+            ready = s.ready();
+            value = s.value();
+            break;
+        }
+        case IndicatorKind::MIN:
+        case IndicatorKind::MAX: {
+            // Bar lows / highs, so bar_ns gives a Donchian channel
+            auto& s = std::get<RollingExtreme>(state);
+            s.update(spec.kind == IndicatorKind::MIN ? low : high);
+            ready = s.ready();
+            value = s.value();
+            break;
+        }
+    }
+    values_[handle] = value;
+    ready_[handle] = ready ? 1 : 0;
+}
+
+} // namespace felix
@@ -0,0 +1,175 @@
+#include "felix/monte_carlo.hpp"
+#include "felix/parallel.hpp"
+#include "felix/performance.hpp"
+#include "felix/random.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace felix {
+
+namespace {
+
+/**
+ * Uniform draws for one path: Philox blocks keyed by the seed with the path
+ * in the counter. Counter word 1 has its top bit set, so these never
+ * coincide with philox_normal(seed, path, index) draws.
+ */
+class PathRandom {
+public:
+    PathRandom(uint64_t seed, uint64_t path)
+        : key_{static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)}, path_(path) {}
+
+    uint32_t next() {
+        if (used_ == 4) {
+            block_ = Philox4x32::generate({static_cast<uint32_t>(counter_),
+                                           static_cast<uint32_t>(counter_ >> 32) | 0x80000000u,
+                                           static_cast<uint32_t>(path_),
+                                           static_cast<uint32_t>(path_ >> 32)}, key_);
+            ++counter_;
+            used_ = 0;
+        }
+        return block_[used_++];
+    }
+
+    // Uniform in [0, n) for n < 2^32 (multiply-shift)
+    size_t below(size_t n) {
+        return static_cast<size_t>((static_cast<uint64_t>(next()) * n) >> 32);
+    }
+
+    // Uniform in [0, 1)
+    double uniform() {
+        uint64_t bits = (static_cast<uint64_t>(next()) << 32) | next();
+        return static_cast<double>(bits >> 11) * 0x1.0p-53;
+    }
+
+private:
+    Philox4x32::Key key_;
+    uint64_t path_;
+    uint64_t counter_ = 0;
+    Philox4x32::Counter block_{};
+    int used_ = 4;
+};
+
+// Percentiles of values with linear interpolation (numpy.percentile's default)
+std::vector<double> percentiles_of(std::vector<double> values, const std::vector<double>& pcts) {
+    std::vector<double> out(pcts.size(), 0.0);
+    if (values.empty()) return out;
+    std::sort(values.begin(), values.end());
+    const double last = static_cast<double>(values.size() - 1);
+    for (size_t i = 0; i < pcts.size(); ++i) {
+        double rank = std::clamp(pcts[i], 0.0, 100.0) / 100.0 * last;
+        size_t lo = static_cast<size_t>(std::floor(rank));
+        size_t hi = std::min(lo + 1, values.size() - 1);
+        out[i] = values[lo] + (rank - static_cast<double>(lo)) * (values[hi] - values[lo]);
+    }
+    return out;
+}
+
+// Runs path(p) -> PerformanceSummary for every path and collects the tables
+template <typename Path>
+MonteCarloResult run_paths(const MonteCarloConfig& config, Path path) {
+    MonteCarloResult result;
+    result.percentiles = config.percentiles;
+    result.final_equity.resize(config.paths);
+    result.max_drawdown.resize(config.paths);
+    result.sharpe.resize(config.paths);
+
+    parallel_for(config.paths, config.threads, [&](size_t p) {
+        PerformanceSummary s = path(p);
+        result.final_equity[p] = s.final_equity;
+        result.max_drawdown[p] = s.max_drawdown;
+        result.sharpe[p] = s.sharpe_ratio;
+    });
+
+    result.final_equity_pct = percentiles_of(result.final_equity, config.percentiles);
+    result.max_drawdown_pct = percentiles_of(result.max_drawdown, config.percentiles);
+    result.sharpe_pct = percentiles_of(result.sharpe, config.percentiles);
+    return result;
+}
+
+} // namespace
+
+MonteCarloResult monte_carlo_trades(const double* pnls, size_t count, double initial_equity,
+                                    const MonteCarloConfig& config) {
+    if (count == 0) {
+        std::cerr << "[MonteCarlo] No trades to resample" << std::endl;
+        MonteCarloResult empty{};
+        empty.percentiles = config.percentiles;
+        return empty;
+    }
+    return run_paths(config, [&](size_t p) {
+        PathRandom rng(config.seed, p);
+        std::vector<double> order;
+        if (!config.with_replacement) {
+            // Fisher-Yates: same trades, different sequence
+            order.assign(pnls, pnls + count);
+            for (size_t i = count - 1; i > 0; --i) {
+                std::swap(order[i], order[rng.below(i + 1)]);
+            }
+        }
+
+        PerformanceTracker tracker;
+        double equity = initial_equity;
+        tracker.update(equity);
+        for (size_t i = 0; i < count; ++i) {
+            double pnl = config.with_replacement ? pnls[rng.below(count)] : order[i];
+            equity += pnl;
+            tracker.update(equity);
+            tracker.on_trade(pnl);
+        }
+        return tracker.summary(config.risk_free_rate, config.periods_per_year);
+    });
+}
+
+MonteCarloResult monte_carlo_returns(const double* equity, size_t count,
+                                     const MonteCarloConfig& config) {
+    if (count < 2) {
+        std::cerr << "[MonteCarlo] Need at least two equity points" << std::endl;
+        MonteCarloResult empty{};
+        empty.percentiles = config.percentiles;
+        return empty;
+    }
+    std::vector<double> returns(count - 1);
+    for (size_t i = 0; i + 1 < count; ++i) {
+        returns[i] = (equity[i] > 0.0) ? equity[i + 1] / equity[i] - 1.0 : 0.0;
+    }
+    const size_t n = returns.size();
+    const size_t block = std::clamp<size_t>(config.block_size, 1, n);
+
+    return run_paths(config, [&](size_t p) {
+        PathRandom rng(config.seed, p);
+        PerformanceTracker tracker;
+        double value = equity[0];
+        tracker.update(value);
+        // Moving blocks: uniformly placed runs of consecutive returns keep
+        // short-range autocorrelation (volatility clustering, streaks)
+        for (size_t produced = 0; produced < n;) {
+            size_t start = rng.below(n - block + 1);
+            for (size_t j = 0; j < block && produced < n; ++j, ++produced) {
+                value *= 1.0 + returns[start + j];
+                tracker.update(value);
+            }
+        }
+        return tracker.summary(config.risk_free_rate, config.periods_per_year);
+    });
+}
+
+MonteCarloResult monte_carlo_execution(const DataStream& stream, const double* signals,
+                                       const SignalBacktestConfig& backtest,
+                                       const ExecutionPerturbation& perturbation,
+                                       const MonteCarloConfig& config) {
+    return run_paths(config, [&](size_t p) {
+        PathRandom rng(config.seed, p);
+        SignalBacktestConfig run = backtest;
+        run.slippage.fixed_bps += std::abs(perturbation.slippage_bps_std * philox_normal(config.seed, p, 0));
+        run.slippage.seed = backtest.slippage.seed + p;
+        if (perturbation.latency_jitter_ns > 0) {
+            run.latency.strategy_latency_ns += static_cast<uint64_t>(
+                rng.uniform() * static_cast<double>(perturbation.latency_jitter_ns + 1));
+        }
+        return run_signal_backtest(stream, signals, run).summary;
+    });
+}
+
+} // namespace felix
@@ -0,0 +1,257 @@
+#include "felix/performance.hpp"
+#include <cmath>
+#include <limits>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace felix {
+
+namespace {
+
+struct ReturnMoments {
+    uint64_t count = 0;
+    double mean = 0.0;
+    double m2 = 0.0;                  // Sum of squared deviations
+    uint64_t downside_count = 0;
+    double downside_mean = 0.0;
+    double downside_m2 = 0.0;
+};
+
+void fill_ratios(PerformanceSummary& s, const ReturnMoments& m, double risk_free_rate, double periods_per_year) {
+    if (m.count == 0) return;
+
+    s.mean_return = m.mean;
+    s.volatility = std::sqrt(m.m2 / static_cast<double>(m.count));
+    if (m.count < 2) return;
+
+    const double excess = m.mean - risk_free_rate / periods_per_year;
+    const double annualize = std::sqrt(periods_per_year);
+    if (s.volatility > 0.0) {
+        s.sharpe_ratio = excess / s.volatility * annualize;
+    }
+
+    double downside_std = (m.downside_count > 0)
+        ? std::sqrt(m.downside_m2 / static_cast<double>(m.downside_count)) : 0.0;
+    if (downside_std == 0.0) {
+        s.sortino_ratio = (excess > 0.0) ? std::numeric_limits<double>::infinity() : 0.0;
+    } else {
+        s.sortino_ratio = excess / downside_std * annualize;
+    }
+}
+
+void fill_totals(PerformanceSummary& s, double first, double last, double periods_per_year) {
+    s.initial_equity = first;
+    s.final_equity = last;
+    if (first != 0.0) {
+        s.total_return_pct = (last / first - 1.0) * 100.0;
+    }
+    double years = static_cast<double>(s.points) / periods_per_year;
+    if (s.points >= 2 && first > 0.0 && years > 0.0) {
+        s.cagr = std::pow(last / first, 1.0 / years) - 1.0;
+    }
+}
+
+#if defined(__AVX2__)
+double horizontal_sum(__m256d v) {
+    __m128d lo = _mm256_castpd256_pd128(v);
+    __m128d hi = _mm256_extractf128_pd(v, 1);
+    lo = _mm_add_pd(lo, hi);
+    return _mm_cvtsd_f64(_mm_add_sd(lo, _mm_unpackhi_pd(lo, lo)));
+}
+
+// Four returns (e[i+1] - e[i]) / e[i] per step
+inline __m256d returns_at(const double* equity, size_t i) {
+    __m256d prev = _mm256_loadu_pd(equity + i);
+    __m256d next = _mm256_loadu_pd(equity + i + 1);
+    return _mm256_div_pd(_mm256_sub_pd(next, prev), prev);
+}
+#endif
+
+inline double return_at(const double* equity, size_t i) {
+    return (equity[i + 1] - equity[i]) / equity[i];
+}
+
+// Two-pass moments over the n - 1 returns of an equity array
+ReturnMoments batch_moments(const double* equity, size_t n) {
+    ReturnMoments m;
+    if (n < 2) return m;
+    const size_t count = n - 1;
+
+    double sum = 0.0;
+    double downside_sum = 0.0;
+    uint64_t downside_count = 0;
+    size_t i = 0;
+#if defined(__AVX2__)
+    {
+        const __m256d zero = _mm256_setzero_pd();
+        const __m256d one = _mm256_set1_pd(1.0);
+        __m256d acc = zero, acc_down = zero, acc_down_n = zero;
+        for (; i + 4 <= count; i += 4) {
+            __m256d r = returns_at(equity, i);
+            __m256d negative = _mm256_cmp_pd(r, zero, _CMP_LT_OQ);
+            acc = _mm256_add_pd(acc, r);
+            acc_down = _mm256_add_pd(acc_down, _mm256_and_pd(negative, r));
+            acc_down_n = _mm256_add_pd(acc_down_n, _mm256_and_pd(negative, one));
+        }
+        sum = horizontal_sum(acc);
+        downside_sum = horizontal_sum(acc_down);
+        downside_count = static_cast<uint64_t>(horizontal_sum(acc_down_n));
+    }
+#endif
+    for (; i < count; ++i) {
+        double r = return_at(equity, i);
+        sum += r;
+        if (r < 0.0) {
+            downside_sum += r;
+            ++downside_count;
+        }
+    }
+
+    m.count = count;
+    m.mean = sum / static_cast<double>(count);
+    m.downside_count = downside_count;
+    m.downside_mean = downside_count ? downside_sum / static_cast<double>(downside_count) : 0.0;
+
+    double m2 = 0.0;
+    double downside_m2 = 0.0;
+    i = 0;
+#if defined(__AVX2__)
+    {
+        const __m256d zero = _mm256_setzero_pd();
+        const __m256d mean = _mm256_set1_pd(m.mean);
+        const __m256d downside_mean = _mm256_set1_pd(m.downside_mean);
+        __m256d acc = zero, acc_down = zero;
+        for (; i + 4 <= count; i += 4) {
+            __m256d r = returns_at(equity, i);
+            __m256d negative = _mm256_cmp_pd(r, zero, _CMP_LT_OQ);
+            __m256d d = _mm256_sub_pd(r, mean);
+            __m256d dd = _mm256_and_pd(negative, _mm256_sub_pd(r, downside_mean));
+            acc = _mm256_add_pd(acc, _mm256_mul_pd(d, d));
+            acc_down = _mm256_add_pd(acc_down, _mm256_mul_pd(dd, dd));
+        }
+        m2 = horizontal_sum(acc);
+        downside_m2 = horizontal_sum(acc_down);
+    }
+#endif
+    for (; i < count; ++i) {
+        double r = return_at(equity, i);
+        double d = r - m.mean;
+        m2 += d * d;
+        if (r < 0.0) {
+            double dd = r - m.downside_mean;
+            downside_m2 += dd * dd;
+        }
+    }
+    m.m2 = m2;
+    m.downside_m2 = downside_m2;
+    return m;
+}
+
+} // namespace
+
+void PerformanceTracker::update(double equity) {
+    if (points_ == 0) {
+        first_equity_ = equity;
+        peak_ = equity;
+    } else {
+        // Welford update of the return moments
+        double r = (equity - last_equity_) / last_equity_;
+        ++returns_;
+        double delta = r - mean_;
+        mean_ += delta / static_cast<double>(returns_);
+        m2_ += delta * (r - mean_);
+        if (r < 0.0) {
+            ++downside_;
+            double down_delta = r - downside_mean_;
+            downside_mean_ += down_delta / static_cast<double>(downside_);
+            downside_m2_ += down_delta * (r - downside_mean_);
+        }
+    }
+
+    if (equity > peak_) {
+        peak_ = equity;
+        peak_index_ = points_;
+    }
+    double drawdown = (peak_ > 0.0) ? (peak_ - equity) / peak_ : 0.0;
+    if (drawdown > max_drawdown_) {
+        max_drawdown_ = drawdown;
+        max_drawdown_peak_ = peak_index_;
+        max_drawdown_trough_ = points_;
+    }
+
+    last_equity_ = equity;
+    ++points_;
+}
+
+void PerformanceTracker::on_trade(double pnl) {
+    ++trades_;
+    if (pnl > 0.0) {
+        ++wins_;
+        win_sum_ += pnl;
+    } else if (pnl < 0.0) {
+        ++losses_;
+        loss_sum_ += pnl;
+    }
+}
+
+PerformanceSummary PerformanceTracker::summary(double risk_free_rate, double periods_per_year) const {
+    PerformanceSummary s;
+    s.points = points_;
+    if (points_ > 0) {
+        fill_totals(s, first_equity_, last_equity_, periods_per_year);
+    }
+
+    ReturnMoments m;
+    m.count = returns_;
+    m.mean = mean_;
+    m.m2 = m2_;
+    m.downside_count = downside_;
+    m.downside_mean = downside_mean_;
+    m.downside_m2 = downside_m2_;
+    fill_ratios(s, m, risk_free_rate, periods_per_year);
+
+    s.max_drawdown = max_drawdown_;
+    s.max_drawdown_peak = max_drawdown_peak_;
+    s.max_drawdown_trough = max_drawdown_trough_;
+
+    s.total_trades = trades_;
+    if (trades_ > 0) {
+        s.win_rate = static_cast<double>(wins_) / static_cast<double>(trades_);
+    }
+    s.avg_win = wins_ ? win_sum_ / static_cast<double>(wins_) : 0.0;
+    s.avg_loss = losses_ ? loss_sum_ / static_cast<double>(losses_) : 0.0;
+    s.profit_factor = (s.avg_loss != 0.0) ? std::abs(s.avg_win / s.avg_loss)
+                                          : std::numeric_limits<double>::infinity();
+    return s;
+}
+
+PerformanceSummary compute_performance(const double* equity, size_t n,
+                                       double risk_free_rate, double periods_per_year) {
+    PerformanceSummary s;
+    s.points = n;
+    if (n == 0) return s;
+
+    fill_totals(s, equity[0], equity[n - 1], periods_per_year);
+    fill_ratios(s, batch_moments(equity, n), risk_free_rate, periods_per_year);
+
+    // Running peak is a sequential scan
+    double peak = equity[0];
+    uint64_t peak_index = 0;
+    for (size_t i = 0; i < n; ++i) {
+        if (equity[i] > peak) {
+            peak = equity[i];
+            peak_index = i;
+        }
+        double drawdown = (peak > 0.0) ? (peak - equity[i]) / peak : 0.0;
+        if (drawdown > s.max_drawdown) {
+            s.max_drawdown = drawdown;
+            s.max_drawdown_peak = peak_index;
+            s.max_drawdown_trough = i;
+        }
+    }
+    return s;
+}
+
+} // namespace felix
@@ -1,6 +1,15 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 #include <pybind11/functional.h>
+#include <pybind11/numpy.h>
+
+// Sub-interpreters with their own GIL need pybind11 3.0 on Python 3.12+
+#if defined(PYBIND11_HAS_SUBINTERPRETER_SUPPORT) && PYBIND11_VERSION_HEX >= 0x03000000
+#define FELIX_SUBINTERPRETERS 1
+#include <pybind11/subinterpreter.h>
+#else
+#define FELIX_SUBINTERPRETERS 0
+#endif
 
 #include "felix/tick_record.hpp"
 #include "felix/execution.hpp"
@@ -8,7 +17,26 @@
 #include "felix/matching.hpp"
 #include "felix/risk.hpp"
 #include "felix/datastream.hpp"
+#include "felix/downsample.hpp"
 #include "felix/event_loop.hpp"
+#include "felix/indicators.hpp"
+#include "felix/journal.hpp"
+#include "felix/monte_carlo.hpp"
+#include "felix/native_strategy.hpp"
+#include "felix/parallel.hpp"
+#include "felix/random.hpp"
+#include "felix/results_file.hpp"
+#include "felix/tick_window.hpp"
+#include "felix/walk_forward.hpp"
+#include "felix/signal_strategy.hpp"
+#include "felix/performance.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
 
 namespace py = pybind11;
 
@@ -16,61 +44,468 @@ namespace felix {
 
 /**
  * Python Strategy Wrapper - Section 7
- * Bridges Python strategy class to C++ StrategyWrapper interface
+ * Bridges Python strategy class to C++ StrategyWrapper interface.
+ * Callbacks are looked up once. By default each callback takes the GIL
+ * (the loop runs with it released); with acquire_gil = false the caller
+ * holds it for the whole run, as a sub-interpreter worker does.
  */
 class PyStrategyWrapper : public StrategyWrapper {
 public:
-    PyStrategyWrapper(py::object strategy, MatchingEngine* engine, Portfolio* portfolio) 
-        : py_strategy_(strategy), engine_(engine), portfolio_(portfolio) {}
-    
-    void on_start() override {
-        py::gil_scoped_acquire acquire;
-        if (py::hasattr(py_strategy_, "on_start")) {
-            py_strategy_.attr("on_start")();
-        }
-    }
-    
-    void on_tick(const TickRecord& tick) override {
-        py::gil_scoped_acquire acquire;
-        if (py::hasattr(py_strategy_, "on_tick")) {
-            py_strategy_.attr("on_tick")(tick);
-        }
-    }
-    
-    void on_bar(const TickRecord& bar) override {
-        py::gil_scoped_acquire acquire;
-        if (py::hasattr(py_strategy_, "on_bar")) {
-            py_strategy_.attr("on_bar")(bar);
-        }
-    }
+    PyStrategyWrapper(py::object strategy, MatchingEngine* engine, Portfolio* portfolio,
+                      bool acquire_gil = true)
+        : py_strategy_(strategy), engine_(engine), portfolio_(portfolio), acquire_gil_(acquire_gil)
+        , on_start_(py::getattr(strategy, "on_start", py::none()))
+        , on_tick_(py::getattr(strategy, "on_tick", py::none()))
+        , on_bar_(py::getattr(strategy, "on_bar", py::none()))
+        , on_fill_(py::getattr(strategy, "on_fill", py::none()))
+        , on_end_(py::getattr(strategy, "on_end", py::none())) {}
     
-    void on_fill(const Fill& fill) override {
-        py::gil_scoped_acquire acquire;
-        if (py::hasattr(py_strategy_, "on_fill")) {
-            py_strategy_.attr("on_fill")(fill);
-        }
-    }
-    
-    void on_end() override {
-        py::gil_scoped_acquire acquire;
-        if (py::hasattr(py_strategy_, "on_end")) {
-            py_strategy_.attr("on_end")();
-        }
-    }
+    void on_start() override { call(on_start_); }
+    void on_tick(const TickRecord& tick) override { call(on_tick_, tick); }
+    void on_bar(const TickRecord& bar) override { call(on_bar_, bar); }
+    void on_fill(const Fill& fill) override { call(on_fill_, fill); }
+    void on_end() override { call(on_end_); }
     
     MatchingEngine* get_engine() { return engine_; }
     Portfolio* get_portfolio() { return portfolio_; }
 
 private:
+    template <typename... Args>
+    void call(const py::object& callback, const Args&... args) {
+        if (callback.is_none()) return;
+        std::optional<py::gil_scoped_acquire> acquire;
+        if (acquire_gil_) acquire.emplace();
+        callback(args...);
+    }
+
     py::object py_strategy_;
     MatchingEngine* engine_;
     Portfolio* portfolio_;
+    bool acquire_gil_;
+    py::object on_start_, on_tick_, on_bar_, on_fill_, on_end_;
+};
+
+/**
+ * NumPy export - Section 7
+ * Wraps an engine-owned snapshot as a read-only structured array without
+ * copying; the capsule base keeps the snapshot alive as long as the array.
+ */
+struct FieldSpec {
+    const char* name;
+    py::dtype dtype;
+    size_t offset;
+};
+
+py::dtype record_dtype(std::initializer_list<FieldSpec> fields, size_t itemsize) {
+    py::list names, formats, offsets;
+    for (const auto& field : fields) {
+        names.append(field.name);
+        formats.append(field.dtype);
+        offsets.append(field.offset);
+    }
+    py::dict spec;
+    spec["names"] = names;
+    spec["formats"] = formats;
+    spec["offsets"] = offsets;
+    spec["itemsize"] = itemsize;
+    return py::dtype::from_args(spec);
+}
+
+template <typename T>
+py::dtype field_dtype() {
+    if constexpr (std::is_enum_v<T>) {
+        return py::dtype::of<std::underlying_type_t<T>>();
+    } else {
+        return py::dtype::of<T>();
+    }
+}
+
+#define FELIX_FIELD(Type, member) \
+    FieldSpec{#member, field_dtype<decltype(Type::member)>(), offsetof(Type, member)}
+
+py::dtype equity_point_dtype() {
+    return record_dtype({
+        FELIX_FIELD(EquityPoint, timestamp),
+        FELIX_FIELD(EquityPoint, equity),
+        FELIX_FIELD(EquityPoint, cash),
+        FELIX_FIELD(EquityPoint, unrealized_pnl),
+    }, sizeof(EquityPoint));
+}
+
+py::dtype equity_level_dtype() {
+    return record_dtype({
+        FELIX_FIELD(EquityLevelPoint, index),
+        FELIX_FIELD(EquityLevelPoint, timestamp),
+        FELIX_FIELD(EquityLevelPoint, equity),
+        FELIX_FIELD(EquityLevelPoint, drawdown),
+    }, sizeof(EquityLevelPoint));
+}
+
+py::dtype fill_dtype() {
+    return record_dtype({
+        FELIX_FIELD(Fill, order_id),
+        FELIX_FIELD(Fill, symbol_id),
+        FELIX_FIELD(Fill, side),
+        FELIX_FIELD(Fill, price),
+        FELIX_FIELD(Fill, volume),
+        FELIX_FIELD(Fill, timestamp),
+        FELIX_FIELD(Fill, slippage),
+        FELIX_FIELD(Fill, strategy_id),
+    }, sizeof(Fill));
+}
+
+py::dtype order_dtype() {
+    return record_dtype({
+        FELIX_FIELD(Order, order_id),
+        FELIX_FIELD(Order, symbol_id),
+        FELIX_FIELD(Order, side),
+        FELIX_FIELD(Order, order_type),
+        FELIX_FIELD(Order, price),
+        FELIX_FIELD(Order, size),
+        FELIX_FIELD(Order, timestamp),
+        FELIX_FIELD(Order, activation_time),
+        FELIX_FIELD(Order, status),
+        FELIX_FIELD(Order, filled_size),
+        FELIX_FIELD(Order, fill_count),
+        FELIX_FIELD(Order, stop_price),
+        FELIX_FIELD(Order, trail_offset),
+        FELIX_FIELD(Order, parent_id),
+        FELIX_FIELD(Order, oco_group),
+        FELIX_FIELD(Order, strategy_id),
+    }, sizeof(Order));
+}
+
+py::dtype trade_dtype() {
+    return record_dtype({
+        FELIX_FIELD(Trade, entry_order_id),
+        FELIX_FIELD(Trade, exit_order_id),
+        FELIX_FIELD(Trade, entry_time),
+        FELIX_FIELD(Trade, exit_time),
+        FELIX_FIELD(Trade, holding_ns),
+        FELIX_FIELD(Trade, symbol_id),
+        FELIX_FIELD(Trade, side),
+        FELIX_FIELD(Trade, quantity),
+        FELIX_FIELD(Trade, entry_price),
+        FELIX_FIELD(Trade, exit_price),
+        FELIX_FIELD(Trade, pnl),
+        FELIX_FIELD(Trade, return_pct),
+    }, sizeof(Trade));
+}
+
+py::dtype journal_record_dtype() {
+    return record_dtype({
+        FELIX_FIELD(JournalRecord, timestamp),
+        FELIX_FIELD(JournalRecord, id),
+        FELIX_FIELD(JournalRecord, aux),
+        FELIX_FIELD(JournalRecord, a),
+        FELIX_FIELD(JournalRecord, b),
+        FELIX_FIELD(JournalRecord, symbol_id),
+        FELIX_FIELD(JournalRecord, event),
+        FELIX_FIELD(JournalRecord, side),
+        FELIX_FIELD(JournalRecord, kind),
+        FELIX_FIELD(JournalRecord, flags),
+    }, sizeof(JournalRecord));
+}
+
+py::dtype tick_dtype() {
+    return record_dtype({
+        FELIX_FIELD(TickRecord, timestamp),
+        FELIX_FIELD(TickRecord, symbol_id),
+        FELIX_FIELD(TickRecord, price),
+        FELIX_FIELD(TickRecord, bid),
+        FELIX_FIELD(TickRecord, ask),
+        FELIX_FIELD(TickRecord, bid_size),
+        FELIX_FIELD(TickRecord, ask_size),
+        FELIX_FIELD(TickRecord, volume),
+    }, sizeof(TickRecord));
+}
+
+py::dtype window_bar_dtype() {
+    return record_dtype({
+        FELIX_FIELD(WindowBar, timestamp),
+        FELIX_FIELD(WindowBar, symbol_id),
+        FELIX_FIELD(WindowBar, ticks),
+        FELIX_FIELD(WindowBar, open),
+        FELIX_FIELD(WindowBar, high),
+        FELIX_FIELD(WindowBar, low),
+        FELIX_FIELD(WindowBar, close),
+        FELIX_FIELD(WindowBar, volume),
+    }, sizeof(WindowBar));
+}
+
+py::dtype submit_result_dtype() {
+    return record_dtype({
+        FELIX_FIELD(SubmitResult, order_id),
+        FELIX_FIELD(SubmitResult, reject),
+    }, sizeof(SubmitResult));
+}
+
+#undef FELIX_FIELD
+
+template <typename T>
+py::array snapshot_array(std::shared_ptr<const std::vector<T>> data, const py::dtype& dtype) {
+    const std::vector<T>& items = *data;
+    auto* holder = new std::shared_ptr<const std::vector<T>>(std::move(data));
+    py::capsule base(holder, [](void* p) {
+        delete static_cast<std::shared_ptr<const std::vector<T>>*>(p);
+    });
+    py::array array(dtype,
+                    std::vector<py::ssize_t>{static_cast<py::ssize_t>(items.size())},
+                    std::vector<py::ssize_t>{static_cast<py::ssize_t>(sizeof(T))},
+                    items.data(), base);
+    array.attr("setflags")(false);
+    return array;
+}
+
+/**
+ * Read-only view of engine memory that may change on the next tick
+ * (Section 7). The base object keeps the owner alive, not the contents.
+ */
+template <typename T>
+py::array borrowed_array(py::object owner, const T* data, size_t count, const py::dtype& dtype) {
+    py::array array(dtype,
+                    std::vector<py::ssize_t>{static_cast<py::ssize_t>(count)},
+                    std::vector<py::ssize_t>{static_cast<py::ssize_t>(sizeof(T))},
+                    data, owner);
+    array.attr("setflags")(false);
+    return array;
+}
+
+// Engine values as a NumPy array of T (results file columns, index lists)
+template <typename T, typename V>
+py::array_t<T> column_array(const std::vector<V>& values) {
+    py::array_t<T> array(static_cast<py::ssize_t>(values.size()));
+    T* out = array.mutable_data();
+    for (size_t i = 0; i < values.size(); ++i) {
+        out[i] = static_cast<T>(values[i]);
+    }
+    return array;
+}
+
+/**
+ * Orders from a structured array (Section 7)
+ * symbol_id, side and size are required; order_type, price, timestamp,
+ * stop_price, trail_offset and trail_percent default to zero / MARKET.
+ */
+std::vector<Order> orders_from_array(const py::array& array) {
+    py::object names = array.dtype().attr("names");
+    if (names.is_none()) {
+        throw std::invalid_argument("submit_orders expects a structured array");
+    }
+    py::tuple fields = names.cast<py::tuple>();
+    auto has = [&](const char* name) {
+        for (auto field : fields) {
+            if (field.cast<std::string>() == name) return true;
+        }
+        return false;
+    };
+    for (const char* required : {"symbol_id", "side", "size"}) {
+        if (!has(required)) {
+            throw std::invalid_argument(std::string("submit_orders: missing field '") + required + "'");
+        }
+    }
+
+    // One contiguous, converted column per field (empty when absent)
+    auto column = [&](const char* name, auto zero) {
+        using Column = py::array_t<decltype(zero), py::array::c_style | py::array::forcecast>;
+        return has(name) ? Column(py::object(array[name])) : Column(0);
+    };
+    auto symbol = column("symbol_id", uint32_t{});
+    auto side = column("side", int64_t{});
+    auto size = column("size", double{});
+    auto type = column("order_type", int64_t{});
+    auto price = column("price", double{});
+    auto timestamp = column("timestamp", uint64_t{});
+    auto stop = column("stop_price", double{});
+    auto trail = column("trail_offset", double{});
+    auto percent = column("trail_percent", bool{});
+
+    const size_t n = static_cast<size_t>(array.size());
+    std::vector<Order> orders(n);
+    for (size_t i = 0; i < n; ++i) {
+        Order& order = orders[i];
+        order.symbol_id = symbol.data()[i];
+        const int64_t side_value = side.data()[i];
+        if (side_value < static_cast<int64_t>(Side::BUY) || side_value > static_cast<int64_t>(Side::SELL)) {
+            throw std::invalid_argument("submit_orders: invalid side " + std::to_string(side_value) +
+                                        " at row " + std::to_string(i));
+        }
+        order.side = static_cast<Side>(side_value);
+        order.size = size.data()[i];
+        if (type.size()) {
+            const int64_t type_value = type.data()[i];
+            if (type_value < static_cast<int64_t>(OrderType::MARKET) ||
+                type_value > static_cast<int64_t>(OrderType::TRAILING_STOP)) {
+                throw std::invalid_argument("submit_orders: invalid order_type " + std::to_string(type_value) +
+                                            " at row " + std::to_string(i));
+            }
+            order.order_type = static_cast<OrderType>(type_value);
+        }
+        if (price.size()) order.price = price.data()[i];
+        if (timestamp.size()) order.timestamp = timestamp.data()[i];
+        if (stop.size()) order.stop_price = stop.data()[i];
+        if (trail.size()) order.trail_offset = trail.data()[i];
+        if (percent.size()) order.trail_percent = percent.data()[i];
+    }
+    return orders;
+}
+
+py::array submit_results_array(std::vector<SubmitResult> results) {
+    auto data = std::make_shared<std::vector<SubmitResult>>(std::move(results));
+    return snapshot_array<SubmitResult>(std::move(data), submit_result_dtype());
+}
+
+/**
+ * Python Strategy Jobs - Section 7
+ * One independent Python-strategy backtest of a sweep. The strategy is
+ * named by import path ("module:Class") and built as
+ * Class(engine, portfolio, **params) inside the run's own thread or
+ * sub-interpreter, so no Python object is shared between runs; only the
+ * loaded ticks are (each run reads its own DataStream view).
+ */
+struct StrategyJob {
+    std::string strategy;
+    std::string params;                    // JSON object of keyword arguments ("" = none)
+    SignalBacktestConfig backtest;         // mode and min_trade_size are unused
+    bool keep_curve = false;
+};
+
+struct StrategyJobResult {
+    PerformanceSummary summary;
+    uint64_t orders = 0;                   // Submitted, including rejected
+    uint64_t fills = 0;
+    std::shared_ptr<const std::vector<EquityPoint>> curve;   // Only with keep_curve
+    std::string error;                     // Python exception text, empty on success
 };
 
+/**
+ * Strategy Isolation - Section 7
+ * THREAD: runs share the calling interpreter; Python callbacks run in
+ * parallel only on a free-threaded (3.13t) build. SUBINTERPRETER: every
+ * run gets a fresh interpreter with its own GIL, so callbacks run in
+ * parallel on any build (needs pybind11 3.0, Python 3.12+).
+ */
+enum class StrategyIsolation : uint8_t {
+    THREAD,
+    SUBINTERPRETER
+};
+
+// Runs one job in the current interpreter. With hold_gil the caller holds
+// its GIL throughout; otherwise the GIL is taken only for Python work.
+// sys_path, when given, replaces sys.path first (fresh sub-interpreters).
+StrategyJobResult run_strategy_job(const DataStream& stream, const StrategyJob& job, bool hold_gil,
+                                   const std::vector<std::string>* sys_path = nullptr) {
+    DataStream window = stream.view(0, stream.size());   // Own cursor
+    const SignalBacktestConfig& config = job.backtest;
+
+    MatchingEngine engine(config.slippage);
+    engine.set_latency_config(config.latency);
+    engine.set_verbose(false);
+
+    Portfolio portfolio(config.initial_capital);
+    EquityRecordingConfig recording = config.recording;
+    recording.spill_path.clear();   // Concurrent runs must not share a spill file
+    portfolio.set_equity_recording_config(recording);
+
+    RiskEngine risk(config.risk_limits);
+    risk.set_verbose(false);
+    EventLoop loop;
+    loop.set_verbose(false);
+    loop.set_matching_engine(&engine);
+    loop.set_portfolio(&portfolio);
+    if (config.use_risk) loop.set_risk_engine(&risk);
+
+    StrategyJobResult result;
+    std::optional<py::gil_scoped_acquire> acquire;
+    if (!hold_gil) acquire.emplace();
+    try {
+        if (sys_path) py::module_::import("sys").attr("path") = py::cast(*sys_path);
+        py::module_::import("felix_engine");   // Registers the engine types in this interpreter
+
+        const size_t colon = job.strategy.find(':');
+        if (colon == std::string::npos) {
+            throw std::invalid_argument("strategy must be 'module:Class', got '" + job.strategy + "'");
+        }
+        py::object cls = py::module_::import(job.strategy.substr(0, colon).c_str())
+                             .attr(job.strategy.substr(colon + 1).c_str());
+        py::dict kwargs = job.params.empty()
+                              ? py::dict()
+                              : py::dict(py::module_::import("json").attr("loads")(job.params));
+        py::object instance = cls(py::cast(&engine, py::return_value_policy::reference),
+                                  py::cast(&portfolio, py::return_value_policy::reference), **kwargs);
+
+        PyStrategyWrapper wrapper(instance, &engine, &portfolio, !hold_gil);
+        if (hold_gil) {
+            loop.run(window, wrapper);
+        } else {
+            py::gil_scoped_release release;
+            loop.run(window, wrapper);
+        }
+    } catch (const std::exception& e) {
+        result.error = e.what();
+        return result;
+    }
+
+    result.summary = portfolio.performance_summary(config.risk_free_rate, config.periods_per_year);
+    result.orders = engine.order_history().size() + engine.pending_order_count();
+    result.fills = loop.fills_generated();
+    if (job.keep_curve) result.curve = portfolio.equity_snapshot();
+    return result;
+}
+
+// Called with the GIL held; returns results in job order
+std::vector<StrategyJobResult> run_strategy_jobs(const DataStream& stream,
+                                                 const std::vector<StrategyJob>& jobs,
+                                                 unsigned threads, StrategyIsolation isolation) {
+    std::vector<StrategyJobResult> results(jobs.size());
+    if (isolation == StrategyIsolation::THREAD) {
+        py::gil_scoped_release release;
+        parallel_for(jobs.size(), threads, [&](size_t i) {
+            results[i] = run_strategy_job(stream, jobs[i], false);
+        });
+        return results;
+    }
+
+#if FELIX_SUBINTERPRETERS
+    // Interpreters are created and destroyed here under the calling GIL,
+    // one wave of `threads` at a time; the runs in between share no lock
+    const auto sys_path = py::module_::import("sys").attr("path").cast<std::vector<std::string>>();
+    const size_t wave = std::min<size_t>(resolve_threads(threads), std::max<size_t>(jobs.size(), 1));
+    for (size_t begin = 0; begin < jobs.size(); begin += wave) {
+        const size_t count = std::min(wave, jobs.size() - begin);
+        std::vector<py::subinterpreter> interpreters;
+        for (size_t i = 0; i < count; ++i) {
+            interpreters.push_back(py::subinterpreter::create());
+        }
+        py::gil_scoped_release release;
+        parallel_for(count, static_cast<unsigned>(count), [&](size_t i) {
+            py::subinterpreter_scoped_activate active(interpreters[i]);
+            results[begin + i] = run_strategy_job(stream, jobs[begin + i], true, &sys_path);
+        });
+    }
+#endif
+    return results;
+}
+
 } // namespace felix
 
+// The module keeps no global Python state: it runs without the GIL on
+// free-threaded builds and loads into sub-interpreters with their own GIL
+#if FELIX_SUBINTERPRETERS
+PYBIND11_MODULE(felix_engine, m, py::mod_gil_not_used(),
+                py::multiple_interpreters::per_interpreter_gil()) {
+#elif PYBIND11_VERSION_HEX >= 0x020D0000
+PYBIND11_MODULE(felix_engine, m, py::mod_gil_not_used()) {
+#else
 PYBIND11_MODULE(felix_engine, m) {
+#endif
     m.doc() = "Felix Backtesting Engine - C++ Core (design.txt compliant)";
+#ifdef Py_GIL_DISABLED
+    m.attr("FREE_THREADED") = true;
+#else
+    m.attr("FREE_THREADED") = false;
+#endif
+    m.attr("SUBINTERPRETERS") = bool(FELIX_SUBINTERPRETERS);
 
     // ========== ENUMS ==========
     py::enum_<felix::Side>(m, "Side")
@@ -81,7 +516,8 @@ PYBIND11_MODULE(felix_engine, m) {
         .value("MARKET", felix::OrderType::MARKET)
         .value("LIMIT", felix::OrderType::LIMIT)
         .value("STOP", felix::OrderType::STOP)
-        .value("STOP_LIMIT", felix::OrderType::STOP_LIMIT);
+        .value("STOP_LIMIT", felix::OrderType::STOP_LIMIT)
+        .value("TRAILING_STOP", felix::OrderType::TRAILING_STOP);
 
     py::enum_<felix::OrderStatus>(m, "OrderStatus")
         .value("PENDING", felix::OrderStatus::PENDING)
@@ -91,6 +527,69 @@ PYBIND11_MODULE(felix_engine, m) {
         .value("CANCELLED", felix::OrderStatus::CANCELLED)
         .value("REJECTED", felix::OrderStatus::REJECTED);
 
+    py::enum_<felix::LotMatching>(m, "LotMatching")
+        .value("AVERAGE_COST", felix::LotMatching::AVERAGE_COST)
+        .value("FIFO", felix::LotMatching::FIFO);
+
+    py::enum_<felix::EquitySampling>(m, "EquitySampling")
+        .value("EVERY_TICK", felix::EquitySampling::EVERY_TICK)
+        .value("EVERY_N_TICKS", felix::EquitySampling::EVERY_N_TICKS)
+        .value("INTERVAL", felix::EquitySampling::INTERVAL)
+        .value("ON_CHANGE", felix::EquitySampling::ON_CHANGE)
+        .value("ON_FILL", felix::EquitySampling::ON_FILL);
+
+    py::enum_<felix::SignalMode>(m, "SignalMode")
+        .value("TARGET_POSITION", felix::SignalMode::TARGET_POSITION)
+        .value("ORDER_QUANTITY", felix::SignalMode::ORDER_QUANTITY);
+
+    py::enum_<felix::CapitalMode>(m, "CapitalMode")
+        .value("SHARED", felix::CapitalMode::SHARED)
+        .value("ISOLATED", felix::CapitalMode::ISOLATED);
+
+    py::enum_<felix::StrategyIsolation>(m, "StrategyIsolation")
+        .value("THREAD", felix::StrategyIsolation::THREAD)
+        .value("SUBINTERPRETER", felix::StrategyIsolation::SUBINTERPRETER);
+
+    py::enum_<felix::IndicatorKind>(m, "IndicatorKind")
+        .value("SMA", felix::IndicatorKind::SMA)
+        .value("EMA", felix::IndicatorKind::EMA)
+        .value("WMA", felix::IndicatorKind::WMA)
+        .value("STDDEV", felix::IndicatorKind::STDDEV)
+        .value("BOLLINGER", felix::IndicatorKind::BOLLINGER)
+        .value("RSI", felix::IndicatorKind::RSI)
+        .value("ATR", felix::IndicatorKind::ATR)
+        .value("VWAP", felix::IndicatorKind::VWAP)
+        .value("MIN", felix::IndicatorKind::MIN)
+        .value("MAX", felix::IndicatorKind::MAX)
+        .value("ZSCORE", felix::IndicatorKind::ZSCORE);
+
+    py::enum_<felix::WalkForwardMetric>(m, "WalkForwardMetric")
+        .value("SHARPE", felix::WalkForwardMetric::SHARPE)
+        .value("SORTINO", felix::WalkForwardMetric::SORTINO)
+        .value("TOTAL_RETURN", felix::WalkForwardMetric::TOTAL_RETURN)
+        .value("CAGR", felix::WalkForwardMetric::CAGR)
+        .value("MAX_DRAWDOWN", felix::WalkForwardMetric::MAX_DRAWDOWN)
+        .value("PROFIT_FACTOR", felix::WalkForwardMetric::PROFIT_FACTOR);
+
+    py::enum_<felix::RiskRule>(m, "RiskRule")
+        .value("HALTED", felix::RiskRule::HALTED)
+        .value("ORDER_SIZE", felix::RiskRule::ORDER_SIZE)
+        .value("NOTIONAL", felix::RiskRule::NOTIONAL)
+        .value("CASH", felix::RiskRule::CASH)
+        .value("POSITION", felix::RiskRule::POSITION)
+        .value("DRAWDOWN", felix::RiskRule::DRAWDOWN)
+        .value("DAILY_LOSS", felix::RiskRule::DAILY_LOSS)
+        .value("NONE", felix::RiskRule::COUNT);
+
+    py::enum_<felix::JournalEvent>(m, "JournalEvent")
+        .value("RUN_START", felix::JournalEvent::RUN_START)
+        .value("ORDER_SUBMIT", felix::JournalEvent::ORDER_SUBMIT)
+        .value("ORDER_CLOSE", felix::JournalEvent::ORDER_CLOSE)
+        .value("FILL", felix::JournalEvent::FILL)
+        .value("RISK_HALT", felix::JournalEvent::RISK_HALT)
+        .value("STATE_HASH", felix::JournalEvent::STATE_HASH)
+        .value("RUN_END", felix::JournalEvent::RUN_END);
+
     // ========== DATA STRUCTURES ==========
     
     // TickRecord - Section 4.1
@@ -119,6 +618,7 @@ PYBIND11_MODULE(felix_engine, m) {
         .def_readwrite("volume", &felix::Fill::volume)
         .def_readwrite("timestamp", &felix::Fill::timestamp)
         .def_readwrite("slippage", &felix::Fill::slippage)
+        .def_readwrite("strategy_id", &felix::Fill::strategy_id)
         .def("__repr__", [](const felix::Fill& f) {
             return "<Fill order=" + std::to_string(f.order_id) + 
                    " price=" + std::to_string(f.price) + 
@@ -136,11 +636,33 @@ PYBIND11_MODULE(felix_engine, m) {
         .def_readwrite("size", &felix::Order::size)
         .def_readwrite("timestamp", &felix::Order::timestamp)
         .def_readwrite("status", &felix::Order::status)
+        .def_readwrite("filled_size", &felix::Order::filled_size)
+        .def_readonly("fill_count", &felix::Order::fill_count)
+        .def_readwrite("stop_price", &felix::Order::stop_price)
+        .def_readwrite("trail_offset", &felix::Order::trail_offset)
+        .def_readwrite("trail_percent", &felix::Order::trail_percent)
+        .def_readonly("trail_anchor", &felix::Order::trail_anchor)
+        .def_readonly("parent_id", &felix::Order::parent_id)
+        .def_readonly("oco_group", &felix::Order::oco_group)
+        .def_readwrite("strategy_id", &felix::Order::strategy_id)
+        .def("remaining", &felix::Order::remaining)
         .def("__repr__", [](const felix::Order& o) {
             return "<Order id=" + std::to_string(o.order_id) + 
                    " size=" + std::to_string(o.size) + ">";
         });
 
+    // BracketOrder - Section 6.4
+    py::class_<felix::BracketOrder>(m, "BracketOrder")
+        .def(py::init<>())
+        .def_readonly("entry_id", &felix::BracketOrder::entry_id)
+        .def_readonly("stop_loss_id", &felix::BracketOrder::stop_loss_id)
+        .def_readonly("take_profit_id", &felix::BracketOrder::take_profit_id)
+        .def("__repr__", [](const felix::BracketOrder& b) {
+            return "<BracketOrder entry=" + std::to_string(b.entry_id) +
+                   " sl=" + std::to_string(b.stop_loss_id) +
+                   " tp=" + std::to_string(b.take_profit_id) + ">";
+        });
+
     // Position - Section 4.2
     py::class_<felix::Position>(m, "Position")
         .def(py::init<>())
@@ -148,6 +670,34 @@ PYBIND11_MODULE(felix_engine, m) {
         .def_readonly("avg_price", &felix::Position::avg_price)
         .def_readonly("realized_pnl", &felix::Position::realized_pnl);
 
+    // BookExposure - Section 4.2
+    py::class_<felix::BookExposure>(m, "BookExposure")
+        .def(py::init<>())
+        .def_readonly("market_value", &felix::BookExposure::market_value)
+        .def_readonly("cost_basis", &felix::BookExposure::cost_basis)
+        .def_readonly("unrealized_pnl", &felix::BookExposure::unrealized_pnl)
+        .def_readonly("gross_exposure", &felix::BookExposure::gross_exposure)
+        .def_readonly("long_exposure", &felix::BookExposure::long_exposure)
+        .def_readonly("short_exposure", &felix::BookExposure::short_exposure)
+        .def_readonly("long_positions", &felix::BookExposure::long_positions)
+        .def_readonly("short_positions", &felix::BookExposure::short_positions);
+
+    // Trade - Section 4.2
+    py::class_<felix::Trade>(m, "Trade")
+        .def(py::init<>())
+        .def_readonly("entry_order_id", &felix::Trade::entry_order_id)
+        .def_readonly("exit_order_id", &felix::Trade::exit_order_id)
+        .def_readonly("entry_time", &felix::Trade::entry_time)
+        .def_readonly("exit_time", &felix::Trade::exit_time)
+        .def_readonly("holding_ns", &felix::Trade::holding_ns)
+        .def_readonly("symbol_id", &felix::Trade::symbol_id)
+        .def_readonly("side", &felix::Trade::side)
+        .def_readonly("quantity", &felix::Trade::quantity)
+        .def_readonly("entry_price", &felix::Trade::entry_price)
+        .def_readonly("exit_price", &felix::Trade::exit_price)
+        .def_readonly("pnl", &felix::Trade::pnl)
+        .def_readonly("return_pct", &felix::Trade::return_pct);
+
     // EquityPoint - Section 4.2
     py::class_<felix::EquityPoint>(m, "EquityPoint")
         .def(py::init<>())
@@ -156,6 +706,27 @@ PYBIND11_MODULE(felix_engine, m) {
         .def_readonly("cash", &felix::EquityPoint::cash)
         .def_readonly("unrealized_pnl", &felix::EquityPoint::unrealized_pnl);
 
+    // PerformanceSummary - Section 8.4
+    py::class_<felix::PerformanceSummary>(m, "PerformanceSummary")
+        .def(py::init<>())
+        .def_readonly("points", &felix::PerformanceSummary::points)
+        .def_readonly("initial_equity", &felix::PerformanceSummary::initial_equity)
+        .def_readonly("final_equity", &felix::PerformanceSummary::final_equity)
+        .def_readonly("total_return_pct", &felix::PerformanceSummary::total_return_pct)
+        .def_readonly("mean_return", &felix::PerformanceSummary::mean_return)
+        .def_readonly("volatility", &felix::PerformanceSummary::volatility)
+        .def_readonly("sharpe_ratio", &felix::PerformanceSummary::sharpe_ratio)
+        .def_readonly("sortino_ratio", &felix::PerformanceSummary::sortino_ratio)
+        .def_readonly("max_drawdown", &felix::PerformanceSummary::max_drawdown)
+        .def_readonly("max_drawdown_peak", &felix::PerformanceSummary::max_drawdown_peak)
+        .def_readonly("max_drawdown_trough", &felix::PerformanceSummary::max_drawdown_trough)
+        .def_readonly("cagr", &felix::PerformanceSummary::cagr)
+        .def_readonly("total_trades", &felix::PerformanceSummary::total_trades)
+        .def_readonly("win_rate", &felix::PerformanceSummary::win_rate)
+        .def_readonly("avg_win", &felix::PerformanceSummary::avg_win)
+        .def_readonly("avg_loss", &felix::PerformanceSummary::avg_loss)
+        .def_readonly("profit_factor", &felix::PerformanceSummary::profit_factor);
+
     // ========== CONFIGURATION ==========
     
     // SlippageConfig - Section 8.3
@@ -165,7 +736,17 @@ PYBIND11_MODULE(felix_engine, m) {
         .def_readwrite("volatility_mult", &felix::SlippageConfig::volatility_mult)
         .def_readwrite("size_impact", &felix::SlippageConfig::size_impact)
         .def_readwrite("use_stochastic", &felix::SlippageConfig::use_stochastic)
-        .def_readwrite("stochastic_std", &felix::SlippageConfig::stochastic_std);
+        .def_readwrite("stochastic_std", &felix::SlippageConfig::stochastic_std)
+        .def_readwrite("seed", &felix::SlippageConfig::seed)
+        .def_readwrite("vol_decay", &felix::SlippageConfig::vol_decay)
+        .def_readwrite("adv_window_days", &felix::SlippageConfig::adv_window_days);
+
+    // LiquidityConfig - Section 6.2
+    py::class_<felix::LiquidityConfig>(m, "LiquidityConfig")
+        .def(py::init<>())
+        .def_readwrite("cap_to_displayed", &felix::LiquidityConfig::cap_to_displayed)
+        .def_readwrite("sweep_levels", &felix::LiquidityConfig::sweep_levels)
+        .def_readwrite("level_spacing_bps", &felix::LiquidityConfig::level_spacing_bps);
 
     // LatencyConfig - Section 8.1
     py::class_<felix::LatencyConfig>(m, "LatencyConfig")
@@ -180,7 +761,70 @@ PYBIND11_MODULE(felix_engine, m) {
         .def_readwrite("max_position_size", &felix::RiskLimits::max_position_size)
         .def_readwrite("max_order_size", &felix::RiskLimits::max_order_size)
         .def_readwrite("max_notional", &felix::RiskLimits::max_notional)
-        .def_readwrite("max_daily_loss", &felix::RiskLimits::max_daily_loss);
+        .def_readwrite("max_daily_loss", &felix::RiskLimits::max_daily_loss)
+        .def_readwrite("day_offset_ns", &felix::RiskLimits::day_offset_ns);
+
+    // EquityRecordingConfig - Section 8.4
+    py::class_<felix::EquityRecordingConfig>(m, "EquityRecordingConfig")
+        .def(py::init<>())
+        .def_readwrite("sampling", &felix::EquityRecordingConfig::sampling)
+        .def_readwrite("every_n_ticks", &felix::EquityRecordingConfig::every_n_ticks)
+        .def_readwrite("interval_ns", &felix::EquityRecordingConfig::interval_ns)
+        .def_readwrite("min_change", &felix::EquityRecordingConfig::min_change)
+        .def_readwrite("block_size", &felix::EquityRecordingConfig::block_size)
+        .def_readwrite("spill_path", &felix::EquityRecordingConfig::spill_path);
+
+    // SignalBacktestConfig - Section 8.4
+    py::class_<felix::SignalBacktestConfig>(m, "SignalBacktestConfig")
+        .def(py::init<>())
+        .def_readwrite("initial_capital", &felix::SignalBacktestConfig::initial_capital)
+        .def_readwrite("slippage", &felix::SignalBacktestConfig::slippage)
+        .def_readwrite("latency", &felix::SignalBacktestConfig::latency)
+        .def_readwrite("use_risk", &felix::SignalBacktestConfig::use_risk)
+        .def_readwrite("risk_limits", &felix::SignalBacktestConfig::risk_limits)
+        .def_readwrite("recording", &felix::SignalBacktestConfig::recording)
+        .def_readwrite("mode", &felix::SignalBacktestConfig::mode)
+        .def_readwrite("min_trade_size", &felix::SignalBacktestConfig::min_trade_size)
+        .def_readwrite("risk_free_rate", &felix::SignalBacktestConfig::risk_free_rate)
+        .def_readwrite("periods_per_year", &felix::SignalBacktestConfig::periods_per_year);
+
+    // WalkForwardConfig - Section 8.4
+    py::class_<felix::WalkForwardConfig>(m, "WalkForwardConfig")
+        .def(py::init<>())
+        .def_readwrite("in_sample_ns", &felix::WalkForwardConfig::in_sample_ns)
+        .def_readwrite("out_of_sample_ns", &felix::WalkForwardConfig::out_of_sample_ns)
+        .def_readwrite("anchored", &felix::WalkForwardConfig::anchored)
+        .def_readwrite("metric", &felix::WalkForwardConfig::metric)
+        .def_readwrite("threads", &felix::WalkForwardConfig::threads)
+        .def_readwrite("verbose", &felix::WalkForwardConfig::verbose)
+        .def_readwrite("initial_capital", &felix::WalkForwardConfig::initial_capital)
+        .def_readwrite("slippage", &felix::WalkForwardConfig::slippage)
+        .def_readwrite("latency", &felix::WalkForwardConfig::latency)
+        .def_readwrite("use_risk", &felix::WalkForwardConfig::use_risk)
+        .def_readwrite("risk_limits", &felix::WalkForwardConfig::risk_limits)
+        .def_readwrite("recording", &felix::WalkForwardConfig::recording)
+        .def_readwrite("mode", &felix::WalkForwardConfig::mode)
+        .def_readwrite("min_trade_size", &felix::WalkForwardConfig::min_trade_size)
+        .def_readwrite("risk_free_rate", &felix::WalkForwardConfig::risk_free_rate)
+        .def_readwrite("periods_per_year", &felix::WalkForwardConfig::periods_per_year);
+
+    // MonteCarloConfig - Section 8.4
+    py::class_<felix::MonteCarloConfig>(m, "MonteCarloConfig")
+        .def(py::init<>())
+        .def_readwrite("paths", &felix::MonteCarloConfig::paths)
+        .def_readwrite("seed", &felix::MonteCarloConfig::seed)
+        .def_readwrite("threads", &felix::MonteCarloConfig::threads)
+        .def_readwrite("with_replacement", &felix::MonteCarloConfig::with_replacement)
+        .def_readwrite("block_size", &felix::MonteCarloConfig::block_size)
+        .def_readwrite("percentiles", &felix::MonteCarloConfig::percentiles)
+        .def_readwrite("risk_free_rate", &felix::MonteCarloConfig::risk_free_rate)
+        .def_readwrite("periods_per_year", &felix::MonteCarloConfig::periods_per_year);
+
+    // ExecutionPerturbation - Section 8.1 / 8.3
+    py::class_<felix::ExecutionPerturbation>(m, "ExecutionPerturbation")
+        .def(py::init<>())
+        .def_readwrite("slippage_bps_std", &felix::ExecutionPerturbation::slippage_bps_std)
+        .def_readwrite("latency_jitter_ns", &felix::ExecutionPerturbation::latency_jitter_ns);
 
     // ========== CORE COMPONENTS ==========
     
@@ -189,48 +833,139 @@ PYBIND11_MODULE(felix_engine, m) {
         .def(py::init<double>(), py::arg("initial_cash"))
         // .def("initial_capital", &felix::Portfolio::initial_capital)    
         .def("on_fill", &felix::Portfolio::on_fill)
-        .def("update_prices", &felix::Portfolio::update_prices)
+        .def("update_prices", py::overload_cast<uint32_t, double>(&felix::Portfolio::update_prices))
+        .def("update_prices_batch",
+             [](felix::Portfolio& p,
+                py::array_t<uint32_t, py::array::c_style | py::array::forcecast> symbol_ids,
+                py::array_t<double, py::array::c_style | py::array::forcecast> prices) {
+                 if (symbol_ids.size() != prices.size()) {
+                     throw std::invalid_argument("symbol_ids and prices must have the same length");
+                 }
+                 p.update_prices(symbol_ids.data(), prices.data(), static_cast<size_t>(prices.size()));
+             },
+             py::arg("symbol_ids"), py::arg("prices"))
+        .def("exposure", &felix::Portfolio::exposure)
         .def("append_equity_point", &felix::Portfolio::append_equity_point)
         .def("cash", &felix::Portfolio::cash)
         .def("initial_cash", &felix::Portfolio::initial_cash)
         .def("equity", &felix::Portfolio::equity)
         .def("total_unrealized_pnl", &felix::Portfolio::total_unrealized_pnl)
         .def("total_realized_pnl", &felix::Portfolio::total_realized_pnl)
-        .def("get_position", &felix::Portfolio::get_position, py::return_value_policy::reference)
-        .def("equity_curve", &felix::Portfolio::equity_curve, py::return_value_policy::reference)
+        .def("market_value", &felix::Portfolio::market_value)
+        .def("set_consistency_check", &felix::Portfolio::set_consistency_check)
+        .def("consistency_check", &felix::Portfolio::consistency_check)
+        .def("consistency_mismatches", &felix::Portfolio::consistency_mismatches)
+        .def("get_position", &felix::Portfolio::get_position, py::return_value_policy::copy)
+        .def("equity_curve", &felix::Portfolio::equity_curve)
+        .def("flush_equity_curve", &felix::Portfolio::flush_equity_curve)
+        .def("set_equity_recording_config", &felix::Portfolio::set_equity_recording_config)
+        .def("equity_recording_config", &felix::Portfolio::equity_recording_config)
+        .def("equity_points_recorded", [](const felix::Portfolio& p) { return p.equity_store().size(); })
+        .def("equity_resident_bytes", [](const felix::Portfolio& p) { return p.equity_store().resident_bytes(); })
+        .def("equity_spilled_bytes", [](const felix::Portfolio& p) { return p.equity_store().spilled_bytes(); })
         .def("get_timestamps", &felix::Portfolio::get_timestamps)
-        .def("get_equity_values", &felix::Portfolio::get_equity_values);
+        .def("get_equity_values", &felix::Portfolio::get_equity_values)
+        // Zero-copy structured arrays - Section 7
+        .def("equity_array", [](const felix::Portfolio& p) {
+            return felix::snapshot_array(p.equity_snapshot(), felix::equity_point_dtype());
+        })
+        .def("fills_array", [](const felix::Portfolio& p) {
+            return felix::snapshot_array(p.fill_snapshot(), felix::fill_dtype());
+        })
+        .def("performance_summary", &felix::Portfolio::performance_summary,
+             py::arg("risk_free_rate") = 0.0, py::arg("periods_per_year") = 252.0)
+        .def("set_trade_matching", &felix::Portfolio::set_trade_matching)
+        .def("trades", &felix::Portfolio::trades, py::return_value_policy::copy)
+        .def("trades_array", [](const felix::Portfolio& p) {
+            return felix::snapshot_array(p.trade_ledger().snapshot(), felix::trade_dtype());
+        });
 
     // MatchingEngine - Section 6
     py::class_<felix::MatchingEngine>(m, "MatchingEngine")
         .def(py::init<const felix::SlippageConfig&>(), py::arg("slippage") = felix::SlippageConfig{})
         .def("set_latency_config", &felix::MatchingEngine::set_latency_config)
         .def("set_slippage_config", &felix::MatchingEngine::set_slippage_config)
+        .def("set_liquidity_config", &felix::MatchingEngine::set_liquidity_config)
         .def("update_market_state", &felix::MatchingEngine::update_market_state)
         .def("submit_order", &felix::MatchingEngine::submit_order)
         .def("cancel_order", &felix::MatchingEngine::cancel_order)
+        // Basket submission: list of Order or a structured array; returns
+        // a structured array of (order_id, reject) per order
+        .def("submit_orders", [](felix::MatchingEngine& e, std::vector<felix::Order> orders) {
+            return felix::submit_results_array(e.submit_orders(std::move(orders)));
+        }, py::arg("orders"))
+        .def("submit_orders", [](felix::MatchingEngine& e, const py::array& orders) {
+            return felix::submit_results_array(e.submit_orders(felix::orders_from_array(orders)));
+        }, py::arg("orders"))
+        .def("submit_oco", &felix::MatchingEngine::submit_oco,
+             py::arg("first"), py::arg("second"))
+        .def("submit_bracket", &felix::MatchingEngine::submit_bracket,
+             py::arg("entry"), py::arg("stop_loss") = 0.0, py::arg("take_profit") = 0.0,
+             py::arg("trail_offset") = 0.0, py::arg("trail_percent") = false)
         .def("process_pending_orders", &felix::MatchingEngine::process_pending_orders,
-             py::return_value_policy::move)
+             py::return_value_policy::copy)
         .def("get_best_bid", &felix::MatchingEngine::get_best_bid)
         .def("get_best_ask", &felix::MatchingEngine::get_best_ask)
         .def("get_last_price", &felix::MatchingEngine::get_last_price)
+        .def("get_volatility", &felix::MatchingEngine::get_volatility)
+        .def("get_adv", &felix::MatchingEngine::get_adv)
         .def("set_risk_engine", &felix::MatchingEngine::set_risk_engine)
+        .def("set_verbose", &felix::MatchingEngine::set_verbose)
+        .def("set_active_strategy", &felix::MatchingEngine::set_active_strategy)
+        .def("active_strategy", &felix::MatchingEngine::active_strategy)
         .def("set_portfolio", &felix::MatchingEngine::set_portfolio)
         .def("pending_order_count", &felix::MatchingEngine::pending_order_count)
+        .def("contingent_group_slots", &felix::MatchingEngine::contingent_group_slots)
         .def("get_pending_orders", &felix::MatchingEngine::get_pending_orders,
-             py::return_value_policy::reference);
+             py::return_value_policy::reference)
+        .def("order_history", &felix::MatchingEngine::order_history,
+             py::return_value_policy::copy)
+        .def("orders_array", [](const felix::MatchingEngine& e) {
+            return felix::snapshot_array(e.order_history_snapshot(), felix::order_dtype());
+        });
 
     // RiskEngine - Section 8.4
     py::class_<felix::RiskEngine>(m, "RiskEngine")
         .def(py::init<const felix::RiskLimits&>(), py::arg("limits"))
-        .def("check_order", &felix::RiskEngine::check_order)
+        .def("set_limits", &felix::RiskEngine::set_limits)
+        .def("set_verbose", &felix::RiskEngine::set_verbose)
+        .def("limits", &felix::RiskEngine::limits)
+        .def("check_order", py::overload_cast<const felix::Order&, const felix::Portfolio&>(
+                 &felix::RiskEngine::check_order), py::arg("order"), py::arg("portfolio"))
+        .def("violations", &felix::RiskEngine::violations,
+             py::arg("order"), py::arg("cash"), py::arg("position_quantity"))
         .def("check_drawdown", &felix::RiskEngine::check_drawdown)
         .def("check_position_limit", &felix::RiskEngine::check_position_limit)
         .def("is_halted", &felix::RiskEngine::is_halted)
         .def("halt", &felix::RiskEngine::halt)
-        .def("reset", &felix::RiskEngine::reset);
+        .def("reset", &felix::RiskEngine::reset)
+        .def("reset_daily", &felix::RiskEngine::reset_daily)
+        .def("peak_equity", &felix::RiskEngine::peak_equity)
+        .def("drawdown", &felix::RiskEngine::drawdown)
+        .def("daily_pnl", &felix::RiskEngine::daily_pnl)
+        .def("rejections", &felix::RiskEngine::rejections, py::arg("rule"))
+        .def("total_rejections", &felix::RiskEngine::total_rejections)
+        .def("orders_checked", &felix::RiskEngine::orders_checked)
+        .def("halt_reason", &felix::RiskEngine::halt_reason);
 
     // DataStream - Section 4.1
+    // SymbolTable - Section 4.1
+    py::class_<felix::SymbolTable>(m, "SymbolTable")
+        .def(py::init<>())
+        .def("intern", &felix::SymbolTable::intern, py::arg("symbol_id"))
+        .def("find", &felix::SymbolTable::find, py::arg("symbol_id"),
+             "Dense index of a symbol, or SymbolTable.NO_INDEX if unknown")
+        .def("symbol_id", [](const felix::SymbolTable& table, uint32_t index) {
+            if (index >= table.size()) {
+                throw std::invalid_argument("symbol index out of range");
+            }
+            return table.symbol_id(index);
+        }, py::arg("index"))
+        .def("symbols", &felix::SymbolTable::symbols)
+        .def("size", &felix::SymbolTable::size)
+        .def("__len__", &felix::SymbolTable::size)
+        .attr("NO_INDEX") = felix::SymbolTable::kNoIndex;
+
     py::class_<felix::DataStream>(m, "DataStream")
         .def(py::init<>())
         .def("load", &felix::DataStream::load)
@@ -239,7 +974,147 @@ PYBIND11_MODULE(felix_engine, m) {
         .def("next", &felix::DataStream::next, py::return_value_policy::reference)
         .def("peek", &felix::DataStream::peek, py::return_value_policy::reference)
         .def("reset", &felix::DataStream::reset)
-        .def("current_index", &felix::DataStream::current_index);
+        .def("current_index", &felix::DataStream::current_index)
+        .def("view", &felix::DataStream::view, py::arg("begin"), py::arg("end"),
+             "Zero-copy sub-range [begin, end) sharing this stream's ticks")
+        .def("lower_bound", &felix::DataStream::lower_bound, py::arg("timestamp"))
+        .def("symbols", &felix::DataStream::symbols, "Symbols in first-seen order");
+
+    // WakeFilter - Section 5.3
+    py::class_<felix::WakeFilter>(m, "WakeFilter")
+        .def(py::init<>())
+        .def_readwrite("enabled", &felix::WakeFilter::enabled)
+        .def_readwrite("price_above", &felix::WakeFilter::price_above)
+        .def_readwrite("price_below", &felix::WakeFilter::price_below)
+        .def_readwrite("interval_ns", &felix::WakeFilter::interval_ns);
+
+    // JournalConfig / JournalDiff - Section 5.2
+    py::class_<felix::JournalConfig>(m, "JournalConfig")
+        .def(py::init<>())
+        .def_readwrite("path", &felix::JournalConfig::path)
+        .def_readwrite("hash_interval_ticks", &felix::JournalConfig::hash_interval_ticks);
+
+    // ResultsFileConfig / ResultsWriter - Section 8.4
+    py::class_<felix::EquityPyramidConfig>(m, "EquityPyramidConfig")
+        .def(py::init<>())
+        .def_readwrite("base_points", &felix::EquityPyramidConfig::base_points)
+        .def_readwrite("factor", &felix::EquityPyramidConfig::factor);
+
+    py::class_<felix::ResultsFileConfig>(m, "ResultsFileConfig")
+        .def(py::init<>())
+        .def_readwrite("path", &felix::ResultsFileConfig::path)
+        .def_readwrite("compress", &felix::ResultsFileConfig::compress)
+        .def_readwrite("chunk_rows", &felix::ResultsFileConfig::chunk_rows)
+        .def_readwrite("pyramid", &felix::ResultsFileConfig::pyramid);
+
+    py::class_<felix::ResultsWriter>(m, "ResultsWriter")
+        .def(py::init<>())
+        .def("open", &felix::ResultsWriter::open, py::arg("config"))
+        .def("close", &felix::ResultsWriter::close)
+        .def("is_open", &felix::ResultsWriter::is_open)
+        .def("append", py::overload_cast<const felix::Fill&>(&felix::ResultsWriter::append), py::arg("fill"))
+        .def("append", py::overload_cast<const felix::Trade&>(&felix::ResultsWriter::append), py::arg("trade"))
+        .def("append", py::overload_cast<const felix::EquityPoint&>(&felix::ResultsWriter::append), py::arg("point"))
+        .def("append", [](felix::ResultsWriter& writer, const felix::Portfolio& portfolio) {
+            py::gil_scoped_release release;
+            writer.append(portfolio);
+        }, py::arg("portfolio"), "Fills, trades and equity curve recorded by the portfolio")
+        .def("fills_written", &felix::ResultsWriter::fills_written)
+        .def("trades_written", &felix::ResultsWriter::trades_written)
+        .def("equity_written", &felix::ResultsWriter::equity_written)
+        .def("bytes_written", &felix::ResultsWriter::bytes_written)
+        .def("pyramid_levels", &felix::ResultsWriter::pyramid_levels)
+        .def("__enter__", [](felix::ResultsWriter& writer) -> felix::ResultsWriter& { return writer; })
+        .def("__exit__", [](felix::ResultsWriter& writer, py::args) { writer.close(); });
+
+    py::class_<felix::JournalDiff>(m, "JournalDiff")
+        .def_readonly("identical", &felix::JournalDiff::identical)
+        .def_readonly("error", &felix::JournalDiff::error)
+        .def_readonly("records_compared", &felix::JournalDiff::records_compared)
+        .def_readonly("index", &felix::JournalDiff::index)
+        .def_readonly("has_left", &felix::JournalDiff::has_left)
+        .def_readonly("has_right", &felix::JournalDiff::has_right)
+        .def_property_readonly("left_event", [](const felix::JournalDiff& d) { return d.left.event; })
+        .def_property_readonly("right_event", [](const felix::JournalDiff& d) { return d.right.event; })
+        .def_readonly("message", &felix::JournalDiff::message)
+        .def("__bool__", [](const felix::JournalDiff& d) { return d.identical; });
+
+    // Indicators - Section 7
+    py::class_<felix::IndicatorSpec>(m, "IndicatorSpec")
+        .def(py::init<>())
+        .def_readwrite("kind", &felix::IndicatorSpec::kind)
+        .def_readwrite("symbol_id", &felix::IndicatorSpec::symbol_id)
+        .def_readwrite("period", &felix::IndicatorSpec::period)
+        .def_readwrite("param", &felix::IndicatorSpec::param)
+        .def_readwrite("bar_ns", &felix::IndicatorSpec::bar_ns);
+
+    // values() / upper() / lower() arrays view the set's storage; adding an
+    // indicator may reallocate it, so take them after the last add()
+    auto indicator_view = [](py::object self, const std::vector<double>& values) {
+        return felix::borrowed_array(self, values.data(), values.size(), py::dtype::of<double>());
+    };
+
+    py::class_<felix::IndicatorSet>(m, "IndicatorSet")
+        .def(py::init<>())
+        .def("add", &felix::IndicatorSet::add, py::arg("spec"))
+        .def("add", [](felix::IndicatorSet& set, felix::IndicatorKind kind, uint32_t symbol_id,
+                       uint32_t period, double param, uint64_t bar_ns) {
+            felix::IndicatorSpec spec;
+            spec.kind = kind;
+            spec.symbol_id = symbol_id;
+            spec.period = period;
+            spec.param = param;
+            spec.bar_ns = bar_ns;
+            return set.add(spec);
+        }, py::arg("kind"), py::arg("symbol_id"), py::arg("period") = 20,
+           py::arg("param") = 2.0, py::arg("bar_ns") = 0)
+        .def("clear", &felix::IndicatorSet::clear)
+        .def("reset", &felix::IndicatorSet::reset)
+        .def("update", &felix::IndicatorSet::update)
+        .def("spec", &felix::IndicatorSet::spec, py::return_value_policy::copy)
+        .def("ready", &felix::IndicatorSet::ready)
+        .def("value", &felix::IndicatorSet::value)
+        .def("upper", &felix::IndicatorSet::upper)
+        .def("lower", &felix::IndicatorSet::lower)
+        .def("values", [indicator_view](py::object self) {
+            return indicator_view(self, self.cast<const felix::IndicatorSet&>().values());
+        })
+        .def("upper_values", [indicator_view](py::object self) {
+            return indicator_view(self, self.cast<const felix::IndicatorSet&>().upper_values());
+        })
+        .def("lower_values", [indicator_view](py::object self) {
+            return indicator_view(self, self.cast<const felix::IndicatorSet&>().lower_values());
+        })
+        .def("updates", &felix::IndicatorSet::updates)
+        .def("__len__", &felix::IndicatorSet::size);
+
+    // Tick window - Section 4.1
+    py::class_<felix::TickWindowConfig>(m, "TickWindowConfig")
+        .def(py::init<>())
+        .def_readwrite("tick_capacity", &felix::TickWindowConfig::tick_capacity)
+        .def_readwrite("bar_capacity", &felix::TickWindowConfig::bar_capacity)
+        .def_readwrite("bar_ns", &felix::TickWindowConfig::bar_ns);
+
+    // ticks() / bars() are views of the last N records, oldest first; they
+    // are only valid until the next tick, so fetch them inside the callback
+    py::class_<felix::TickWindow>(m, "TickWindow")
+        .def(py::init<>())
+        .def(py::init<const felix::TickWindowConfig&>(), py::arg("config"))
+        .def("set_config", &felix::TickWindow::set_config)
+        .def("config", &felix::TickWindow::config)
+        .def("update", &felix::TickWindow::update)
+        .def("clear", &felix::TickWindow::clear)
+        .def("ticks", [](py::object self, uint32_t symbol_id) {
+            size_t count = 0;
+            const felix::TickRecord* data = self.cast<const felix::TickWindow&>().ticks(symbol_id, count);
+            return felix::borrowed_array(self, data, count, felix::tick_dtype());
+        }, py::arg("symbol_id"))
+        .def("bars", [](py::object self, uint32_t symbol_id) {
+            size_t count = 0;
+            const felix::WindowBar* data = self.cast<const felix::TickWindow&>().bars(symbol_id, count);
+            return felix::borrowed_array(self, data, count, felix::window_bar_dtype());
+        }, py::arg("symbol_id"))
+        .def("symbol_count", &felix::TickWindow::symbol_count);
 
     // ========== EVENT LOOP - Section 5.2 ==========
     py::class_<felix::EventLoop>(m, "EventLoop")
@@ -247,9 +1122,21 @@ PYBIND11_MODULE(felix_engine, m) {
         .def("set_matching_engine", &felix::EventLoop::set_matching_engine)
         .def("set_portfolio", &felix::EventLoop::set_portfolio)
         .def("set_risk_engine", &felix::EventLoop::set_risk_engine)
+        .def("set_indicators", &felix::EventLoop::set_indicators)
+        .def("set_tick_window", &felix::EventLoop::set_tick_window)
+        .def("set_verbose", &felix::EventLoop::set_verbose)
         .def("ticks_processed", &felix::EventLoop::ticks_processed)
         .def("orders_processed", &felix::EventLoop::orders_processed)
         .def("fills_generated", &felix::EventLoop::fills_generated)
+        .def("ticks_fast_forwarded", &felix::EventLoop::ticks_fast_forwarded)
+        .def("set_fast_forward", &felix::EventLoop::set_fast_forward)
+        .def("set_wake_filter", &felix::EventLoop::set_wake_filter)
+        .def("wake_filter", &felix::EventLoop::wake_filter)
+        .def("set_journal_config", &felix::EventLoop::set_journal_config)
+        .def("journal_config", &felix::EventLoop::journal_config)
+        .def("journal_records", &felix::EventLoop::journal_records)
+        .def("set_results_config", &felix::EventLoop::set_results_config)
+        .def("results_config", &felix::EventLoop::results_config)
         // Main run method that takes Python strategy
         .def("run", [](felix::EventLoop& loop, felix::DataStream& stream, 
                        py::object py_strategy, felix::MatchingEngine* engine,
@@ -262,9 +1149,374 @@ PYBIND11_MODULE(felix_engine, m) {
                 py::gil_scoped_release release;
                 loop.run(stream, wrapper);
             }
-        }, py::arg("stream"), py::arg("strategy"), py::arg("engine"), py::arg("portfolio"));
+        }, py::arg("stream"), py::arg("strategy"), py::arg("engine"), py::arg("portfolio"))
+        // Signal-array mode (Section 7): NaN = no signal; one value per tick,
+        // or timed values (e.g. per bar) with optional per-signal symbols;
+        // cancel_unfilled replaces resting orders on each new signal
+        .def("run_signals", [](felix::EventLoop& loop, felix::DataStream& stream,
+                               py::array_t<double, py::array::c_style | py::array::forcecast> signals,
+                               felix::SignalMode mode,
+                               std::optional<py::array_t<uint64_t, py::array::c_style | py::array::forcecast>> timestamps,
+                               std::optional<py::array_t<uint32_t, py::array::c_style | py::array::forcecast>> symbol_ids,
+                               double min_trade_size, bool cancel_unfilled) {
+            felix::SignalSchedule schedule;
+            schedule.mode = mode;
+            schedule.values = signals.data();
+            schedule.count = static_cast<size_t>(signals.size());
+            schedule.min_trade_size = min_trade_size;
+            schedule.cancel_unfilled = cancel_unfilled;
+            if (timestamps) {
+                if (static_cast<size_t>(timestamps->size()) != schedule.count) {
+                    throw std::invalid_argument("run_signals: timestamps and signals differ in length");
+                }
+                schedule.timestamps = timestamps->data();
+            } else if (schedule.count != stream.size()) {
+                throw std::invalid_argument("run_signals: need one signal per tick, or timestamps");
+            }
+            if (symbol_ids) {
+                if (!timestamps || static_cast<size_t>(symbol_ids->size()) != schedule.count) {
+                    throw std::invalid_argument("run_signals: symbol_ids need timestamps of the same length");
+                }
+                schedule.symbol_ids = symbol_ids->data();
+            }
+            py::gil_scoped_release release;
+            return loop.run_signals(stream, schedule);
+        }, py::arg("stream"), py::arg("signals"), py::arg("mode") = felix::SignalMode::TARGET_POSITION,
+           py::arg("timestamps") = py::none(), py::arg("symbol_ids") = py::none(),
+           py::arg("min_trade_size") = 1e-9, py::arg("cancel_unfilled") = false)
+        // C ABI strategy (strategy_abi.h): callback and state addresses, e.g.
+        // a Numba cfunc's .address or a ctypes pointer; runs without the GIL
+        .def("run_native", [](felix::EventLoop& loop, felix::DataStream& stream,
+                              uintptr_t on_tick, uintptr_t on_fill, uintptr_t on_bar, uintptr_t state) {
+            if (!on_tick && !on_fill && !on_bar) {
+                throw std::invalid_argument("run_native: no callbacks given");
+            }
+            felix::NativeCallbacks callbacks;
+            callbacks.on_tick = reinterpret_cast<felix_on_tick_fn>(on_tick);
+            callbacks.on_fill = reinterpret_cast<felix_on_fill_fn>(on_fill);
+            callbacks.on_bar = reinterpret_cast<felix_on_bar_fn>(on_bar);
+            callbacks.state = reinterpret_cast<void*>(state);
+            py::gil_scoped_release release;
+            return loop.run_native(stream, callbacks);
+        }, py::arg("stream"), py::arg("on_tick") = 0, py::arg("on_fill") = 0, py::arg("on_bar") = 0,
+           py::arg("state") = 0)
+        // Several Python strategies in one pass (Section 7): (strategy, book)
+        // pairs; orders are tagged 1..N in list order
+        .def("run_multi", [](felix::EventLoop& loop, felix::DataStream& stream,
+                             py::list strategies, felix::MatchingEngine* engine,
+                             felix::CapitalMode capital) {
+            std::vector<std::unique_ptr<felix::PyStrategyWrapper>> wrappers;
+            std::vector<felix::StrategySlot> slots;
+            for (py::handle item : strategies) {
+                py::tuple pair = item.cast<py::tuple>();
+                if (pair.size() != 2) {
+                    throw std::invalid_argument("run_multi: expected (strategy, book) pairs");
+                }
+                auto* book = pair[1].cast<felix::Portfolio*>();
+                wrappers.push_back(std::make_unique<felix::PyStrategyWrapper>(
+                    py::reinterpret_borrow<py::object>(pair[0]), engine, book));
+                slots.push_back(felix::StrategySlot{wrappers.back().get(), book});
+            }
+            {
+                py::gil_scoped_release release;
+                loop.run_multi(stream, slots, capital);
+            }
+        }, py::arg("stream"), py::arg("strategies"), py::arg("engine"),
+           py::arg("capital") = felix::CapitalMode::SHARED);
+
+    // ========== WALK-FORWARD - Section 8.4 ==========
+    py::class_<felix::WalkForwardFold>(m, "WalkForwardFold")
+        .def_readonly("in_sample_start", &felix::WalkForwardFold::in_sample_start)
+        .def_readonly("in_sample_end", &felix::WalkForwardFold::in_sample_end)
+        .def_readonly("out_of_sample_start", &felix::WalkForwardFold::out_of_sample_start)
+        .def_readonly("out_of_sample_end", &felix::WalkForwardFold::out_of_sample_end)
+        .def_readonly("in_sample_ticks", &felix::WalkForwardFold::in_sample_ticks)
+        .def_readonly("out_of_sample_ticks", &felix::WalkForwardFold::out_of_sample_ticks)
+        .def_readonly("best_candidate", &felix::WalkForwardFold::best_candidate)
+        .def_readonly("in_sample_score", &felix::WalkForwardFold::in_sample_score)
+        .def_readonly("in_sample", &felix::WalkForwardFold::in_sample)
+        .def_readonly("out_of_sample", &felix::WalkForwardFold::out_of_sample)
+        .def_readonly("out_of_sample_orders", &felix::WalkForwardFold::out_of_sample_orders);
+
+    py::class_<felix::WalkForwardResult>(m, "WalkForwardResult")
+        .def_readonly("candidates", &felix::WalkForwardResult::candidates)
+        .def_readonly("folds", &felix::WalkForwardResult::folds)
+        .def_readonly("out_of_sample", &felix::WalkForwardResult::out_of_sample)
+        // (folds, candidates) in-sample scores
+        .def_property_readonly("scores", [](const felix::WalkForwardResult& r) {
+            py::array_t<double> scores({static_cast<py::ssize_t>(r.folds.size()),
+                                        static_cast<py::ssize_t>(r.candidates)});
+            std::copy(r.scores.begin(), r.scores.end(), scores.mutable_data());
+            return scores;
+        })
+        // Stitched out-of-sample curve as a structured array (copied per access)
+        .def_property_readonly("equity_curve", [](const felix::WalkForwardResult& r) {
+            auto points = std::make_shared<const std::vector<felix::EquityPoint>>(r.equity_curve);
+            return felix::snapshot_array(std::move(points), felix::equity_point_dtype());
+        });
+
+    m.def("walk_forward",
+          [](const felix::DataStream& stream,
+             py::array_t<double, py::array::c_style | py::array::forcecast> signals,
+             const felix::WalkForwardConfig& config) {
+              // One row of per-tick signals per candidate parameter set
+              if (signals.ndim() == 1) {
+                  signals = py::array_t<double, py::array::c_style | py::array::forcecast>(
+                      signals.reshape({py::ssize_t{1}, signals.shape(0)}));
+              }
+              if (signals.ndim() != 2 || static_cast<size_t>(signals.shape(1)) != stream.size()) {
+                  throw std::invalid_argument("walk_forward: signals must have shape (candidates, ticks)");
+              }
+              if (config.in_sample_ns == 0 || config.out_of_sample_ns == 0) {
+                  throw std::invalid_argument("walk_forward: window lengths must be non-zero");
+              }
+              std::vector<const double*> candidates;
+              for (py::ssize_t i = 0; i < signals.shape(0); ++i) {
+                  candidates.push_back(signals.data(i, 0));
+              }
+              py::gil_scoped_release release;
+              return felix::walk_forward(stream, candidates, config);
+          },
+          py::arg("stream"), py::arg("signals"), py::arg("config"),
+          "Walk-forward sweep over precomputed signal arrays, folds run concurrently");
+
+    // ========== NATIVE STRATEGY ABI - Section 7 ==========
+    m.def("strategy_abi", []() {
+        const felix_api& api = felix::NativeStrategy::api();
+        py::dict abi;
+        abi["version"] = api.version;
+        abi["submit"] = reinterpret_cast<uintptr_t>(api.submit);
+        abi["cancel"] = reinterpret_cast<uintptr_t>(api.cancel);
+        abi["position"] = reinterpret_cast<uintptr_t>(api.position);
+        abi["cash"] = reinterpret_cast<uintptr_t>(api.cash);
+        abi["equity"] = reinterpret_cast<uintptr_t>(api.equity);
+        abi["tick_dtype"] = felix::tick_dtype();
+        abi["fill_dtype"] = felix::fill_dtype();
+        return abi;
+    }, "Addresses of the felix_api functions (callable from a Numba cfunc via ctypes) "
+       "and the dtypes of felix_tick / felix_fill");
+
+    // ========== PYTHON STRATEGY SWEEPS - Section 7 ==========
+    py::class_<felix::StrategyJob>(m, "StrategyJob")
+        .def(py::init<>())
+        .def(py::init([](std::string strategy, std::string params) {
+            felix::StrategyJob job;
+            job.strategy = std::move(strategy);
+            job.params = std::move(params);
+            return job;
+        }), py::arg("strategy"), py::arg("params") = "")
+        .def_readwrite("strategy", &felix::StrategyJob::strategy)
+        .def_readwrite("params", &felix::StrategyJob::params)
+        .def_readwrite("backtest", &felix::StrategyJob::backtest)
+        .def_readwrite("keep_curve", &felix::StrategyJob::keep_curve);
+
+    py::class_<felix::StrategyJobResult>(m, "StrategyJobResult")
+        .def_readonly("summary", &felix::StrategyJobResult::summary)
+        .def_readonly("orders", &felix::StrategyJobResult::orders)
+        .def_readonly("fills", &felix::StrategyJobResult::fills)
+        .def_readonly("error", &felix::StrategyJobResult::error)
+        .def_property_readonly("ok", [](const felix::StrategyJobResult& r) { return r.error.empty(); })
+        .def_property_readonly("equity_curve", [](const felix::StrategyJobResult& r) -> py::object {
+            if (!r.curve) return py::none();
+            return felix::snapshot_array(r.curve, felix::equity_point_dtype());
+        });
+
+    m.def("run_strategies",
+          [](const felix::DataStream& stream, const std::vector<felix::StrategyJob>& jobs,
+             unsigned threads, felix::StrategyIsolation isolation) {
+              if (isolation == felix::StrategyIsolation::SUBINTERPRETER && !FELIX_SUBINTERPRETERS) {
+                  throw std::invalid_argument(
+                      "run_strategies: built without sub-interpreter support (needs pybind11 3.0)");
+              }
+              return felix::run_strategy_jobs(stream, jobs, threads, isolation);
+          },
+          py::arg("stream"), py::arg("jobs"), py::arg("threads") = 0,
+          py::arg("isolation") = felix::StrategyIsolation::THREAD,
+          "Independent Python-strategy backtests over one loaded stream, run concurrently");
+
+    // ========== MONTE CARLO - Section 8.4 ==========
+    auto to_array = [](const std::vector<double>& v) {
+        py::array_t<double> out(static_cast<py::ssize_t>(v.size()));
+        std::copy(v.begin(), v.end(), out.mutable_data());
+        return out;
+    };
+    py::class_<felix::MonteCarloResult>(m, "MonteCarloResult")
+        .def_property_readonly("percentiles", [to_array](const felix::MonteCarloResult& r) { return to_array(r.percentiles); })
+        .def_property_readonly("final_equity", [to_array](const felix::MonteCarloResult& r) { return to_array(r.final_equity); })
+        .def_property_readonly("max_drawdown", [to_array](const felix::MonteCarloResult& r) { return to_array(r.max_drawdown); })
+        .def_property_readonly("sharpe", [to_array](const felix::MonteCarloResult& r) { return to_array(r.sharpe); })
+        .def_property_readonly("final_equity_pct", [to_array](const felix::MonteCarloResult& r) { return to_array(r.final_equity_pct); })
+        .def_property_readonly("max_drawdown_pct", [to_array](const felix::MonteCarloResult& r) { return to_array(r.max_drawdown_pct); })
+        .def_property_readonly("sharpe_pct", [to_array](const felix::MonteCarloResult& r) { return to_array(r.sharpe_pct); });
+
+    m.def("monte_carlo_trades",
+          [](py::array_t<double, py::array::c_style | py::array::forcecast> pnls,
+             double initial_equity, const felix::MonteCarloConfig& config) {
+              const double* data = pnls.data();
+              size_t n = static_cast<size_t>(pnls.size());
+              py::gil_scoped_release release;
+              return felix::monte_carlo_trades(data, n, initial_equity, config);
+          },
+          py::arg("pnls"), py::arg("initial_equity"), py::arg("config"),
+          "Trade-order shuffle (or bootstrap) of closed-trade P&Ls, paths run concurrently");
+
+    m.def("monte_carlo_returns",
+          [](py::array_t<double, py::array::c_style | py::array::forcecast> equity,
+             const felix::MonteCarloConfig& config) {
+              const double* data = equity.data();
+              size_t n = static_cast<size_t>(equity.size());
+              py::gil_scoped_release release;
+              return felix::monte_carlo_returns(data, n, config);
+          },
+          py::arg("equity"), py::arg("config"),
+          "Moving-block bootstrap of an equity curve's returns, paths run concurrently");
+
+    m.def("lttb_indices",
+          [](py::array_t<double, py::array::c_style | py::array::forcecast> x,
+             py::array_t<double, py::array::c_style | py::array::forcecast> y, size_t threshold) {
+              if (x.size() != y.size()) {
+                  throw std::invalid_argument("x and y must have the same length");
+              }
+              std::vector<size_t> indices;
+              {
+                  py::gil_scoped_release release;
+                  indices = felix::lttb_indices(x.data(), y.data(), static_cast<size_t>(y.size()), threshold);
+              }
+              return felix::column_array<uint64_t>(indices);
+          },
+          py::arg("x"), py::arg("y"), py::arg("threshold"),
+          "Largest-Triangle-Three-Buckets: indices of `threshold` points keeping the line's shape");
+
+    m.def("extrema_indices",
+          [](py::array_t<double, py::array::c_style | py::array::forcecast> y, size_t buckets) {
+              std::vector<size_t> indices;
+              {
+                  py::gil_scoped_release release;
+                  indices = felix::extrema_indices(y.data(), static_cast<size_t>(y.size()), buckets);
+              }
+              return felix::column_array<uint64_t>(indices);
+          },
+          py::arg("y"), py::arg("buckets"),
+          "Indices of the lowest and highest point of each bucket, plus the end points");
+
+    m.def("equity_pyramid",
+          [](py::array_t<uint64_t, py::array::c_style | py::array::forcecast> timestamps,
+             py::array_t<double, py::array::c_style | py::array::forcecast> equity,
+             const felix::EquityPyramidConfig& config) {
+              if (timestamps.size() != equity.size()) {
+                  throw std::invalid_argument("timestamps and equity must have the same length");
+              }
+              felix::EquityPyramid pyramid;
+              {
+                  py::gil_scoped_release release;
+                  pyramid = felix::build_equity_pyramid(timestamps.data(), equity.data(),
+                                                        static_cast<size_t>(equity.size()), config);
+              }
+              py::list levels;
+              for (std::vector<felix::EquityLevelPoint>& level : pyramid.levels) {
+                  auto data = std::make_shared<std::vector<felix::EquityLevelPoint>>(std::move(level));
+                  levels.append(felix::snapshot_array<felix::EquityLevelPoint>(std::move(data),
+                                                                                felix::equity_level_dtype()));
+              }
+              return levels;
+          },
+          py::arg("timestamps"), py::arg("equity"), py::arg("config") = felix::EquityPyramidConfig(),
+          "Downsampled equity / drawdown levels (index, timestamp, equity, drawdown), coarsest first");
+
+    m.def("monte_carlo_execution",
+          [](const felix::DataStream& stream,
+             py::array_t<double, py::array::c_style | py::array::forcecast> signals,
+             const felix::SignalBacktestConfig& backtest,
+             const felix::ExecutionPerturbation& perturbation,
+             const felix::MonteCarloConfig& config) {
+              if (signals.ndim() != 1 || static_cast<size_t>(signals.shape(0)) != stream.size()) {
+                  throw std::invalid_argument("monte_carlo_execution: need one signal per tick");
+              }
+              const double* data = signals.data();
+              py::gil_scoped_release release;
+              return felix::monte_carlo_execution(stream, data, backtest, perturbation, config);
+          },
+          py::arg("stream"), py::arg("signals"), py::arg("backtest"), py::arg("perturbation"),
+          py::arg("config"),
+          "Signal backtest re-run with perturbed slippage and latency, paths run concurrently");
 
     // ========== UTILITY FUNCTIONS ==========
+    m.def("philox_normal", &felix::philox_normal,
+          py::arg("seed"), py::arg("stream"), py::arg("index"),
+          "Standard normal draw used by stochastic slippage for (seed, order_id, fill number)");
+
+    m.def("compute_performance",
+          [](py::array_t<double, py::array::c_style | py::array::forcecast> equity,
+             double risk_free_rate, double periods_per_year) {
+              py::buffer_info info = equity.request();
+              const double* data = static_cast<const double*>(info.ptr);
+              size_t n = static_cast<size_t>(info.size);
+              py::gil_scoped_release release;
+              return felix::compute_performance(data, n, risk_free_rate, periods_per_year);
+          },
+          py::arg("equity"), py::arg("risk_free_rate") = 0.0, py::arg("periods_per_year") = 252.0,
+          "Batch metrics over an equity array (contiguous float64 is used without copying)");
+
+    m.def("diff_journals",
+          [](const std::string& left, const std::string& right) {
+              py::gil_scoped_release release;
+              return felix::diff_journals(left, right);
+          },
+          py::arg("left"), py::arg("right"),
+          "Streaming comparison of two run journals; reports the first differing record");
+
+    m.def("read_journal",
+          [](const std::string& path) {
+              felix::JournalReader reader;
+              if (!reader.open(path)) {
+                  throw std::invalid_argument("not a run journal: " + path);
+              }
+              auto records = std::make_shared<std::vector<felix::JournalRecord>>();
+              felix::JournalRecord record;
+              while (reader.next(record)) {
+                  records->push_back(record);
+              }
+              return felix::snapshot_array<felix::JournalRecord>(std::move(records), felix::journal_record_dtype());
+          },
+          py::arg("path"), "Run journal as a structured NumPy array");
+
+    m.def("write_results",
+          [](const std::string& path, const felix::Portfolio& portfolio, bool compress) {
+              py::gil_scoped_release release;
+              return felix::write_results(path, portfolio, compress);
+          },
+          py::arg("path"), py::arg("portfolio"), py::arg("compress") = true,
+          "Columnar results file of a finished run: fills, trades and equity curve");
+
+    m.def("read_results",
+          [](const std::string& path, std::optional<std::vector<std::string>> only) {
+              std::vector<felix::ResultsTable> tables;
+              {
+                  py::gil_scoped_release release;
+                  tables = felix::read_results(path, only.value_or(std::vector<std::string>{}));
+              }
+              // {table: {column: array}}, integer columns at their logical width
+              py::dict out;
+              for (const felix::ResultsTable& table : tables) {
+                  py::dict columns;
+                  for (const felix::ResultsColumn& column : table.columns) {
+                      py::array array;
+                      switch (column.type) {
+                          case felix::ColumnType::U8: array = felix::column_array<uint8_t>(column.ints); break;
+                          case felix::ColumnType::U32: array = felix::column_array<uint32_t>(column.ints); break;
+                          case felix::ColumnType::U64: array = felix::column_array<uint64_t>(column.ints); break;
+                          case felix::ColumnType::F64: array = felix::column_array<double>(column.doubles); break;
+                      }
+                      columns[column.name.c_str()] = array;
+                  }
+                  out[table.name.c_str()] = columns;
+              }
+              return out;
+          },
+          py::arg("path"), py::arg("tables") = py::none(),
+          "Columnar results file as {table: {column: array}}, optionally only the named tables; "
+          "empty when the file is not a results file");
+
     m.def("create_market_order", [](uint32_t symbol_id, felix::Side side, double size, 
                                      uint64_t timestamp) {
         felix::Order order;
@@ -289,4 +1541,32 @@ PYBIND11_MODULE(felix_engine, m) {
         return order;
     }, py::arg("symbol_id"), py::arg("side"), py::arg("size"), 
        py::arg("price"), py::arg("timestamp"));
+
+    m.def("create_stop_limit_order", [](uint32_t symbol_id, felix::Side side, double size,
+                                         double stop_price, double limit_price, uint64_t timestamp) {
+        felix::Order order;
+        order.symbol_id = symbol_id;
+        order.side = side;
+        order.order_type = felix::OrderType::STOP_LIMIT;
+        order.size = size;
+        order.stop_price = stop_price;
+        order.price = limit_price;
+        order.timestamp = timestamp;
+        return order;
+    }, py::arg("symbol_id"), py::arg("side"), py::arg("size"),
+       py::arg("stop_price"), py::arg("limit_price"), py::arg("timestamp"));
+
+    m.def("create_trailing_stop_order", [](uint32_t symbol_id, felix::Side side, double size,
+                                            double trail_offset, bool trail_percent, uint64_t timestamp) {
+        felix::Order order;
+        order.symbol_id = symbol_id;
+        order.side = side;
+        order.order_type = felix::OrderType::TRAILING_STOP;
+        order.size = size;
+        order.trail_offset = trail_offset;
+        order.trail_percent = trail_percent;
+        order.timestamp = timestamp;
+        return order;
+    }, py::arg("symbol_id"), py::arg("side"), py::arg("size"),
+       py::arg("trail_offset"), py::arg("trail_percent") = false, py::arg("timestamp") = 0);
 }
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "felix/datastream.hpp"
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <cstring>
@@ -40,15 +41,25 @@ bool DataStream::load(const std::string& filepath) {
     }
     
     // Read all ticks
-    ticks_.resize(num_ticks);
-    file.read(reinterpret_cast<char*>(ticks_.data()), num_ticks * tick_size);
+    auto ticks = std::make_shared<std::vector<TickRecord>>(num_ticks);
+    file.read(reinterpret_cast<char*>(ticks->data()), num_ticks * tick_size);
     
     current_index_ = 0;
     
+    // Build the dense symbol dictionary once, up front
+    symbols_ = SymbolTable();
+    for (auto& tick : *ticks) {
+        tick.symbol_index = symbols_.intern(tick.symbol_id);
+    }
+    ticks_ = ticks->data();
+    size_ = num_ticks;
+    storage_ = std::move(ticks);
+    
     std::cout << "[DataStream] Loaded " << num_ticks << " ticks from " << filepath << std::endl;
+    std::cout << "[DataStream] Symbols: " << symbols_.size() << std::endl;
     
     // Debug: Print first tick
-    if (!ticks_.empty()) {
+    if (size_ > 0) {
         const auto& t = ticks_[0];
         std::cout << "[DataStream] First tick: ts=" << t.timestamp 
                   << " symbol=" << t.symbol_id
@@ -61,12 +72,16 @@ bool DataStream::load(const std::string& filepath) {
     return true;
 }
 
+const TickRecord* DataStream::data() const {
+    return ticks_;
+}
+
 size_t DataStream::size() const {
-    return ticks_.size();
+    return size_;
 }
 
 bool DataStream::has_next() const {
-    return current_index_ < ticks_.size();
+    return current_index_ < size_;
 }
 
 const TickRecord& DataStream::next() {
@@ -81,4 +96,21 @@ void DataStream::reset() {
     current_index_ = 0;
 }
 
+DataStream DataStream::view(size_t begin, size_t end) const {
+    end = std::min(end, size_);
+    begin = std::min(begin, end);
+    DataStream sub;
+    sub.storage_ = storage_;
+    sub.ticks_ = ticks_ + begin;
+    sub.size_ = end - begin;
+    sub.symbols_ = symbols_;
+    return sub;
+}
+
+size_t DataStream::lower_bound(uint64_t timestamp) const {
+    const TickRecord* it = std::lower_bound(ticks_, ticks_ + size_, timestamp,
+        [](const TickRecord& tick, uint64_t ts) { return tick.timestamp < ts; });
+    return static_cast<size_t>(it - ticks_);
+}
+
 } // namespace felix
\ No newline at end of file
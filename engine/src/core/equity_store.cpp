@@ -0,0 +1,228 @@
+#include "felix/equity_store.hpp"
+#include "felix/column_codec.hpp"
+#include <cstring>
+#include <iostream>
+
+namespace felix {
+
+namespace {
+
+// Writer queue depth before append() blocks on the disk
+constexpr size_t kMaxQueuedBlocks = 8;
+
+} // namespace
+
+EquityStore::EquityStore(size_t block_size)
+    : block_size_(block_size > 0 ? block_size : 1) {
+    open_ts_.reserve(block_size_);
+    open_equity_.reserve(block_size_);
+    open_cash_.reserve(block_size_);
+    open_unrealized_.reserve(block_size_);
+}
+
+EquityStore::~EquityStore() {
+    if (writer_.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        cv_.notify_all();
+        writer_.join();
+    }
+}
+
+bool EquityStore::open_spill(const std::string& path) {
+    if (writer_.joinable()) return path == spill_path_;
+
+    out_.open(path, std::ios::binary | std::ios::trunc);
+    if (!out_) {
+        std::cerr << "[EquityStore] Failed to open spill file: " << path << std::endl;
+        return false;
+    }
+    spill_path_ = path;
+    writer_ = std::thread(&EquityStore::writer_main, this);
+
+    for (auto& block : blocks_) {
+        enqueue_spill(block);
+    }
+    return true;
+}
+
+void EquityStore::append(const EquityPoint& point) {
+    open_ts_.push_back(point.timestamp);
+    open_equity_.push_back(point.equity);
+    open_cash_.push_back(point.cash);
+    open_unrealized_.push_back(point.unrealized_pnl);
+    last_ = point;
+
+    if (open_ts_.size() >= block_size_) {
+        seal_block();
+    }
+}
+
+void EquityStore::seal_block() {
+    Block block;
+    block.count = static_cast<uint32_t>(open_ts_.size());
+    block.data.reserve(open_ts_.size() * 8);
+
+    size_t start = 0;
+    encode_deltas(block.data, open_ts_.data(), open_ts_.size());
+    block.column_bytes[kTimestamp] = static_cast<uint32_t>(block.data.size() - start);
+    start = block.data.size();
+    encode_doubles(block.data, open_equity_.data(), open_equity_.size());
+    block.column_bytes[kEquity] = static_cast<uint32_t>(block.data.size() - start);
+    start = block.data.size();
+    encode_doubles(block.data, open_cash_.data(), open_cash_.size());
+    block.column_bytes[kCash] = static_cast<uint32_t>(block.data.size() - start);
+    start = block.data.size();
+    encode_doubles(block.data, open_unrealized_.data(), open_unrealized_.size());
+    block.column_bytes[kUnrealized] = static_cast<uint32_t>(block.data.size() - start);
+    block.data.shrink_to_fit();
+
+    sealed_count_ += block.count;
+    open_ts_.clear();
+    open_equity_.clear();
+    open_cash_.clear();
+    open_unrealized_.clear();
+
+    blocks_.push_back(std::move(block));
+    if (writer_.joinable()) {
+        enqueue_spill(blocks_.back());
+    }
+}
+
+void EquityStore::enqueue_spill(Block& block) {
+    if (block.data.empty()) return;
+
+    block.file_offset = spill_offset_;
+    spill_offset_ += block.data.size();
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this] { return queue_.size() < kMaxQueuedBlocks; });
+        queue_.push_back(std::move(block.data));
+    }
+    block.data = {};
+    cv_.notify_all();
+}
+
+void EquityStore::writer_main() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        cv_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+        if (queue_.empty()) break;  // stop_ with nothing left to write
+
+        writing_ = true;
+        while (!queue_.empty()) {
+            std::vector<uint8_t> data = std::move(queue_.front());
+            queue_.pop_front();
+            lock.unlock();
+            cv_.notify_all();
+            out_.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+            lock.lock();
+        }
+        lock.unlock();
+        out_.flush();
+        lock.lock();
+        writing_ = false;
+        cv_.notify_all();
+    }
+}
+
+void EquityStore::wait_for_writer() const {
+    if (!writer_.joinable()) return;
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this] { return queue_.empty() && !writing_; });
+}
+
+std::vector<uint8_t> EquityStore::load_column(const Block& block, size_t column) const {
+    size_t offset = 0;
+    for (size_t c = 0; c < column; ++c) offset += block.column_bytes[c];
+    size_t bytes = block.column_bytes[column];
+
+    if (!block.data.empty()) {
+        return std::vector<uint8_t>(block.data.begin() + offset, block.data.begin() + offset + bytes);
+    }
+
+    std::vector<uint8_t> data(bytes);
+    std::ifstream in(spill_path_, std::ios::binary);
+    in.seekg(static_cast<std::streamoff>(block.file_offset + offset));
+    in.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(bytes));
+    if (!in) {
+        std::cerr << "[EquityStore] Failed to read spilled block from: " << spill_path_ << std::endl;
+        data.assign(bytes, 0);
+    }
+    return data;
+}
+
+void EquityStore::decode_timestamps(const Block& block, std::vector<uint64_t>& out) const {
+    std::vector<uint8_t> data = load_column(block, kTimestamp);
+    const uint8_t* p = data.data();
+    felix::decode_deltas(p, block.count, out);
+}
+
+void EquityStore::decode_doubles(const Block& block, size_t column, std::vector<double>& out) const {
+    std::vector<uint8_t> data = load_column(block, column);
+    const uint8_t* p = data.data();
+    felix::decode_doubles(p, block.count, out);
+}
+
+std::vector<EquityPoint> EquityStore::points() const {
+    wait_for_writer();
+    std::vector<uint64_t> ts = timestamps();
+    std::vector<double> equity = equity_values();
+    std::vector<double> cash;
+    std::vector<double> unrealized;
+    cash.reserve(ts.size());
+    unrealized.reserve(ts.size());
+    for (const auto& block : blocks_) {
+        decode_doubles(block, kCash, cash);
+        decode_doubles(block, kUnrealized, unrealized);
+    }
+    cash.insert(cash.end(), open_cash_.begin(), open_cash_.end());
+    unrealized.insert(unrealized.end(), open_unrealized_.begin(), open_unrealized_.end());
+
+    std::vector<EquityPoint> result(ts.size());
+    for (size_t i = 0; i < ts.size(); ++i) {
+        result[i] = {ts[i], equity[i], cash[i], unrealized[i]};
+    }
+    return result;
+}
+
+std::vector<uint64_t> EquityStore::timestamps() const {
+    wait_for_writer();
+    std::vector<uint64_t> values;
+    values.reserve(size());
+    for (const auto& block : blocks_) {
+        decode_timestamps(block, values);
+    }
+    values.insert(values.end(), open_ts_.begin(), open_ts_.end());
+    return values;
+}
+
+std::vector<double> EquityStore::equity_values() const {
+    wait_for_writer();
+    std::vector<double> values;
+    values.reserve(size());
+    for (const auto& block : blocks_) {
+        decode_doubles(block, kEquity, values);
+    }
+    values.insert(values.end(), open_equity_.begin(), open_equity_.end());
+    return values;
+}
+
+size_t EquityStore::resident_bytes() const {
+    size_t bytes = blocks_.capacity() * sizeof(Block);
+    for (const auto& block : blocks_) {
+        bytes += block.data.capacity();
+    }
+    bytes += open_ts_.capacity() * sizeof(uint64_t);
+    bytes += (open_equity_.capacity() + open_cash_.capacity() + open_unrealized_.capacity()) * sizeof(double);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& data : queue_) {
+        bytes += data.capacity();
+    }
+    return bytes;
+}
+
+} // namespace felix
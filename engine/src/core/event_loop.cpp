@@ -1,9 +1,84 @@
 #include "felix/event_loop.hpp"
+#include "felix/native_strategy.hpp"
+#include "felix/signal_strategy.hpp"
 #include <iostream>
 #include <algorithm>
 
 namespace felix {
 
+namespace {
+
+/**
+ * Strategy Group - Section 7
+ * Presents the strategies of a multi-strategy run to the loop as one.
+ * While a strategy is called, the engine tags its orders and, with
+ * ISOLATED capital, risk checks them against the strategy's own book.
+ */
+class StrategyGroup : public StrategyWrapper {
+public:
+    StrategyGroup(const std::vector<StrategySlot>& slots, MatchingEngine& engine,
+                  Portfolio& combined, CapitalMode capital)
+        : slots_(slots), engine_(engine), combined_(combined), capital_(capital) {}
+
+    void on_start() override {
+        for (size_t i = 0; i < slots_.size(); ++i) {
+            call(i, [](StrategyWrapper& s) { s.on_start(); });
+        }
+    }
+
+    void on_tick(const TickRecord& tick) override {
+        for (size_t i = 0; i < slots_.size(); ++i) {
+            StrategyWrapper& strategy = *slots_[i].strategy;
+            if (strategy.is_halted() || !strategy.should_wake(tick)) continue;
+            call(i, [&tick](StrategyWrapper& s) { s.on_tick(tick); });
+        }
+    }
+
+    void on_bar(const TickRecord& bar) override {
+        for (size_t i = 0; i < slots_.size(); ++i) {
+            call(i, [&bar](StrategyWrapper& s) { s.on_bar(bar); });
+        }
+    }
+
+    // Fills go only to the strategy whose order filled
+    void on_fill(const Fill& fill) override {
+        if (fill.strategy_id == 0 || fill.strategy_id > slots_.size()) return;
+        call(fill.strategy_id - 1, [&fill](StrategyWrapper& s) { s.on_fill(fill); });
+    }
+
+    void on_end() override {
+        for (size_t i = 0; i < slots_.size(); ++i) {
+            call(i, [](StrategyWrapper& s) { s.on_end(); });
+        }
+    }
+
+private:
+    template <typename Callback>
+    void call(size_t index, Callback callback) {
+        // Untag and restore the combined book even if the callback throws,
+        // so later orders are not checked against a book the caller may free
+        struct SlotRestorer {
+            MatchingEngine& engine;
+            Portfolio* combined;       // Null with SHARED capital
+            ~SlotRestorer() {
+                if (combined) engine.set_portfolio(combined);
+                engine.set_active_strategy(0);
+            }
+        } restorer{engine_, capital_ == CapitalMode::ISOLATED ? &combined_ : nullptr};
+
+        engine_.set_active_strategy(static_cast<uint32_t>(index + 1));
+        if (capital_ == CapitalMode::ISOLATED) engine_.set_portfolio(slots_[index].book);
+        callback(*slots_[index].strategy);
+    }
+
+    const std::vector<StrategySlot>& slots_;
+    MatchingEngine& engine_;
+    Portfolio& combined_;
+    CapitalMode capital_;
+};
+
+} // namespace
+
 EventLoop::EventLoop() 
     : matching_engine_(nullptr)
     , portfolio_(nullptr)
@@ -11,8 +86,10 @@ EventLoop::EventLoop()
     , ticks_processed_(0)
     , orders_processed_(0)
     , fills_generated_(0)
-    , peak_equity_(0.0)
-    , risk_halted_(false) {}
+    , risk_halted_(false)
+    , fast_forward_(false)
+    , last_wake_ts_(0)
+    , ticks_fast_forwarded_(0) {}
 
 EventLoop::~EventLoop() = default;
 
@@ -22,16 +99,10 @@ void EventLoop::set_matching_engine(MatchingEngine* engine) {
 
 void EventLoop::set_portfolio(Portfolio* portfolio) {
     portfolio_ = portfolio;
-    if (portfolio_) {
-        peak_equity_ = portfolio_->equity();
-    }
 }
 
 void EventLoop::set_risk_engine(RiskEngine* risk_engine) {
     risk_engine_ = risk_engine;
-    if (matching_engine_ && risk_engine_) {
-        matching_engine_->set_risk_limits(risk_engine_->limits());
-    }
 }
 
 void EventLoop::run(DataStream& stream, StrategyWrapper& strategy) {
@@ -41,56 +112,207 @@ void EventLoop::run(DataStream& stream, StrategyWrapper& strategy) {
      * Deterministic: single thread, fixed random seed, strict timestamp order.
      * Risk before strategy: internal exits happen even if Python is slow.
      */
-    if (risk_engine_ && matching_engine_ && portfolio_) {
-        matching_engine_->set_risk_engine(risk_engine_);
-        matching_engine_->set_portfolio(portfolio_);
-        peak_equity_ = portfolio_->initial_cash();
+    if (!matching_engine_ || !portfolio_) {
+        std::cerr << "[EventLoop] ERROR: MatchingEngine or Portfolio not set!" << std::endl;
+        return;
     }
 
-    // Initialize peak equity in risk engine
-    if (risk_engine_ && portfolio_) {
-        risk_engine_->check_and_update_halt(portfolio_->equity(), portfolio_->initial_cash(), 0.0);
+    // Dense per-symbol state sized once from the stream's dictionary
+    matching_engine_->register_symbols(stream.symbols());
+    portfolio_->register_symbols(stream.symbols());
+    for (Portfolio* book : books_) {
+        book->register_symbols(stream.symbols());
+    }
+
+    // Section 8.4 - one risk pipeline: pre-trade rules on submission,
+    // drawdown / daily loss once per tick in check_risk_limits
+    if (risk_engine_) {
+        matching_engine_->set_risk_engine(risk_engine_);
+        matching_engine_->set_portfolio(portfolio_);
+        risk_engine_->start(portfolio_->equity());
+        // start() clears the risk engine's halt; the loop's follows it
+        risk_halted_ = false;
+        strategy.set_halted(false);
     }
     
+    if (indicators_) {
+        indicators_->reset();
+    }
+    if (tick_window_) {
+        tick_window_->register_symbols(stream.symbols());
+        tick_window_->clear();
+    }
     
-
-    if (!matching_engine_ || !portfolio_) {
-        std::cerr << "[EventLoop] ERROR: MatchingEngine or Portfolio not set!" << std::endl;
-        return;
+    if (!journal_config_.path.empty() && journal_.open(journal_config_.path)) {
+        matching_engine_->set_journal(&journal_);
+        journal_.state(JournalEvent::RUN_START, 0, stream.size(), portfolio_->state_hash(),
+                       portfolio_->equity(), portfolio_->cash());
+    }
+    if (!results_config_.path.empty() && results_.open(results_config_)) {
+        results_fills_ = results_trades_ = results_equity_ = 0;
+        stream_results();
     }
 
-    // Initialize peak equity for drawdown tracking
-    peak_equity_ = portfolio_->equity();
+    // If a strategy callback throws, still close both files so what was
+    // recorded stays readable; the normal path closes them after the final records
+    struct OutputCloser {
+        MatchingEngine& engine;
+        RunJournal& journal;
+        ResultsWriter& results;
+        ~OutputCloser() {
+            if (journal.is_open()) {
+                engine.set_journal(nullptr);
+                journal.close();
+            }
+            results.close();
+        }
+    } closer{*matching_engine_, journal_, results_};
     
     // Call strategy start
     strategy.on_start();
     
-    std::cout << "[EventLoop] Starting backtest with " << stream.size() << " ticks" << std::endl;
+    if (verbose_) {
+        std::cout << "[EventLoop] Starting backtest with " << stream.size() << " ticks" << std::endl;
+    }
 
     // Main event loop - Section 5.2
     while (stream.has_next()) {
-        const TickRecord& tick = stream.next();
-        process_tick(tick, strategy);
-        ticks_processed_++;
-        if (risk_engine_ && portfolio_ && !risk_engine_->is_halted()) {
-            double daily_pnl = portfolio_->equity() - portfolio_->initial_cash();
-            risk_engine_->check_and_update_halt(portfolio_->equity(), portfolio_->initial_cash(), daily_pnl);
+        // Section 5.3 - skip straight to the next tick that can trigger anything
+        if (can_fast_forward(strategy)) {
+            build_trigger_envelope(stream, strategy);
+            size_t start = stream.current_index();
+            size_t quiet = find_first_trigger(stream.data() + start, stream.size() - start, envelope_);
+            for (size_t i = 0; i < quiet; ++i) {
+                process_quiet_tick(stream.next(), strategy);
+                finish_tick();
+            }
+            ticks_fast_forwarded_ += quiet;
+            if (!stream.has_next()) break;
         }
         
-        
-        // Progress logging every 100k ticks
-        if (ticks_processed_ % 100000 == 0) {
-            std::cout << "[EventLoop] Processed " << ticks_processed_ << " ticks, "
-                      << "Equity: $" << portfolio_->equity() << std::endl;
-        }
+        const TickRecord& tick = stream.next();
+        process_tick(tick, strategy);
+        finish_tick();
     }
 
     // Final processing
+    portfolio_->flush_equity_curve();
+    for (Portfolio* book : books_) {
+        book->flush_equity_curve();
+    }
     strategy.on_end();
     
-    std::cout << "[EventLoop] Backtest complete. Processed " << ticks_processed_ 
-              << " ticks, " << orders_processed_ << " orders, " 
-              << fills_generated_ << " fills" << std::endl;
+    if (journal_.is_open()) {
+        journal_.state(JournalEvent::RUN_END, current_timestamp_, ticks_processed_,
+                       portfolio_->state_hash(), portfolio_->equity(), portfolio_->cash());
+        matching_engine_->set_journal(nullptr);
+        journal_.close();
+    }
+    if (results_.is_open()) {
+        stream_results();
+        results_.append_equity_pyramid(portfolio_->equity_store());
+        results_.close();
+        if (verbose_) {
+            std::cout << "[EventLoop] Results: " << results_.fills_written() << " fills, "
+                      << results_.trades_written() << " trades, " << results_.equity_written()
+                      << " equity points (" << results_.pyramid_levels() << " pyramid levels), "
+                      << results_.bytes_written() << " bytes to "
+                      << results_config_.path << std::endl;
+        }
+    }
+    
+    if (verbose_) {
+        std::cout << "[EventLoop] Backtest complete. Processed " << ticks_processed_ 
+                  << " ticks, " << orders_processed_ << " orders, " 
+                  << fills_generated_ << " fills" << std::endl;
+    }
+}
+
+uint64_t EventLoop::run_signals(DataStream& stream, const SignalSchedule& schedule) {
+    /**
+     * Section 7 - Signal-array mode.
+     * Same loop as run(); the strategy is native, so the whole backtest
+     * stays in C++ while risk, latency and slippage still apply.
+     */
+    if (!matching_engine_ || !portfolio_) {
+        std::cerr << "[EventLoop] ERROR: MatchingEngine or Portfolio not set!" << std::endl;
+        return 0;
+    }
+    if (!schedule.timestamps && schedule.count != stream.size()) {
+        std::cerr << "[EventLoop] ERROR: " << schedule.count << " signals for "
+                  << stream.size() << " ticks" << std::endl;
+        return 0;
+    }
+
+    SignalStrategy strategy(stream, schedule, *matching_engine_, *portfolio_);
+    run(stream, strategy);
+    if (verbose_) {
+        std::cout << "[EventLoop] Signals applied: " << strategy.signals_applied()
+                  << ", orders " << strategy.orders_submitted()
+                  << " (" << strategy.orders_rejected() << " rejected)" << std::endl;
+    }
+    return strategy.orders_submitted();
+}
+
+uint64_t EventLoop::run_native(DataStream& stream, const NativeCallbacks& callbacks) {
+    /**
+     * Section 7 - Native callback mode.
+     * Same loop as run(); callbacks are plain function pointers, so nothing
+     * here needs the interpreter or its lock.
+     */
+    if (!matching_engine_ || !portfolio_) {
+        std::cerr << "[EventLoop] ERROR: MatchingEngine or Portfolio not set!" << std::endl;
+        return 0;
+    }
+
+    NativeStrategy strategy(callbacks, *matching_engine_, *portfolio_);
+    run(stream, strategy);
+    if (verbose_) {
+        std::cout << "[EventLoop] Native strategy orders: " << strategy.orders_submitted()
+                  << " (" << strategy.orders_rejected() << " rejected)" << std::endl;
+    }
+    return strategy.orders_submitted();
+}
+
+void EventLoop::run_multi(DataStream& stream, const std::vector<StrategySlot>& strategies,
+                          CapitalMode capital) {
+    /**
+     * Section 7 - Multi-strategy mode.
+     * One pass over the stream for all strategies: ticks are read, market
+     * state, indicators and the combined book updated once, and only the
+     * strategy callbacks and per-strategy books scale with the count.
+     */
+    if (!matching_engine_ || !portfolio_) {
+        std::cerr << "[EventLoop] ERROR: MatchingEngine or Portfolio not set!" << std::endl;
+        return;
+    }
+    for (const StrategySlot& slot : strategies) {
+        if (!slot.strategy || !slot.book || slot.book == portfolio_) {
+            std::cerr << "[EventLoop] ERROR: every strategy needs its own book" << std::endl;
+            return;
+        }
+    }
+
+    books_.clear();
+    for (const StrategySlot& slot : strategies) {
+        books_.push_back(slot.book);
+    }
+    // The books belong to the caller: forget them however the run ends
+    struct BooksReleaser {
+        std::vector<Portfolio*>& books;
+        ~BooksReleaser() { books.clear(); }
+    } releaser{books_};
+
+    StrategyGroup group(strategies, *matching_engine_, *portfolio_, capital);
+    run(stream, group);
+
+    if (verbose_) {
+        for (size_t i = 0; i < strategies.size(); ++i) {
+            const Portfolio& book = *strategies[i].book;
+            std::cout << "[EventLoop] Strategy " << (i + 1) << ": equity $" << book.equity()
+                      << ", " << book.fills().size() << " fills" << std::endl;
+        }
+    }
 }
 
 void EventLoop::process_tick(const TickRecord& tick, StrategyWrapper& strategy) {
@@ -104,8 +326,12 @@ void EventLoop::process_tick(const TickRecord& tick, StrategyWrapper& strategy)
      * 6. Wake strategy if appropriate
      */
     
-    // Step 1: Update market state - Section 6
+    current_timestamp_ = tick.timestamp;
+    
+    // Step 1: Update market state - Section 6 - indicators and history (Section 7)
     matching_engine_->update_market_state(tick);
+    if (indicators_) indicators_->update(tick);
+    if (tick_window_) tick_window_->update(tick);
     
     // Step 2: Check and execute pending orders - Section 6.1
     // Step 3: Notify strategy of fills
@@ -119,13 +345,107 @@ void EventLoop::process_tick(const TickRecord& tick, StrategyWrapper& strategy)
     
     // Step 6: Wake strategy (if not halted)
     if (!risk_halted_ && !strategy.is_halted()) {
-        if (strategy.should_wake(tick)) {
+        if (strategy.should_wake(tick) && wake_filter_matches(tick)) {
             strategy.on_tick(tick);
+            last_wake_ts_ = tick.timestamp;
         }
         check_pending_orders(tick, strategy);
     }
 }
 
+void EventLoop::finish_tick() {
+    ticks_processed_++;
+    
+    // Periodic state hash - a diff of two journals localizes divergence to one interval
+    if (journal_.is_open() && journal_config_.hash_interval_ticks > 0 &&
+        ticks_processed_ % journal_config_.hash_interval_ticks == 0) {
+        journal_.state(JournalEvent::STATE_HASH, current_timestamp_, ticks_processed_,
+                       portfolio_->state_hash(), portfolio_->equity(), portfolio_->cash());
+    }
+    
+    if (results_.is_open()) {
+        stream_results();
+    }
+    
+    // Progress logging every 100k ticks
+    if (verbose_ && ticks_processed_ % 100000 == 0) {
+        std::cout << "[EventLoop] Processed " << ticks_processed_ << " ticks, "
+                  << "Equity: $" << portfolio_->equity() << std::endl;
+    }
+}
+
+void EventLoop::stream_results() {
+    const std::vector<Fill>& fills = portfolio_->fills();
+    for (; results_fills_ < fills.size(); ++results_fills_) {
+        results_.append(fills[results_fills_]);
+    }
+    const std::vector<Trade>& trades = portfolio_->trades();
+    for (; results_trades_ < trades.size(); ++results_trades_) {
+        results_.append(trades[results_trades_]);
+    }
+    // At most one equity point per tick (plus the final flush), so the
+    // store's last point is the new one; decode only to catch up
+    const EquityStore& store = portfolio_->equity_store();
+    if (store.size() == results_equity_ + 1) {
+        results_.append(store.back());
+    } else if (store.size() > results_equity_) {
+        std::vector<EquityPoint> points = store.points();
+        for (size_t i = results_equity_; i < points.size(); ++i) {
+            results_.append(points[i]);
+        }
+    }
+    results_equity_ = store.size();
+}
+
+bool EventLoop::wake_filter_matches(const TickRecord& tick) const {
+    if (!wake_filter_.enabled) return true;
+    
+    const double price = tick.price;
+    return (wake_filter_.price_above > 0 && price >= wake_filter_.price_above) ||
+           (wake_filter_.price_below > 0 && price <= wake_filter_.price_below) ||
+           (wake_filter_.interval_ns > 0 && tick.timestamp >= last_wake_ts_ + wake_filter_.interval_ns);
+}
+
+bool EventLoop::can_fast_forward(const StrategyWrapper& strategy) const {
+    // Only the native wake filter is visible here; without it every tick may wake
+    return fast_forward_ && (wake_filter_.enabled || risk_halted_ || strategy.is_halted());
+}
+
+void EventLoop::build_trigger_envelope(const DataStream& stream, const StrategyWrapper& strategy) {
+    /**
+     * Section 5.3 - Everything that can make a tick non-quiet:
+     * resting order levels, order activation times, and wake conditions
+     */
+    const SymbolTable& symbols = stream.symbols();
+    envelope_.reset(symbols.size());
+    matching_engine_->collect_triggers(envelope_, symbols);
+    
+    if (wake_filter_.enabled && !risk_halted_ && !strategy.is_halted()) {
+        for (uint32_t i = 0; i < symbols.size(); ++i) {
+            if (wake_filter_.price_above > 0) envelope_.trigger_at_or_above(i, wake_filter_.price_above);
+            if (wake_filter_.price_below > 0) envelope_.trigger_at_or_below(i, wake_filter_.price_below);
+        }
+        if (wake_filter_.interval_ns > 0) {
+            envelope_.trigger_at_time(last_wake_ts_ + wake_filter_.interval_ns);
+        }
+    }
+}
+
+void EventLoop::process_quiet_tick(const TickRecord& tick, StrategyWrapper& strategy) {
+    /**
+     * Section 5.3 - A tick inside the trigger envelope.
+     * Same as process_tick, minus order processing and the strategy wake,
+     * which are provably no-ops here. Market state, mark-to-market, the
+     * equity curve, indicators, history and risk checks still run per tick.
+     */
+    current_timestamp_ = tick.timestamp;
+    matching_engine_->update_market_state(tick);
+    if (indicators_) indicators_->update(tick);
+    if (tick_window_) tick_window_->update(tick);
+    update_portfolio_mtm(tick);
+    check_risk_limits(strategy);
+}
+
 void EventLoop::check_pending_orders(const TickRecord& tick, StrategyWrapper& strategy) {
     /**
      * Section 6.1-6.2 - Order Processing
@@ -137,18 +457,24 @@ void EventLoop::check_pending_orders(const TickRecord& tick, StrategyWrapper& st
     if (!matching_engine_ || !portfolio_) return;
     
     // Get fills from matching engine
-    std::vector<Fill> fills = matching_engine_->process_pending_orders(tick.timestamp);
+    const std::vector<Fill>& fills = matching_engine_->process_pending_orders(tick.timestamp);
     for (const Fill& fill : fills) {
-        // Update portfolio with fill
+        // Update portfolio (and the submitting strategy's book) with fill
         portfolio_->on_fill(fill);
+        if (fill.strategy_id != 0 && fill.strategy_id <= books_.size()) {
+            books_[fill.strategy_id - 1]->on_fill(fill);
+        }
+        journal_.fill(fill);
         fills_generated_++;
         orders_processed_++;
         
         // Log fill
-        std::cout << "[Fill] Order " << fill.order_id 
-                  << " " << (fill.side == Side::BUY ? "BUY" : "SELL")
-                  << " " << fill.volume << " @ $" << fill.price
-                  << " (slippage: " << fill.slippage << " bps)" << std::endl;
+        if (verbose_) {
+            std::cout << "[Fill] Order " << fill.order_id 
+                      << " " << (fill.side == Side::BUY ? "BUY" : "SELL")
+                      << " " << fill.volume << " @ $" << fill.price
+                      << " (slippage: " << fill.slippage << " bps)" << std::endl;
+        }
         
         // CRITICAL: Notify strategy of fill - Section 7
         strategy.on_fill(fill);
@@ -169,29 +495,33 @@ void EventLoop::update_portfolio_mtm(const TickRecord& tick) {
     // Append equity point to curve
     portfolio_->append_equity_point(tick.timestamp);
     
-    // Update peak equity for drawdown calculation
-    double current_equity = portfolio_->equity();
-    if (current_equity > peak_equity_) {
-        peak_equity_ = current_equity;
+    for (Portfolio* book : books_) {
+        book->update_prices(tick.symbol_id, tick.price);
+        book->append_equity_point(tick.timestamp);
     }
 }
 
 void EventLoop::check_risk_limits(StrategyWrapper& strategy) {
     /**
      * Section 8.4 - Risk Management
-     * Check drawdown limits and halt if exceeded
+     * Advance the risk state with this tick's equity (peak, drawdown,
+     * daily P&L with timestamp-driven rollover); halt on a breach
      */
     
     if (!risk_engine_ || !portfolio_) return;
     
-    // Check drawdown limit
-    if (!risk_engine_->check_drawdown(*portfolio_, peak_equity_)) {
-        if (!risk_halted_) {
-            std::cout << "[RISK] Max drawdown exceeded! Halting strategy." << std::endl;
-            risk_halted_ = true;
-            strategy.set_halted(true);
-            risk_engine_->halt();
-        }
+    const bool was_halted = risk_engine_->is_halted();
+    if (!risk_engine_->on_equity(current_timestamp_, portfolio_->equity())) return;
+    
+    if (!was_halted) {
+        journal_.risk_halt(risk_engine_->halt_reason(), current_timestamp_,
+                           portfolio_->equity(), risk_engine_->peak_equity());
+    }
+    // A drawdown breach also stops waking the strategy; after a daily loss
+    // halt it keeps running but may only reduce positions
+    if (risk_engine_->halt_reason() == RiskRule::DRAWDOWN && !risk_halted_) {
+        risk_halted_ = true;
+        strategy.set_halted(true);
     }
 }
 
@@ -0,0 +1,243 @@
+#include "felix/journal.hpp"
+#include <bit>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <utility>
+
+namespace felix {
+
+namespace {
+
+constexpr char kMagic[8] = {'F', 'E', 'L', 'I', 'X', 'J', 'N', 'L'};
+constexpr uint32_t kVersion = 1;
+
+struct JournalHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t record_size;
+};
+static_assert(sizeof(JournalHeader) == 16);
+
+void describe(std::ostream& os, const JournalRecord& r) {
+    os << journal_event_name(r.event) << " ts=" << r.timestamp << " id=" << r.id
+       << " symbol=" << r.symbol_id << " side=" << int(r.side) << " kind=" << int(r.kind)
+       << " a=" << r.a << " b=" << r.b << " aux=0x" << std::hex << r.aux << std::dec;
+}
+
+} // namespace
+
+uint64_t hash_bytes(const void* data, size_t size, uint64_t seed) {
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    uint64_t h = seed;
+    for (size_t i = 0; i < size; ++i) {
+        h ^= bytes[i];
+        h *= 0x100000001b3ULL;
+    }
+    return h;
+}
+
+const char* journal_event_name(JournalEvent event) {
+    switch (event) {
+        case JournalEvent::RUN_START: return "RUN_START";
+        case JournalEvent::ORDER_SUBMIT: return "ORDER_SUBMIT";
+        case JournalEvent::ORDER_CLOSE: return "ORDER_CLOSE";
+        case JournalEvent::FILL: return "FILL";
+        case JournalEvent::RISK_HALT: return "RISK_HALT";
+        case JournalEvent::STATE_HASH: return "STATE_HASH";
+        case JournalEvent::RUN_END: return "RUN_END";
+    }
+    return "UNKNOWN";
+}
+
+// ========== RunJournal ==========
+
+RunJournal::~RunJournal() {
+    close();
+}
+
+bool RunJournal::open(const std::string& path) {
+    close();
+    out_.open(path, std::ios::binary | std::ios::trunc);
+    if (!out_) {
+        std::cerr << "[Journal] Cannot open " << path << std::endl;
+        return false;
+    }
+    JournalHeader header;
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.record_size = sizeof(JournalRecord);
+    out_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    buffer_.reserve(kBufferRecords);
+    records_ = 0;
+    return true;
+}
+
+void RunJournal::close() {
+    if (!out_.is_open()) return;
+    flush();
+    out_.close();
+}
+
+void RunJournal::flush() {
+    if (buffer_.empty()) return;
+    out_.write(reinterpret_cast<const char*>(buffer_.data()),
+               static_cast<std::streamsize>(buffer_.size() * sizeof(JournalRecord)));
+    buffer_.clear();
+}
+
+void RunJournal::append(const JournalRecord& record) {
+    if (!out_.is_open()) return;
+    buffer_.push_back(record);
+    ++records_;
+    if (buffer_.size() >= kBufferRecords) {
+        flush();
+    }
+}
+
+void RunJournal::order_submitted(const Order& order) {
+    JournalRecord r;
+    r.event = JournalEvent::ORDER_SUBMIT;
+    r.timestamp = order.timestamp;
+    r.id = order.order_id;
+    r.symbol_id = order.symbol_id;
+    r.side = static_cast<uint8_t>(order.side);
+    r.kind = static_cast<uint8_t>(order.order_type);
+    r.a = order.price;
+    r.b = order.size;
+    if (order.order_type == OrderType::STOP_LIMIT) {
+        r.aux = std::bit_cast<uint64_t>(order.stop_price);
+    } else if (order.order_type == OrderType::TRAILING_STOP) {
+        r.aux = std::bit_cast<uint64_t>(order.trail_offset);
+        r.flags = order.trail_percent ? 1 : 0;
+    }
+    append(r);
+}
+
+void RunJournal::order_closed(const Order& order, OrderStatus status, uint64_t timestamp) {
+    JournalRecord r;
+    r.event = JournalEvent::ORDER_CLOSE;
+    r.timestamp = timestamp;
+    r.id = order.order_id;
+    r.symbol_id = order.symbol_id;
+    r.side = static_cast<uint8_t>(order.side);
+    r.kind = static_cast<uint8_t>(status);
+    r.a = order.price;
+    r.b = order.filled_size;
+    append(r);
+}
+
+void RunJournal::fill(const Fill& fill) {
+    JournalRecord r;
+    r.event = JournalEvent::FILL;
+    r.timestamp = fill.timestamp;
+    r.id = fill.order_id;
+    r.symbol_id = fill.symbol_id;
+    r.side = static_cast<uint8_t>(fill.side);
+    r.a = fill.price;
+    r.b = fill.volume;
+    r.aux = std::bit_cast<uint64_t>(fill.slippage);
+    append(r);
+}
+
+void RunJournal::risk_halt(RiskRule reason, uint64_t timestamp, double equity, double peak_equity) {
+    JournalRecord r;
+    r.event = JournalEvent::RISK_HALT;
+    r.timestamp = timestamp;
+    r.kind = static_cast<uint8_t>(reason);
+    r.a = equity;
+    r.b = peak_equity;
+    append(r);
+}
+
+void RunJournal::state(JournalEvent event, uint64_t timestamp, uint64_t ticks, uint64_t hash,
+                       double equity, double cash) {
+    JournalRecord r;
+    r.event = event;
+    r.timestamp = timestamp;
+    r.id = ticks;
+    r.aux = hash;
+    r.a = equity;
+    r.b = cash;
+    append(r);
+}
+
+// ========== JournalReader ==========
+
+bool JournalReader::open(const std::string& path) {
+    in_.open(path, std::ios::binary);
+    if (!in_) return false;
+    JournalHeader header;
+    if (!in_.read(reinterpret_cast<char*>(&header), sizeof(header))) return false;
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kVersion ||
+        header.record_size != sizeof(JournalRecord)) {
+        in_.close();
+        return false;
+    }
+    records_ = 0;
+    return true;
+}
+
+bool JournalReader::next(JournalRecord& record) {
+    if (!in_.is_open() || !in_.read(reinterpret_cast<char*>(&record), sizeof(record))) {
+        return false;
+    }
+    ++records_;
+    return true;
+}
+
+std::vector<JournalRecord> read_journal(const std::string& path) {
+    std::vector<JournalRecord> records;
+    JournalReader reader;
+    if (!reader.open(path)) {
+        std::cerr << "[Journal] Cannot read " << path << std::endl;
+        return records;
+    }
+    JournalRecord record;
+    while (reader.next(record)) {
+        records.push_back(record);
+    }
+    return records;
+}
+
+// ========== Diff ==========
+
+JournalDiff diff_journals(const std::string& left_path, const std::string& right_path) {
+    JournalDiff diff;
+    JournalReader left, right;
+    for (auto [reader, path] : {std::pair{&left, &left_path}, std::pair{&right, &right_path}}) {
+        if (!reader->open(*path)) {
+            diff.error = true;
+            diff.message = "cannot read journal " + *path;
+            return diff;
+        }
+    }
+
+    while (true) {
+        diff.has_left = left.next(diff.left);
+        diff.has_right = right.next(diff.right);
+        if (!diff.has_left) diff.left = JournalRecord{};
+        if (!diff.has_right) diff.right = JournalRecord{};
+        if (!diff.has_left && !diff.has_right) {
+            diff.identical = true;
+            diff.message = "identical (" + std::to_string(diff.records_compared) + " records)";
+            return diff;
+        }
+        if (diff.has_left != diff.has_right ||
+            std::memcmp(&diff.left, &diff.right, sizeof(JournalRecord)) != 0) {
+            break;
+        }
+        ++diff.records_compared;
+    }
+
+    diff.index = diff.records_compared;
+    std::ostringstream os;
+    os << "first divergence at record " << diff.index << "\n  left:  ";
+    if (diff.has_left) describe(os, diff.left); else os << "<end of journal>";
+    os << "\n  right: ";
+    if (diff.has_right) describe(os, diff.right); else os << "<end of journal>";
+    diff.message = os.str();
+    return diff;
+}
+
+} // namespace felix
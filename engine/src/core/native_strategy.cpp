@@ -0,0 +1,95 @@
+#include "felix/native_strategy.hpp"
+#include <cstddef>
+#include <type_traits>
+
+namespace felix {
+
+// The C views are the engine's records reinterpreted in place
+static_assert(std::is_standard_layout_v<TickRecord> && std::is_standard_layout_v<Fill>);
+static_assert(sizeof(felix_tick) == sizeof(TickRecord));
+static_assert(offsetof(felix_tick, timestamp) == offsetof(TickRecord, timestamp));
+static_assert(offsetof(felix_tick, symbol_id) == offsetof(TickRecord, symbol_id));
+static_assert(offsetof(felix_tick, price) == offsetof(TickRecord, price));
+static_assert(offsetof(felix_tick, bid) == offsetof(TickRecord, bid));
+static_assert(offsetof(felix_tick, ask) == offsetof(TickRecord, ask));
+static_assert(offsetof(felix_tick, bid_size) == offsetof(TickRecord, bid_size));
+static_assert(offsetof(felix_tick, ask_size) == offsetof(TickRecord, ask_size));
+static_assert(offsetof(felix_tick, volume) == offsetof(TickRecord, volume));
+static_assert(offsetof(felix_tick, symbol_index) == offsetof(TickRecord, symbol_index));
+static_assert(sizeof(felix_fill) == sizeof(Fill) && sizeof(Side) == sizeof(int32_t));
+static_assert(offsetof(felix_fill, order_id) == offsetof(Fill, order_id));
+static_assert(offsetof(felix_fill, symbol_id) == offsetof(Fill, symbol_id));
+static_assert(offsetof(felix_fill, side) == offsetof(Fill, side));
+static_assert(offsetof(felix_fill, price) == offsetof(Fill, price));
+static_assert(offsetof(felix_fill, volume) == offsetof(Fill, volume));
+static_assert(offsetof(felix_fill, timestamp) == offsetof(Fill, timestamp));
+static_assert(offsetof(felix_fill, slippage) == offsetof(Fill, slippage));
+static_assert(offsetof(felix_fill, strategy_id) == offsetof(Fill, strategy_id));
+static_assert(static_cast<int>(Side::SELL) == FELIX_SELL &&
+              static_cast<int>(OrderType::LIMIT) == FELIX_LIMIT &&
+              static_cast<int>(OrderType::STOP) == FELIX_STOP);
+
+NativeStrategy::NativeStrategy(const NativeCallbacks& callbacks, MatchingEngine& engine,
+                               Portfolio& portfolio)
+    : callbacks_(callbacks), engine_(engine), portfolio_(portfolio), context_{&api(), this} {}
+
+const felix_api& NativeStrategy::api() {
+    static const felix_api table{FELIX_STRATEGY_ABI_VERSION, &submit, &cancel, &position, &cash, &equity};
+    return table;
+}
+
+void NativeStrategy::on_tick(const TickRecord& tick) {
+    timestamp_ = tick.timestamp;
+    callbacks_.on_tick(&context_, reinterpret_cast<const felix_tick*>(&tick), callbacks_.state);
+}
+
+void NativeStrategy::on_bar(const TickRecord& bar) {
+    if (!callbacks_.on_bar) return;
+    callbacks_.on_bar(&context_, reinterpret_cast<const felix_tick*>(&bar), callbacks_.state);
+}
+
+void NativeStrategy::on_fill(const Fill& fill) {
+    if (!callbacks_.on_fill) return;
+    callbacks_.on_fill(&context_, reinterpret_cast<const felix_fill*>(&fill), callbacks_.state);
+}
+
+uint64_t NativeStrategy::submit(felix_context* ctx, uint32_t symbol_id, int32_t side, int32_t order_type,
+                                double size, double price, uint64_t timestamp) {
+    NativeStrategy& s = self(ctx);
+    if (size <= 0.0 || (side != FELIX_BUY && side != FELIX_SELL) ||
+        order_type < FELIX_MARKET || order_type > FELIX_STOP) {
+        ++s.orders_rejected_;
+        return 0;
+    }
+
+    Order order;
+    order.symbol_id = symbol_id;
+    order.side = static_cast<Side>(side);
+    order.order_type = static_cast<OrderType>(order_type);
+    order.size = size;
+    // Market orders carry the last price for notional / cash checks
+    order.price = (order_type == FELIX_MARKET) ? s.engine_.get_last_price(symbol_id) : price;
+    order.timestamp = timestamp ? timestamp : s.timestamp_;
+
+    uint64_t id = s.engine_.submit_order(order);
+    ++(id ? s.orders_submitted_ : s.orders_rejected_);
+    return id;
+}
+
+int32_t NativeStrategy::cancel(felix_context* ctx, uint64_t order_id) {
+    return self(ctx).engine_.cancel_order(order_id) ? 1 : 0;
+}
+
+double NativeStrategy::position(felix_context* ctx, uint32_t symbol_id) {
+    return self(ctx).portfolio_.get_position(symbol_id).quantity;
+}
+
+double NativeStrategy::cash(felix_context* ctx) {
+    return self(ctx).portfolio_.cash();
+}
+
+double NativeStrategy::equity(felix_context* ctx) {
+    return self(ctx).portfolio_.equity();
+}
+
+} // namespace felix
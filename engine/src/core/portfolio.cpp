@@ -1,44 +1,92 @@
 #include "felix/portfolio.hpp"
+#include "felix/journal.hpp"
+#include <algorithm>
 #include <cmath>
+#include <iostream>
 
 namespace felix {
 
 Portfolio::Portfolio(double initial_cash) 
-    : cash_(initial_cash), initial_cash_(initial_cash) {
+    : cash_(initial_cash), initial_cash_(initial_cash),
+      equity_curve_(std::make_unique<EquityStore>(recording_.block_size)) {
     // Initialize equity curve with starting point
     EquityPoint initial_point;
     initial_point.timestamp = 0;
     initial_point.equity = initial_cash;
     initial_point.cash = initial_cash;
     initial_point.unrealized_pnl = 0.0;
-    equity_curve_.push_back(initial_point);
+    record_point(initial_point);
+}
+
+bool Portfolio::set_equity_recording_config(const EquityRecordingConfig& config) {
+    recording_ = config;
+
+    // Rebuild the store with the new block size, carrying over recorded points
+    auto store = std::make_unique<EquityStore>(config.block_size);
+    bool ok = true;
+    if (!config.spill_path.empty() && !store->open_spill(config.spill_path)) {
+        std::cerr << "[Portfolio] Equity curve will stay in memory (no spill file)" << std::endl;
+        ok = false;
+    }
+    for (const auto& point : equity_curve_->points()) {
+        store->append(point);
+    }
+    equity_curve_ = std::move(store);
+    return ok;
+}
+
+void Portfolio::register_symbols(const SymbolTable& symbols) {
+    for (uint32_t symbol_id : symbols.symbols()) {
+        slot(symbol_id);
+    }
+}
+
+uint32_t Portfolio::slot(uint32_t symbol_id) {
+    uint32_t index = symbols_.intern(symbol_id);
+    if (index >= quantities_.size()) {
+        quantities_.push_back(0.0);
+        avg_prices_.push_back(0.0);
+        realized_pnls_.push_back(0.0);
+        last_prices_.push_back(0.0);
+        market_values_.push_back(0.0);
+        cost_values_.push_back(0.0);
+    }
+    return index;
 }
 
 void Portfolio::on_fill(const Fill& fill) {
-    Position& pos = positions_[fill.symbol_id];
+    uint32_t index = slot(fill.symbol_id);
+    double& quantity = quantities_[index];
+    double& avg_price = avg_prices_[index];
     
     double trade_value = fill.price * fill.volume;
     double direction = (fill.side == Side::BUY) ? 1.0 : -1.0;
     double signed_qty = fill.volume * direction;
 
     // Update average price
-    if (std::abs(pos.quantity) < 1e-9) {
+    if (std::abs(quantity) < 1e-9) {
         // New position
-        pos.avg_price = fill.price;
-    } else if ((pos.quantity > 0 && fill.side == Side::BUY) ||
-               (pos.quantity < 0 && fill.side == Side::SELL)) {
+        avg_price = fill.price;
+    } else if ((quantity > 0 && fill.side == Side::BUY) ||
+               (quantity < 0 && fill.side == Side::SELL)) {
         // Adding to position
-        double total_value = pos.avg_price * std::abs(pos.quantity) + trade_value;
-        pos.avg_price = total_value / (std::abs(pos.quantity) + fill.volume);
+        double total_value = avg_price * std::abs(quantity) + trade_value;
+        avg_price = total_value / (std::abs(quantity) + fill.volume);
     } else {
         // Reducing/flipping position - realize P&L
-        double closed_qty = std::min(std::abs(pos.quantity), fill.volume);
-        double pnl = closed_qty * (fill.price - pos.avg_price) * (pos.quantity > 0 ? 1.0 : -1.0);
-        pos.realized_pnl += pnl;
+        double closed_qty = std::min(std::abs(quantity), fill.volume);
+        double pnl = closed_qty * (fill.price - avg_price) * (quantity > 0 ? 1.0 : -1.0);
+        realized_pnls_[index] += pnl;
+        realized_pnl_.add(pnl);
+        
+        // Flipped through flat - the remainder is a new position at the fill price
+        if (fill.volume > closed_qty + 1e-9) {
+            avg_price = fill.price;
+        }
     }
 
     // Update quantity
-    pos.quantity += signed_qty;
+    quantity += signed_qty;
     
     // Adjust cash for trade
     if (fill.side == Side::BUY) {
@@ -48,11 +96,105 @@ void Portfolio::on_fill(const Fill& fill) {
     }
 
     // Store last price
-    last_prices_[fill.symbol_id] = fill.price;
+    last_prices_[index] = fill.price;
+    revalue(index);
+    filled_since_record_ = true;
+    fill_log_.push_back(fill);
+    size_t closed_before = ledger_.size();
+    ledger_.on_fill(fill);
+    for (size_t i = closed_before; i < ledger_.size(); ++i) {
+        performance_.on_trade(ledger_.trades()[i].pnl);
+    }
+}
+
+void Portfolio::update_prices(uint32_t symbol_id, double price) {
+    uint32_t index = slot(symbol_id);
+    last_prices_[index] = price;
+    revalue(index);
+}
+
+void Portfolio::update_prices(const uint32_t* symbol_ids, const double* prices, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        last_prices_[slot(symbol_ids[i])] = prices[i];
+    }
+    revalue_all();
+}
+
+void Portfolio::revalue(uint32_t index) {
+    const double quantity = quantities_[index];
+    double market = 0.0;
+    double cost = 0.0;
+    if (std::abs(quantity) > 1e-9) {
+        market = quantity * last_prices_[index];
+        cost = quantity * avg_prices_[index];
+    }
+
+    market_value_.add(market - market_values_[index]);
+    cost_basis_.add(cost - cost_values_[index]);
+    market_values_[index] = market;
+    cost_values_[index] = cost;
+
+    if (consistency_check_) {
+        verify_totals();
+    }
+}
+
+void Portfolio::revalue_all() {
+    BookExposure book = revalue_book(quantities_.data(), avg_prices_.data(), last_prices_.data(),
+                                     market_values_.data(), cost_values_.data(), quantities_.size());
+    market_value_ = RunningSum{};
+    market_value_.add(book.market_value);
+    cost_basis_ = RunningSum{};
+    cost_basis_.add(book.cost_basis);
+
+    if (consistency_check_) {
+        verify_totals();
+    }
 }
 
-void Portfolio::update_prices(uint64_t symbol_id, double price) {
-    last_prices_[symbol_id] = price;
+BookExposure Portfolio::exposure() const {
+    return compute_exposure(quantities_.data(), avg_prices_.data(), last_prices_.data(), quantities_.size());
+}
+
+uint64_t Portfolio::state_hash() const {
+    uint64_t h = hash_bytes(&cash_, sizeof(cash_));
+    for (uint32_t i = 0; i < quantities_.size(); ++i) {
+        uint32_t symbol_id = symbols_.symbol_id(i);
+        h = hash_bytes(&symbol_id, sizeof(symbol_id), h);
+        h = hash_bytes(&quantities_[i], sizeof(double), h);
+        h = hash_bytes(&avg_prices_[i], sizeof(double), h);
+        h = hash_bytes(&realized_pnls_[i], sizeof(double), h);
+    }
+    return h;
+}
+
+void Portfolio::verify_totals() {
+    // Full recomputation over the dense per-symbol arrays
+    double market = 0.0;
+    double unrealized = 0.0;
+    double realized = 0.0;
+    for (size_t i = 0; i < quantities_.size(); ++i) {
+        const double quantity = quantities_[i];
+        realized += realized_pnls_[i];
+        if (std::abs(quantity) > 1e-9) {
+            market += quantity * last_prices_[i];
+            unrealized += quantity * (last_prices_[i] - avg_prices_[i]);
+        }
+    }
+
+    auto matches = [](double running, double full) {
+        double scale = std::max({1.0, std::abs(running), std::abs(full)});
+        return std::abs(running - full) <= 1e-9 * scale;
+    };
+    if (!matches(market_value_.value(), market) ||
+        !matches(total_unrealized_pnl(), unrealized) ||
+        !matches(total_realized_pnl(), realized)) {
+        ++consistency_mismatches_;
+        std::cerr << "[Portfolio] Running totals diverged: market value "
+                  << market_value_.value() << " vs " << market
+                  << ", unrealized " << total_unrealized_pnl() << " vs " << unrealized
+                  << ", realized " << total_realized_pnl() << " vs " << realized << std::endl;
+    }
 }
 
 void Portfolio::append_equity_point(uint64_t timestamp) {
@@ -61,74 +203,90 @@ void Portfolio::append_equity_point(uint64_t timestamp) {
      * "At each mark-to-market step the engine computes total equity 
      *  and pushes a new EquityPoint"
      */
+    double eq = equity();
+    ++mtm_steps_;
+    if (!should_record(timestamp, eq)) {
+        unrecorded_timestamp_ = timestamp;
+        has_unrecorded_ = true;
+        return;
+    }
+
     EquityPoint point;
     point.timestamp = timestamp;
-    point.equity = equity();
+    point.equity = eq;
     point.cash = cash_;
     point.unrealized_pnl = total_unrealized_pnl();
-    equity_curve_.push_back(point);
+    record_point(point);
+    has_unrecorded_ = false;
+    filled_since_record_ = false;
 }
 
-double Portfolio::equity() const {
-    double eq = cash_;
-    for (const auto& [sym, pos] : positions_) {
-        auto price_it = last_prices_.find(sym);
-        if (price_it != last_prices_.end() && std::abs(pos.quantity) > 1e-9) {
-            eq += pos.quantity * price_it->second;
-        }
+void Portfolio::record_point(const EquityPoint& point) {
+    equity_curve_->append(point);
+    performance_.update(point.equity);
+}
+
+bool Portfolio::should_record(uint64_t timestamp, double eq) {
+    const EquityPoint& last = equity_curve_->back();
+    switch (recording_.sampling) {
+        case EquitySampling::EVERY_TICK:
+            return true;
+        case EquitySampling::EVERY_N_TICKS:
+            return recording_.every_n_ticks <= 1 || mtm_steps_ % recording_.every_n_ticks == 0;
+        case EquitySampling::INTERVAL:
+            return timestamp >= last.timestamp + recording_.interval_ns;
+        case EquitySampling::ON_CHANGE:
+            return std::abs(eq - last.equity) > recording_.min_change;
+        case EquitySampling::ON_FILL:
+            return filled_since_record_;
     }
-    return eq;
+    return true;
 }
 
-double Portfolio::unrealized_pnl(uint64_t symbol_id, double current_price) const {
-    auto it = positions_.find(symbol_id);
-    if (it == positions_.end()) return 0.0;
-    
-    const Position& pos = it->second;
-    return pos.quantity * (current_price - pos.avg_price);
+void Portfolio::flush_equity_curve() {
+    if (!has_unrecorded_) return;
+
+    EquityPoint point;
+    point.timestamp = unrecorded_timestamp_;
+    point.equity = equity();
+    point.cash = cash_;
+    point.unrealized_pnl = total_unrealized_pnl();
+    record_point(point);
+    has_unrecorded_ = false;
+    filled_since_record_ = false;
 }
 
-double Portfolio::total_unrealized_pnl() const {
-    double total = 0.0;
-    for (const auto& [sym, pos] : positions_) {
-        auto price_it = last_prices_.find(sym);
-        if (price_it != last_prices_.end() && std::abs(pos.quantity) > 1e-9) {
-            total += pos.quantity * (price_it->second - pos.avg_price);
-        }
-    }
-    return total;
+double Portfolio::unrealized_pnl(uint32_t symbol_id, double current_price) const {
+    uint32_t index = symbols_.find(symbol_id);
+    if (index == SymbolTable::kNoIndex) return 0.0;
+    
+    return quantities_[index] * (current_price - avg_prices_[index]);
 }
 
-double Portfolio::total_realized_pnl() const {
-    double total = 0.0;
-    for (const auto& [sym, pos] : positions_) {
-        total += pos.realized_pnl;
+Position Portfolio::get_position(uint32_t symbol_id) const {
+    Position pos;
+    uint32_t index = symbols_.find(symbol_id);
+    if (index != SymbolTable::kNoIndex) {
+        pos.quantity = quantities_[index];
+        pos.avg_price = avg_prices_[index];
+        pos.realized_pnl = realized_pnls_[index];
     }
-    return total;
+    return pos;
 }
 
-const Position& Portfolio::get_position(uint64_t symbol_id) const {
-    static Position empty = {0, 0, 0};
-    auto it = positions_.find(symbol_id);
-    return (it != positions_.end()) ? it->second : empty;
+std::shared_ptr<const std::vector<EquityPoint>> Portfolio::equity_snapshot() const {
+    if (!equity_cache_ || equity_cache_->size() != equity_curve_->size()) {
+        equity_cache_ = std::make_shared<const std::vector<EquityPoint>>(equity_curve_->points());
+    }
+    return equity_cache_;
 }
 
 std::vector<uint64_t> Portfolio::get_timestamps() const {
-    std::vector<uint64_t> timestamps;
-    timestamps.reserve(equity_curve_.size());
-    for (const auto& point : equity_curve_) {
-        timestamps.push_back(point.timestamp);
-    }
-    return timestamps;
+    return equity_curve_->timestamps();
 }
 
 std::vector<double> Portfolio::get_equity_values() const {
-    std::vector<double> values;
-    values.reserve(equity_curve_.size());
-    for (const auto& point : equity_curve_) {
-        values.push_back(point.equity);
-    }
-    return values;
+    return equity_curve_->equity_values();
 }
 
 } // namespace felix
\ No newline at end of file
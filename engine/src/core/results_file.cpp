@@ -0,0 +1,388 @@
+#include "felix/results_file.hpp"
+#include "felix/column_codec.hpp"
+#include "felix/portfolio.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <iostream>
+
+namespace felix {
+
+namespace {
+
+constexpr char kMagic[8] = {'F', 'E', 'L', 'I', 'X', 'R', 'E', 'S'};
+constexpr uint32_t kVersion = 1;
+constexpr size_t kHeaderBytes = 16;
+
+void put_le(std::vector<uint8_t>& out, uint64_t value, size_t bytes) {
+    for (size_t i = 0; i < bytes; ++i) {
+        out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+    }
+}
+
+uint64_t get_le(const uint8_t* p, size_t bytes) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < bytes; ++i) {
+        value |= static_cast<uint64_t>(p[i]) << (8 * i);
+    }
+    return value;
+}
+
+void put_name(std::vector<uint8_t>& out, const char* name) {
+    size_t len = std::strlen(name);
+    out.push_back(static_cast<uint8_t>(len));
+    out.insert(out.end(), name, name + len);
+}
+
+size_t type_width(ColumnType type) {
+    switch (type) {
+        case ColumnType::U8: return 1;
+        case ColumnType::U32: return 4;
+        case ColumnType::U64: return 8;
+        case ColumnType::F64: return 8;
+    }
+    return 8;
+}
+
+/**
+ * One table chunk: the chunk header, then columns gathered from the rows
+ * with a field accessor and encoded back to back.
+ */
+template <typename Row>
+class ChunkBuilder {
+public:
+    ChunkBuilder(const char* table, const std::vector<Row>& rows, uint8_t columns, bool compress)
+        : rows_(rows), compress_(compress) {
+        put_name(bytes_, table);
+        put_le(bytes_, rows.size(), 4);
+        bytes_.push_back(columns);
+    }
+
+    template <typename Field>
+    void ints(const char* name, ColumnType type, Field field) {
+        ints_.clear();
+        for (const Row& row : rows_) {
+            ints_.push_back(static_cast<uint64_t>(field(row)));
+        }
+        std::vector<uint8_t> data;
+        if (compress_) {
+            encode_deltas(data, ints_.data(), ints_.size());
+        } else {
+            for (uint64_t v : ints_) put_le(data, v, type_width(type));
+        }
+        column(name, type, compress_ ? ColumnCodec::DELTA_VARINT : ColumnCodec::RAW, data);
+    }
+
+    template <typename Field>
+    void doubles(const char* name, Field field) {
+        doubles_.clear();
+        for (const Row& row : rows_) {
+            doubles_.push_back(field(row));
+        }
+        std::vector<uint8_t> data;
+        if (compress_) {
+            encode_doubles(data, doubles_.data(), doubles_.size());
+        } else {
+            for (double v : doubles_) put_le(data, std::bit_cast<uint64_t>(v), 8);
+        }
+        column(name, ColumnType::F64, compress_ ? ColumnCodec::XOR_DOUBLE : ColumnCodec::RAW, data);
+    }
+
+    const std::vector<uint8_t>& bytes() const { return bytes_; }
+
+private:
+    void column(const char* name, ColumnType type, ColumnCodec codec, const std::vector<uint8_t>& data) {
+        put_name(bytes_, name);
+        bytes_.push_back(static_cast<uint8_t>(type));
+        bytes_.push_back(static_cast<uint8_t>(codec));
+        put_le(bytes_, data.size(), 4);
+        bytes_.insert(bytes_.end(), data.begin(), data.end());
+    }
+
+    const std::vector<Row>& rows_;
+    bool compress_;
+    std::vector<uint8_t> bytes_;
+    std::vector<uint64_t> ints_;
+    std::vector<double> doubles_;
+};
+
+// Bounds-checked cursor over the file contents
+struct Cursor {
+    const uint8_t* p;
+    const uint8_t* end;
+
+    bool has(size_t n) const { return static_cast<size_t>(end - p) >= n; }
+    uint64_t le(size_t bytes) {
+        uint64_t v = get_le(p, bytes);
+        p += bytes;
+        return v;
+    }
+    bool name(std::string& out) {
+        if (!has(1)) return false;
+        size_t len = *p++;
+        if (!has(len)) return false;
+        out.assign(reinterpret_cast<const char*>(p), len);
+        p += len;
+        return true;
+    }
+};
+
+bool decode_column(const uint8_t* data, size_t size, size_t rows, ColumnCodec codec,
+                   ResultsColumn& column) {
+    const uint8_t* p = data;
+    if (codec == ColumnCodec::RAW) {
+        size_t width = type_width(column.type);
+        if (size != rows * width) return false;
+        for (size_t i = 0; i < rows; ++i, p += width) {
+            if (column.type == ColumnType::F64) {
+                column.doubles.push_back(std::bit_cast<double>(get_le(p, 8)));
+            } else {
+                column.ints.push_back(get_le(p, width));
+            }
+        }
+        return true;
+    }
+    // Check the framing before decoding, so a corrupt column cannot read past its bytes
+    if (codec == ColumnCodec::DELTA_VARINT && column.type != ColumnType::F64) {
+        size_t ends = 0;
+        for (size_t i = 0; i < size; ++i) ends += (data[i] & 0x80) == 0;
+        if (ends != rows || (size > 0 && (data[size - 1] & 0x80))) return false;
+        decode_deltas(p, rows, column.ints);
+    } else if (codec == ColumnCodec::XOR_DOUBLE && column.type == ColumnType::F64) {
+        size_t pos = 0;
+        for (size_t i = 0; i < rows; ++i) {
+            if (pos >= size) return false;
+            size_t zero_bytes = (data[pos] >> 4) + (data[pos] & 0x0F);
+            if (zero_bytes > 8) return false;
+            pos += 9 - zero_bytes;
+        }
+        if (pos != size) return false;
+        decode_doubles(p, rows, column.doubles);
+    } else {
+        return false;
+    }
+    return p == data + size;
+}
+
+} // namespace
+
+// ========== ResultsWriter ==========
+
+ResultsWriter::~ResultsWriter() {
+    close();
+}
+
+bool ResultsWriter::open(const ResultsFileConfig& config) {
+    close();
+    out_.open(config.path, std::ios::binary | std::ios::trunc);
+    if (!out_) {
+        std::cerr << "[Results] Cannot open " << config.path << std::endl;
+        return false;
+    }
+    config_ = config;
+    if (config_.chunk_rows == 0) config_.chunk_rows = 1;
+
+    std::vector<uint8_t> header(kMagic, kMagic + sizeof(kMagic));
+    put_le(header, kVersion, 4);
+    put_le(header, 0, 4);
+    bytes_ = 0;
+    write(header);
+    fill_rows_ = trade_rows_ = equity_rows_ = 0;
+    pyramid_levels_ = 0;
+    return true;
+}
+
+void ResultsWriter::close() {
+    if (!out_.is_open()) return;
+    flush_fills();
+    flush_trades();
+    flush_equity();
+    out_.close();
+}
+
+void ResultsWriter::write(const std::vector<uint8_t>& chunk) {
+    out_.write(reinterpret_cast<const char*>(chunk.data()), static_cast<std::streamsize>(chunk.size()));
+    bytes_ += chunk.size();
+}
+
+void ResultsWriter::append(const Fill& fill) {
+    if (!out_.is_open()) return;
+    fills_.push_back(fill);
+    ++fill_rows_;
+    if (fills_.size() >= config_.chunk_rows) flush_fills();
+}
+
+void ResultsWriter::append(const Trade& trade) {
+    if (!out_.is_open()) return;
+    trades_.push_back(trade);
+    ++trade_rows_;
+    if (trades_.size() >= config_.chunk_rows) flush_trades();
+}
+
+void ResultsWriter::append(const EquityPoint& point) {
+    if (!out_.is_open()) return;
+    equity_.push_back(point);
+    ++equity_rows_;
+    if (equity_.size() >= config_.chunk_rows) flush_equity();
+}
+
+void ResultsWriter::append(const Portfolio& portfolio) {
+    for (const Fill& fill : portfolio.fills()) append(fill);
+    for (const Trade& trade : portfolio.trades()) append(trade);
+    for (const EquityPoint& point : portfolio.equity_curve()) append(point);
+    append_equity_pyramid(portfolio.equity_store());
+}
+
+void ResultsWriter::append_equity_pyramid(const EquityStore& curve) {
+    if (!out_.is_open() || config_.pyramid.base_points == 0) return;
+    std::vector<uint64_t> timestamps = curve.timestamps();
+    std::vector<double> equity = curve.equity_values();
+    EquityPyramid pyramid = build_equity_pyramid(timestamps.data(), equity.data(), equity.size(),
+                                                 config_.pyramid);
+    for (size_t k = 0; k < pyramid.levels.size(); ++k) {
+        const std::string table = "equity_lod" + std::to_string(k);
+        const std::vector<EquityLevelPoint>& level = pyramid.levels[k];
+        for (size_t begin = 0; begin < level.size(); begin += config_.chunk_rows) {
+            std::vector<EquityLevelPoint> rows(level.begin() + begin,
+                                               level.begin() + std::min<size_t>(begin + config_.chunk_rows, level.size()));
+            ChunkBuilder<EquityLevelPoint> chunk(table.c_str(), rows, 4, config_.compress);
+            chunk.ints("index", ColumnType::U64, [](const EquityLevelPoint& p) { return p.index; });
+            chunk.ints("timestamp", ColumnType::U64, [](const EquityLevelPoint& p) { return p.timestamp; });
+            chunk.doubles("equity", [](const EquityLevelPoint& p) { return p.equity; });
+            chunk.doubles("drawdown", [](const EquityLevelPoint& p) { return p.drawdown; });
+            write(chunk.bytes());
+        }
+    }
+    pyramid_levels_ = pyramid.levels.size();
+}
+
+void ResultsWriter::flush_fills() {
+    if (fills_.empty()) return;
+    ChunkBuilder<Fill> chunk("fills", fills_, 8, config_.compress);
+    chunk.ints("order_id", ColumnType::U64, [](const Fill& f) { return f.order_id; });
+    chunk.ints("symbol_id", ColumnType::U32, [](const Fill& f) { return f.symbol_id; });
+    chunk.ints("side", ColumnType::U8, [](const Fill& f) { return static_cast<uint8_t>(f.side); });
+    chunk.doubles("price", [](const Fill& f) { return f.price; });
+    chunk.doubles("volume", [](const Fill& f) { return f.volume; });
+    chunk.ints("timestamp", ColumnType::U64, [](const Fill& f) { return f.timestamp; });
+    chunk.doubles("slippage", [](const Fill& f) { return f.slippage; });
+    chunk.ints("strategy_id", ColumnType::U32, [](const Fill& f) { return f.strategy_id; });
+    write(chunk.bytes());
+    fills_.clear();
+}
+
+void ResultsWriter::flush_trades() {
+    if (trades_.empty()) return;
+    ChunkBuilder<Trade> chunk("trades", trades_, 12, config_.compress);
+    chunk.ints("entry_order_id", ColumnType::U64, [](const Trade& t) { return t.entry_order_id; });
+    chunk.ints("exit_order_id", ColumnType::U64, [](const Trade& t) { return t.exit_order_id; });
+    chunk.ints("entry_time", ColumnType::U64, [](const Trade& t) { return t.entry_time; });
+    chunk.ints("exit_time", ColumnType::U64, [](const Trade& t) { return t.exit_time; });
+    chunk.ints("holding_ns", ColumnType::U64, [](const Trade& t) { return t.holding_ns; });
+    chunk.ints("symbol_id", ColumnType::U32, [](const Trade& t) { return t.symbol_id; });
+    chunk.ints("side", ColumnType::U8, [](const Trade& t) { return static_cast<uint8_t>(t.side); });
+    chunk.doubles("quantity", [](const Trade& t) { return t.quantity; });
+    chunk.doubles("entry_price", [](const Trade& t) { return t.entry_price; });
+    chunk.doubles("exit_price", [](const Trade& t) { return t.exit_price; });
+    chunk.doubles("pnl", [](const Trade& t) { return t.pnl; });
+    chunk.doubles("return_pct", [](const Trade& t) { return t.return_pct; });
+    write(chunk.bytes());
+    trades_.clear();
+}
+
+void ResultsWriter::flush_equity() {
+    if (equity_.empty()) return;
+    ChunkBuilder<EquityPoint> chunk("equity", equity_, 4, config_.compress);
+    chunk.ints("timestamp", ColumnType::U64, [](const EquityPoint& p) { return p.timestamp; });
+    chunk.doubles("equity", [](const EquityPoint& p) { return p.equity; });
+    chunk.doubles("cash", [](const EquityPoint& p) { return p.cash; });
+    chunk.doubles("unrealized_pnl", [](const EquityPoint& p) { return p.unrealized_pnl; });
+    write(chunk.bytes());
+    equity_.clear();
+}
+
+bool write_results(const std::string& path, const Portfolio& portfolio, bool compress) {
+    ResultsWriter writer;
+    ResultsFileConfig config;
+    config.path = path;
+    config.compress = compress;
+    if (!writer.open(config)) return false;
+    writer.append(portfolio);
+    writer.close();
+    return true;
+}
+
+// ========== Reader ==========
+
+std::vector<ResultsTable> read_results(const std::string& path, const std::vector<std::string>& only) {
+    std::vector<ResultsTable> tables;
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        std::cerr << "[Results] Cannot read " << path << std::endl;
+        return tables;
+    }
+    std::vector<uint8_t> file((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    if (file.size() < kHeaderBytes || std::memcmp(file.data(), kMagic, sizeof(kMagic)) != 0 ||
+        get_le(file.data() + 8, 4) != kVersion) {
+        std::cerr << "[Results] Not a results file: " << path << std::endl;
+        return tables;
+    }
+
+    Cursor c{file.data() + kHeaderBytes, file.data() + file.size()};
+    while (c.p < c.end) {
+        // Decode into a scratch table so a truncated chunk leaves no partial rows
+        ResultsTable chunk;
+        if (!c.name(chunk.name) || !c.has(5)) break;
+        chunk.rows = c.le(4);
+        size_t column_count = *c.p++;
+        // Other tables' chunks are stepped over without decoding
+        const bool wanted = only.empty() || std::find(only.begin(), only.end(), chunk.name) != only.end();
+        bool ok = true;
+        for (size_t i = 0; i < column_count && ok; ++i) {
+            ResultsColumn column;
+            ok = c.name(column.name) && c.has(6);
+            if (!ok) break;
+            column.type = static_cast<ColumnType>(*c.p++);
+            ColumnCodec codec = static_cast<ColumnCodec>(*c.p++);
+            size_t size = c.le(4);
+            ok = c.has(size) && (!wanted || decode_column(c.p, size, chunk.rows, codec, column));
+            c.p += ok ? size : 0;
+            chunk.columns.push_back(std::move(column));
+        }
+        if (!ok) {
+            std::cerr << "[Results] Truncated or corrupt chunk in " << path
+                      << ", keeping the chunks before it" << std::endl;
+            break;
+        }
+        if (!wanted) continue;
+
+        ResultsTable* table = nullptr;
+        for (ResultsTable& t : tables) {
+            if (t.name == chunk.name) table = &t;
+        }
+        if (!table) {
+            tables.push_back(std::move(chunk));
+            continue;
+        }
+        bool same_layout = table->columns.size() == chunk.columns.size();
+        for (size_t i = 0; same_layout && i < chunk.columns.size(); ++i) {
+            same_layout = table->columns[i].name == chunk.columns[i].name &&
+                          table->columns[i].type == chunk.columns[i].type;
+        }
+        if (!same_layout) {
+            std::cerr << "[Results] Skipping a '" << chunk.name
+                      << "' chunk with different columns in " << path << std::endl;
+            continue;
+        }
+        for (size_t i = 0; i < chunk.columns.size(); ++i) {
+            ResultsColumn& dst = table->columns[i];
+            ResultsColumn& src = chunk.columns[i];
+            dst.ints.insert(dst.ints.end(), src.ints.begin(), src.ints.end());
+            dst.doubles.insert(dst.doubles.end(), src.doubles.begin(), src.doubles.end());
+        }
+        table->rows += chunk.rows;
+    }
+    return tables;
+}
+
+} // namespace felix
@@ -0,0 +1,171 @@
+#include "felix/revaluation.hpp"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+namespace felix {
+
+namespace {
+
+constexpr double kFlatQuantity = 1e-9;
+
+template <bool kWrite>
+void revalue_scalar(const double* quantity, const double* avg_price, const double* last_price,
+                    double* market_value, double* cost_value, size_t begin, size_t n,
+                    BookExposure& out) {
+    for (size_t i = begin; i < n; ++i) {
+        const double q = quantity[i];
+        double market = 0.0;
+        double cost = 0.0;
+        if (std::abs(q) > kFlatQuantity) {
+            market = q * last_price[i];
+            cost = q * avg_price[i];
+            if (q > 0.0) {
+                ++out.long_positions;
+            } else {
+                ++out.short_positions;
+            }
+        }
+        if constexpr (kWrite) {
+            market_value[i] = market;
+            cost_value[i] = cost;
+        }
+        out.market_value += market;
+        out.cost_basis += cost;
+        out.gross_exposure += std::abs(market);
+        out.long_exposure += std::max(market, 0.0);
+        out.short_exposure += std::min(market, 0.0);
+    }
+}
+
+#if defined(__AVX512F__)
+double reduce(__m512d v) { return _mm512_reduce_add_pd(v); }
+
+template <bool kWrite>
+void revalue_simd(const double* quantity, const double* avg_price, const double* last_price,
+                  double* market_value, double* cost_value, size_t n, BookExposure& out) {
+    const __m512d zero = _mm512_setzero_pd();
+    const __m512d flat = _mm512_set1_pd(kFlatQuantity);
+    const __m512d neg_flat = _mm512_set1_pd(-kFlatQuantity);
+    __m512d net = zero, cost_sum = zero, gross = zero, longs = zero, shorts = zero;
+    uint64_t long_count = 0, short_count = 0;
+
+    for (size_t i = 0; i < n; i += 8) {
+        // Masked loads cover the tail without a scalar loop
+        const __mmask8 lanes = (n - i >= 8) ? __mmask8(0xFF) : __mmask8((1u << (n - i)) - 1);
+        __m512d q = _mm512_maskz_loadu_pd(lanes, quantity + i);
+        __m512d last = _mm512_maskz_loadu_pd(lanes, last_price + i);
+        __m512d avg = _mm512_maskz_loadu_pd(lanes, avg_price + i);
+
+        __mmask8 is_long = _mm512_cmp_pd_mask(q, flat, _CMP_GT_OQ);
+        __mmask8 is_short = _mm512_cmp_pd_mask(q, neg_flat, _CMP_LT_OQ);
+        __mmask8 active = is_long | is_short;
+        long_count += std::popcount(static_cast<unsigned>(is_long));
+        short_count += std::popcount(static_cast<unsigned>(is_short));
+
+        __m512d market = _mm512_maskz_mul_pd(active, q, last);
+        __m512d cost = _mm512_maskz_mul_pd(active, q, avg);
+        if constexpr (kWrite) {
+            _mm512_mask_storeu_pd(market_value + i, lanes, market);
+            _mm512_mask_storeu_pd(cost_value + i, lanes, cost);
+        }
+        net = _mm512_add_pd(net, market);
+        cost_sum = _mm512_add_pd(cost_sum, cost);
+        gross = _mm512_add_pd(gross, _mm512_abs_pd(market));
+        longs = _mm512_add_pd(longs, _mm512_max_pd(market, zero));
+        shorts = _mm512_add_pd(shorts, _mm512_min_pd(market, zero));
+    }
+
+    out.market_value = reduce(net);
+    out.cost_basis = reduce(cost_sum);
+    out.gross_exposure = reduce(gross);
+    out.long_exposure = reduce(longs);
+    out.short_exposure = reduce(shorts);
+    out.long_positions = long_count;
+    out.short_positions = short_count;
+}
+#elif defined(__AVX2__)
+double reduce(__m256d v) {
+    __m128d lo = _mm256_castpd256_pd128(v);
+    __m128d hi = _mm256_extractf128_pd(v, 1);
+    lo = _mm_add_pd(lo, hi);
+    return _mm_cvtsd_f64(_mm_add_sd(lo, _mm_unpackhi_pd(lo, lo)));
+}
+
+template <bool kWrite>
+void revalue_simd(const double* quantity, const double* avg_price, const double* last_price,
+                  double* market_value, double* cost_value, size_t n, BookExposure& out) {
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d flat = _mm256_set1_pd(kFlatQuantity);
+    const __m256d neg_flat = _mm256_set1_pd(-kFlatQuantity);
+    const __m256d sign = _mm256_set1_pd(-0.0);
+    __m256d net = zero, cost_sum = zero, gross = zero, longs = zero, shorts = zero;
+    uint64_t long_count = 0, short_count = 0;
+
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d q = _mm256_loadu_pd(quantity + i);
+        __m256d last = _mm256_loadu_pd(last_price + i);
+        __m256d avg = _mm256_loadu_pd(avg_price + i);
+
+        __m256d is_long = _mm256_cmp_pd(q, flat, _CMP_GT_OQ);
+        __m256d is_short = _mm256_cmp_pd(q, neg_flat, _CMP_LT_OQ);
+        __m256d active = _mm256_or_pd(is_long, is_short);
+        long_count += std::popcount(static_cast<unsigned>(_mm256_movemask_pd(is_long)));
+        short_count += std::popcount(static_cast<unsigned>(_mm256_movemask_pd(is_short)));
+
+        __m256d market = _mm256_and_pd(active, _mm256_mul_pd(q, last));
+        __m256d cost = _mm256_and_pd(active, _mm256_mul_pd(q, avg));
+        if constexpr (kWrite) {
+            _mm256_storeu_pd(market_value + i, market);
+            _mm256_storeu_pd(cost_value + i, cost);
+        }
+        net = _mm256_add_pd(net, market);
+        cost_sum = _mm256_add_pd(cost_sum, cost);
+        gross = _mm256_add_pd(gross, _mm256_andnot_pd(sign, market));
+        longs = _mm256_add_pd(longs, _mm256_max_pd(market, zero));
+        shorts = _mm256_add_pd(shorts, _mm256_min_pd(market, zero));
+    }
+
+    out.market_value = reduce(net);
+    out.cost_basis = reduce(cost_sum);
+    out.gross_exposure = reduce(gross);
+    out.long_exposure = reduce(longs);
+    out.short_exposure = reduce(shorts);
+    out.long_positions = long_count;
+    out.short_positions = short_count;
+    revalue_scalar<kWrite>(quantity, avg_price, last_price, market_value, cost_value, i, n, out);
+}
+#endif
+
+template <bool kWrite>
+BookExposure revalue(const double* quantity, const double* avg_price, const double* last_price,
+                     double* market_value, double* cost_value, size_t n) {
+    BookExposure out;
+#if defined(__AVX512F__) || defined(__AVX2__)
+    revalue_simd<kWrite>(quantity, avg_price, last_price, market_value, cost_value, n, out);
+#else
+    revalue_scalar<kWrite>(quantity, avg_price, last_price, market_value, cost_value, 0, n, out);
+#endif
+    out.unrealized_pnl = out.market_value - out.cost_basis;
+    return out;
+}
+
+} // namespace
+
+BookExposure compute_exposure(const double* quantity, const double* avg_price,
+                              const double* last_price, size_t n) {
+    return revalue<false>(quantity, avg_price, last_price, nullptr, nullptr, n);
+}
+
+BookExposure revalue_book(const double* quantity, const double* avg_price,
+                          const double* last_price, double* market_value,
+                          double* cost_value, size_t n) {
+    return revalue<true>(quantity, avg_price, last_price, market_value, cost_value, n);
+}
+
+} // namespace felix
@@ -0,0 +1,143 @@
+#include "felix/signal_strategy.hpp"
+#include <cmath>
+
+namespace felix {
+
+SignalStrategy::SignalStrategy(const DataStream& stream, const SignalSchedule& schedule,
+                               MatchingEngine& engine, Portfolio& portfolio)
+    : stream_(stream), schedule_(schedule), engine_(engine), portfolio_(portfolio) {}
+
+void SignalStrategy::on_start() {
+    cursor_ = 0;
+    outstanding_.assign(stream_.symbols().size(), 0.0);
+    working_.clear();
+    history_seen_ = engine_.order_history().size();
+}
+
+bool SignalStrategy::should_wake(const TickRecord& tick) {
+    if (schedule_.timestamps) {
+        return cursor_ < schedule_.count && schedule_.timestamps[cursor_] <= tick.timestamp;
+    }
+    // Ticks are references into the stream, so the offset is the tick's index
+    size_t index = static_cast<size_t>(&tick - stream_.data());
+    return index < schedule_.count && !std::isnan(schedule_.values[index]);
+}
+
+void SignalStrategy::on_tick(const TickRecord& tick) {
+    reconcile();
+    if (!schedule_.timestamps) {
+        apply(tick.symbol_id, schedule_.values[&tick - stream_.data()], tick.timestamp);
+        return;
+    }
+    for (; cursor_ < schedule_.count && schedule_.timestamps[cursor_] <= tick.timestamp; ++cursor_) {
+        double value = schedule_.values[cursor_];
+        if (std::isnan(value)) continue;
+        uint32_t symbol_id = schedule_.symbol_ids ? schedule_.symbol_ids[cursor_] : tick.symbol_id;
+        apply(symbol_id, value, tick.timestamp);
+    }
+}
+
+void SignalStrategy::apply(uint32_t symbol_id, double value, uint64_t timestamp) {
+    uint32_t index = stream_.symbols().find(symbol_id);
+    if (index == SymbolTable::kNoIndex) return;   // Symbol not in this stream
+    ++signals_applied_;
+
+    if (schedule_.cancel_unfilled) {
+        for (const auto& [order_id, order_index] : working_) {
+            if (order_index == index) engine_.cancel_order(order_id);
+        }
+        reconcile();
+    }
+
+    double quantity = value;
+    if (schedule_.mode == SignalMode::TARGET_POSITION) {
+        quantity = value - portfolio_.get_position(symbol_id).quantity - outstanding_[index];
+    }
+    if (std::abs(quantity) < schedule_.min_trade_size) return;
+
+    Order order;
+    order.symbol_id = symbol_id;
+    order.side = (quantity > 0.0) ? Side::BUY : Side::SELL;
+    order.order_type = OrderType::MARKET;
+    order.size = std::abs(quantity);
+    order.price = engine_.get_last_price(symbol_id);   // For notional / cash checks
+    order.timestamp = timestamp;
+
+    uint64_t order_id = engine_.submit_order(order);
+    if (order_id != 0) {
+        outstanding_[index] += quantity;
+        working_.emplace(order_id, index);
+        ++orders_submitted_;
+    } else {
+        ++orders_rejected_;
+    }
+}
+
+void SignalStrategy::on_fill(const Fill& fill) {
+    uint32_t index = stream_.symbols().find(fill.symbol_id);
+    if (index == SymbolTable::kNoIndex) return;
+    outstanding_[index] -= (fill.side == Side::BUY) ? fill.volume : -fill.volume;
+    if (std::abs(outstanding_[index]) < 1e-9) {
+        outstanding_[index] = 0.0;
+    }
+}
+
+void SignalStrategy::reconcile() {
+    /**
+     * Section 7 - Closed orders leave the outstanding quantity.
+     * Fills are already netted in on_fill; whatever an order left unfilled
+     * when it was cancelled or rejected is dropped here.
+     */
+    const std::vector<Order>& history = engine_.order_history();
+    for (; history_seen_ < history.size(); ++history_seen_) {
+        const Order& order = history[history_seen_];
+        auto it = working_.find(order.order_id);
+        if (it == working_.end()) continue;
+
+        uint32_t index = it->second;
+        working_.erase(it);
+        double unfilled = order.remaining();
+        outstanding_[index] -= (order.side == Side::BUY) ? unfilled : -unfilled;
+        if (std::abs(outstanding_[index]) < 1e-9) {
+            outstanding_[index] = 0.0;
+        }
+    }
+}
+
+SignalBacktestRun run_signal_backtest(const DataStream& stream, const double* signals,
+                                      const SignalBacktestConfig& config, bool keep_curve) {
+    DataStream window = stream.view(0, stream.size());   // Own cursor
+
+    MatchingEngine engine(config.slippage);
+    engine.set_latency_config(config.latency);
+    engine.set_verbose(false);
+
+    Portfolio portfolio(config.initial_capital);
+    EquityRecordingConfig recording = config.recording;
+    recording.spill_path.clear();   // Concurrent runs must not share a spill file
+    portfolio.set_equity_recording_config(recording);
+
+    RiskEngine risk(config.risk_limits);
+    risk.set_verbose(false);
+    EventLoop loop;
+    loop.set_verbose(false);
+    loop.set_matching_engine(&engine);
+    loop.set_portfolio(&portfolio);
+    if (config.use_risk) loop.set_risk_engine(&risk);
+
+    SignalSchedule schedule;
+    schedule.mode = config.mode;
+    schedule.values = signals;
+    schedule.count = window.size();
+    schedule.min_trade_size = config.min_trade_size;
+
+    SignalBacktestRun run;
+    run.orders = loop.run_signals(window, schedule);
+    run.summary = portfolio.performance_summary(config.risk_free_rate, config.periods_per_year);
+    if (keep_curve) {
+        run.curve = portfolio.equity_curve();
+    }
+    return run;
+}
+
+} // namespace felix
@@ -0,0 +1,25 @@
+#include "felix/symbol_table.hpp"
+
+namespace felix {
+
+uint32_t SymbolTable::intern(uint32_t symbol_id) {
+    uint32_t index = find(symbol_id);
+    if (index != kNoIndex) {
+        return index;
+    }
+
+    index = static_cast<uint32_t>(symbols_.size());
+    symbols_.push_back(symbol_id);
+
+    if (symbol_id < kDirectLimit) {
+        if (symbol_id >= direct_.size()) {
+            direct_.resize(symbol_id + 1, kNoIndex);
+        }
+        direct_[symbol_id] = index;
+    } else {
+        sparse_.emplace(symbol_id, index);
+    }
+    return index;
+}
+
+} // namespace felix
@@ -0,0 +1,85 @@
+#include "felix/tick_window.hpp"
+
+namespace felix {
+
+TickWindow::TickWindow(const TickWindowConfig& config) : config_(config) {}
+
+void TickWindow::set_config(const TickWindowConfig& config) {
+    config_ = config;
+    symbols_ = SymbolTable();
+    slots_.clear();
+}
+
+TickWindow::Slot& TickWindow::slot(uint32_t symbol_id) {
+    uint32_t index = symbols_.intern(symbol_id);
+    if (index >= slots_.size()) {
+        const bool bars = config_.bar_ns > 0;
+        slots_.push_back(Slot{MirroredRing<TickRecord>(config_.tick_capacity),
+                              MirroredRing<WindowBar>(bars ? config_.bar_capacity : 0),
+                              WindowBar{}, false});
+    }
+    return slots_[index];
+}
+
+void TickWindow::register_symbols(const SymbolTable& symbols) {
+    for (uint32_t symbol_id : symbols.symbols()) {
+        slot(symbol_id);
+    }
+}
+
+void TickWindow::clear() {
+    for (Slot& s : slots_) {
+        s.ticks.clear();
+        s.bars.clear();
+        s.bar_open = false;
+    }
+}
+
+void TickWindow::update(const TickRecord& tick) {
+    Slot& s = slot(tick.symbol_id);
+    s.ticks.push(tick);
+
+    if (s.bars.capacity() == 0) return;
+
+    // A tick in a new interval completes the pending bar
+    const uint64_t start = tick.timestamp - tick.timestamp % config_.bar_ns;
+    const double price = tick.price;
+    WindowBar& bar = s.pending;
+    if (s.bar_open && start != bar.timestamp) {
+        s.bars.push(bar);
+        s.bar_open = false;
+    }
+    if (!s.bar_open) {
+        bar = WindowBar{start, tick.symbol_id, 1, price, price, price, price,
+                        static_cast<double>(tick.volume)};
+        s.bar_open = true;
+        return;
+    }
+    bar.high = std::max(bar.high, price);
+    bar.low = std::min(bar.low, price);
+    bar.close = price;
+    bar.volume += tick.volume;
+    ++bar.ticks;
+}
+
+const TickRecord* TickWindow::ticks(uint32_t symbol_id, size_t& count) const {
+    uint32_t index = symbols_.find(symbol_id);
+    if (index == SymbolTable::kNoIndex) {
+        count = 0;
+        return nullptr;
+    }
+    count = slots_[index].ticks.size();
+    return slots_[index].ticks.data();
+}
+
+const WindowBar* TickWindow::bars(uint32_t symbol_id, size_t& count) const {
+    uint32_t index = symbols_.find(symbol_id);
+    if (index == SymbolTable::kNoIndex) {
+        count = 0;
+        return nullptr;
+    }
+    count = slots_[index].bars.size();
+    return slots_[index].bars.data();
+}
+
+} // namespace felix
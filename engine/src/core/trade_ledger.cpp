@@ -0,0 +1,87 @@
+#include "felix/trade_ledger.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace felix {
+
+TradeLedger::TradeLedger(LotMatching matching) : matching_(matching) {}
+
+void TradeLedger::on_fill(const Fill& fill) {
+    uint32_t index = symbols_.intern(fill.symbol_id);
+    if (index >= books_.size()) {
+        books_.resize(index + 1);
+    }
+    Book& book = books_[index];
+
+    const double fill_direction = (fill.side == Side::BUY) ? 1.0 : -1.0;
+    double remaining = fill.volume;
+
+    if (std::abs(book.position) >= kMinQuantity && book.position * fill_direction < 0.0) {
+        // Opposing fill - close lots until the fill or the position runs out
+        const double direction = (book.position > 0.0) ? 1.0 : -1.0;
+        while (remaining >= kMinQuantity && !book.lots.empty()) {
+            Lot& lot = book.lots.front();
+            double quantity = std::min(lot.quantity, remaining);
+            close_lot(lot, fill, quantity, direction);
+            remaining -= quantity;
+            book.position -= direction * quantity;
+            if (lot.quantity < kMinQuantity) {
+                book.lots.pop_front();
+            }
+        }
+        if (book.lots.empty()) {
+            book.position = 0.0;
+        }
+    }
+
+    // Same-direction fill, or the excess of a flip
+    if (remaining >= kMinQuantity) {
+        open_lot(book, fill, remaining);
+        book.position += fill_direction * remaining;
+    }
+}
+
+void TradeLedger::open_lot(Book& book, const Fill& fill, double quantity) {
+    if (matching_ == LotMatching::AVERAGE_COST && !book.lots.empty()) {
+        // Same arithmetic as Portfolio's average price, so P&L agrees exactly
+        Lot& lot = book.lots.front();
+        double total_value = lot.price * lot.quantity + fill.price * quantity;
+        lot.price = total_value / (lot.quantity + quantity);
+        lot.quantity += quantity;
+        return;
+    }
+
+    Lot lot;
+    lot.quantity = quantity;
+    lot.price = fill.price;
+    lot.timestamp = fill.timestamp;
+    lot.order_id = fill.order_id;
+    book.lots.push_back(lot);
+}
+
+void TradeLedger::close_lot(Lot& lot, const Fill& fill, double quantity, double direction) {
+    Trade trade;
+    trade.entry_order_id = lot.order_id;
+    trade.exit_order_id = fill.order_id;
+    trade.entry_time = lot.timestamp;
+    trade.exit_time = fill.timestamp;
+    trade.holding_ns = (fill.timestamp > lot.timestamp) ? fill.timestamp - lot.timestamp : 0;
+    trade.symbol_id = fill.symbol_id;
+    trade.side = (direction > 0.0) ? Side::BUY : Side::SELL;
+    trade.quantity = quantity;
+    trade.entry_price = lot.price;
+    trade.exit_price = fill.price;
+    trade.pnl = quantity * (fill.price - lot.price) * direction;
+    trade.return_pct = (lot.price != 0.0) ? (fill.price / lot.price - 1.0) * direction * 100.0 : 0.0;
+
+    trades_.push_back(trade);
+    realized_pnl_ += trade.pnl;
+    lot.quantity -= quantity;
+}
+
+double TradeLedger::open_quantity(uint32_t symbol_id) const {
+    uint32_t index = symbols_.find(symbol_id);
+    return (index != SymbolTable::kNoIndex && index < books_.size()) ? books_[index].position : 0.0;
+}
+
+} // namespace felix
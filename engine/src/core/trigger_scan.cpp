@@ -0,0 +1,136 @@
+#include "felix/trigger_scan.hpp"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace felix {
+
+void TriggerEnvelope::reset(size_t num_symbols) {
+    lo.assign(num_symbols, -std::numeric_limits<float>::infinity());
+    hi.assign(num_symbols, std::numeric_limits<float>::infinity());
+    next_time = UINT64_MAX;
+}
+
+void TriggerEnvelope::trigger_at_or_below(uint32_t index, double price) {
+    // Round up so every float <= price also tests <= bound
+    float bound = static_cast<float>(price);
+    if (bound < price) {
+        bound = std::nextafter(bound, std::numeric_limits<float>::infinity());
+    }
+    lo[index] = std::max(lo[index], bound);
+}
+
+void TriggerEnvelope::trigger_at_or_above(uint32_t index, double price) {
+    // Round down so every float >= price also tests >= bound
+    float bound = static_cast<float>(price);
+    if (bound > price) {
+        bound = std::nextafter(bound, -std::numeric_limits<float>::infinity());
+    }
+    hi[index] = std::min(hi[index], bound);
+}
+
+void TriggerEnvelope::trigger_always(uint32_t index) {
+    lo[index] = std::numeric_limits<float>::infinity();
+}
+
+void TriggerEnvelope::trigger_at_time(uint64_t timestamp) {
+    next_time = std::min(next_time, timestamp);
+}
+
+namespace {
+
+bool may_trigger(const TickRecord& tick, const TriggerEnvelope& envelope) {
+    if (tick.timestamp >= envelope.next_time) {
+        return true;
+    }
+
+    // Missing quotes fall back to the last price, as in the matching engine
+    float bid = (tick.bid > 0) ? tick.bid : tick.price;
+    float ask = (tick.ask > 0) ? tick.ask : tick.price;
+    float low = std::min(tick.price, std::min(bid, ask));
+    float high = std::max(tick.price, std::max(bid, ask));
+
+    return low <= envelope.lo[tick.symbol_index] || high >= envelope.hi[tick.symbol_index];
+}
+
+#if defined(__AVX2__)
+// Eight ticks per iteration: gather price/bid/ask, symbol bands and timestamps
+size_t scan_avx2(const TickRecord* ticks, size_t n, const TriggerEnvelope& envelope) {
+    constexpr int kStride = sizeof(TickRecord);
+    const __m256i offsets = _mm256_setr_epi32(0, kStride, 2 * kStride, 3 * kStride,
+                                              4 * kStride, 5 * kStride, 6 * kStride, 7 * kStride);
+    const __m128i ts_offsets_lo = _mm_setr_epi32(0, kStride, 2 * kStride, 3 * kStride);
+    const __m128i ts_offsets_hi = _mm_setr_epi32(4 * kStride, 5 * kStride, 6 * kStride, 7 * kStride);
+    const __m256 zero = _mm256_setzero_ps();
+
+    // Timestamps compare as signed 64-bit; clamp the "no timer" sentinel
+    const uint64_t next_time = std::min<uint64_t>(envelope.next_time, INT64_MAX);
+    const __m256i next = _mm256_set1_epi64x(static_cast<long long>(next_time));
+
+    const float* lo = envelope.lo.data();
+    const float* hi = envelope.hi.data();
+
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const char* base = reinterpret_cast<const char*>(ticks + i);
+
+        __m256 price = _mm256_i32gather_ps(
+            reinterpret_cast<const float*>(base + offsetof(TickRecord, price)), offsets, 1);
+        __m256 bid = _mm256_i32gather_ps(
+            reinterpret_cast<const float*>(base + offsetof(TickRecord, bid)), offsets, 1);
+        __m256 ask = _mm256_i32gather_ps(
+            reinterpret_cast<const float*>(base + offsetof(TickRecord, ask)), offsets, 1);
+        bid = _mm256_blendv_ps(price, bid, _mm256_cmp_ps(bid, zero, _CMP_GT_OQ));
+        ask = _mm256_blendv_ps(price, ask, _mm256_cmp_ps(ask, zero, _CMP_GT_OQ));
+        __m256 low = _mm256_min_ps(price, _mm256_min_ps(bid, ask));
+        __m256 high = _mm256_max_ps(price, _mm256_max_ps(bid, ask));
+
+        __m256i symbol = _mm256_i32gather_epi32(
+            reinterpret_cast<const int*>(base + offsetof(TickRecord, symbol_index)), offsets, 1);
+        __m256 band_lo = _mm256_i32gather_ps(lo, symbol, 4);
+        __m256 band_hi = _mm256_i32gather_ps(hi, symbol, 4);
+
+        __m256 hit = _mm256_or_ps(_mm256_cmp_ps(low, band_lo, _CMP_LE_OQ),
+                                  _mm256_cmp_ps(high, band_hi, _CMP_GE_OQ));
+        unsigned mask = static_cast<unsigned>(_mm256_movemask_ps(hit));
+
+        const long long* ts = reinterpret_cast<const long long*>(base + offsetof(TickRecord, timestamp));
+        __m256i ts_lo = _mm256_i32gather_epi64(ts, ts_offsets_lo, 1);
+        __m256i ts_hi = _mm256_i32gather_epi64(ts, ts_offsets_hi, 1);
+        unsigned before = static_cast<unsigned>(
+            _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(next, ts_lo))) |
+            (_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(next, ts_hi))) << 4));
+        mask |= ~before & 0xFFu;
+
+        if (mask) {
+            return i + std::countr_zero(mask);
+        }
+    }
+
+    for (; i < n; ++i) {
+        if (may_trigger(ticks[i], envelope)) return i;
+    }
+    return n;
+}
+#endif
+
+} // namespace
+
+size_t find_first_trigger(const TickRecord* ticks, size_t n, const TriggerEnvelope& envelope) {
+#if defined(__AVX2__)
+    return scan_avx2(ticks, n, envelope);
+#else
+    for (size_t i = 0; i < n; ++i) {
+        if (may_trigger(ticks[i], envelope)) return i;
+    }
+    return n;
+#endif
+}
+
+} // namespace felix
@@ -0,0 +1,165 @@
+#include "felix/walk_forward.hpp"
+#include "felix/parallel.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+
+namespace felix {
+
+namespace {
+
+struct FoldBounds {
+    size_t is_begin, is_end, oos_begin, oos_end;
+};
+
+// Settings shared by every in-sample and out-of-sample run
+SignalBacktestConfig fold_backtest(const WalkForwardConfig& config) {
+    SignalBacktestConfig backtest;
+    backtest.initial_capital = config.initial_capital;
+    backtest.slippage = config.slippage;
+    backtest.latency = config.latency;
+    backtest.use_risk = config.use_risk;
+    backtest.risk_limits = config.risk_limits;
+    backtest.recording = config.recording;
+    backtest.mode = config.mode;
+    backtest.min_trade_size = config.min_trade_size;
+    backtest.risk_free_rate = config.risk_free_rate;
+    backtest.periods_per_year = config.periods_per_year;
+    return backtest;
+}
+
+} // namespace
+
+double walk_forward_score(const PerformanceSummary& s, WalkForwardMetric metric) {
+    double score = 0.0;
+    switch (metric) {
+        case WalkForwardMetric::SHARPE: score = s.sharpe_ratio; break;
+        case WalkForwardMetric::SORTINO: score = s.sortino_ratio; break;
+        case WalkForwardMetric::TOTAL_RETURN: score = s.total_return_pct; break;
+        case WalkForwardMetric::CAGR: score = s.cagr; break;
+        case WalkForwardMetric::MAX_DRAWDOWN: score = -s.max_drawdown; break;
+        case WalkForwardMetric::PROFIT_FACTOR: score = s.profit_factor; break;
+    }
+    // Undefined ratios never win
+    return std::isnan(score) ? -std::numeric_limits<double>::infinity() : score;
+}
+
+WalkForwardResult walk_forward(const DataStream& stream,
+                               const std::vector<const double*>& candidates,
+                               const WalkForwardConfig& config) {
+    WalkForwardResult result;
+    result.candidates = candidates.size();
+    if (stream.size() == 0 || candidates.empty() ||
+        config.in_sample_ns == 0 || config.out_of_sample_ns == 0) {
+        std::cerr << "[WalkForward] ERROR: need ticks, candidates and non-zero window lengths" << std::endl;
+        return result;
+    }
+
+    // Fold boundaries, stepping by the out-of-sample length
+    const TickRecord* ticks = stream.data();
+    const uint64_t first = ticks[0].timestamp;
+    const uint64_t last = ticks[stream.size() - 1].timestamp;
+    std::vector<FoldBounds> bounds;
+    for (uint64_t offset = 0;; offset += config.out_of_sample_ns) {
+        uint64_t oos_start = first + offset + config.in_sample_ns;
+        if (oos_start > last) break;
+        uint64_t is_start = config.anchored ? first : first + offset;
+        uint64_t oos_end = oos_start + config.out_of_sample_ns;
+
+        FoldBounds b{stream.lower_bound(is_start), stream.lower_bound(oos_start),
+                     stream.lower_bound(oos_start), stream.lower_bound(oos_end)};
+        if (b.is_end == b.is_begin || b.oos_end == b.oos_begin) continue;   // Gap in the data
+
+        WalkForwardFold fold;
+        fold.in_sample_start = is_start;
+        fold.in_sample_end = oos_start;
+        fold.out_of_sample_start = oos_start;
+        fold.out_of_sample_end = oos_end;
+        fold.in_sample_ticks = b.is_end - b.is_begin;
+        fold.out_of_sample_ticks = b.oos_end - b.oos_begin;
+        result.folds.push_back(fold);
+        bounds.push_back(b);
+    }
+    if (result.folds.empty()) {
+        std::cerr << "[WalkForward] ERROR: data is shorter than one in-sample window" << std::endl;
+        return result;
+    }
+
+    const size_t folds = result.folds.size();
+    const size_t k = candidates.size();
+    const unsigned threads = resolve_threads(config.threads);
+    if (config.verbose) {
+        std::cout << "[WalkForward] " << folds << " folds x " << k << " candidates on "
+                  << threads << " threads" << std::endl;
+    }
+
+    const SignalBacktestConfig backtest = fold_backtest(config);
+
+    // In-sample sweep: every (fold, candidate) pair is independent
+    std::vector<PerformanceSummary> in_sample(folds * k);
+    parallel_for(folds * k, threads, [&](size_t task) {
+        const FoldBounds& b = bounds[task / k];
+        const double* signals = candidates[task % k] + b.is_begin;
+        in_sample[task] = run_signal_backtest(stream.view(b.is_begin, b.is_end), signals,
+                                              backtest).summary;
+    });
+
+    result.scores.resize(folds * k);
+    for (size_t f = 0; f < folds; ++f) {
+        WalkForwardFold& fold = result.folds[f];
+        double best = -std::numeric_limits<double>::infinity();
+        for (size_t c = 0; c < k; ++c) {
+            double score = walk_forward_score(in_sample[f * k + c], config.metric);
+            result.scores[f * k + c] = score;
+            if (c == 0 || score > best) {   // Ties keep the earlier candidate
+                best = score;
+                fold.best_candidate = static_cast<uint32_t>(c);
+            }
+        }
+        fold.in_sample_score = best;
+        fold.in_sample = in_sample[f * k + fold.best_candidate];
+    }
+
+    // Out-of-sample: each fold's winner, all folds at once
+    std::vector<SignalBacktestRun> out_of_sample(folds);
+    parallel_for(folds, threads, [&](size_t f) {
+        const FoldBounds& b = bounds[f];
+        const double* signals = candidates[result.folds[f].best_candidate] + b.oos_begin;
+        out_of_sample[f] = run_signal_backtest(stream.view(b.oos_begin, b.oos_end), signals,
+                                               backtest, true);
+    });
+
+    // Stitch: each fold restarts at initial_capital, so compound its curve
+    // onto where the previous fold ended
+    double base = config.initial_capital;
+    result.equity_curve.push_back(EquityPoint{result.folds[0].out_of_sample_start, base, base, 0.0});
+    for (size_t f = 0; f < folds; ++f) {
+        WalkForwardFold& fold = result.folds[f];
+        fold.out_of_sample = out_of_sample[f].summary;
+        fold.out_of_sample_orders = out_of_sample[f].orders;
+
+        const double scale = base / config.initial_capital;
+        for (const EquityPoint& p : out_of_sample[f].curve) {
+            if (p.timestamp < fold.out_of_sample_start) continue;   // Pre-run initial point
+            result.equity_curve.push_back(EquityPoint{p.timestamp, p.equity * scale,
+                                                      p.cash * scale, p.unrealized_pnl * scale});
+        }
+        base = result.equity_curve.back().equity;
+    }
+
+    std::vector<double> equity(result.equity_curve.size());
+    for (size_t i = 0; i < equity.size(); ++i) {
+        equity[i] = result.equity_curve[i].equity;
+    }
+    result.out_of_sample = compute_performance(equity.data(), equity.size(),
+                                               config.risk_free_rate, config.periods_per_year);
+
+    if (config.verbose) {
+        std::cout << "[WalkForward] Out-of-sample: " << result.out_of_sample.total_return_pct
+                  << "% over " << folds << " folds" << std::endl;
+    }
+    return result;
+}
+
+} // namespace felix
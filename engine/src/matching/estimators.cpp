@@ -0,0 +1,67 @@
+#include "felix/estimators.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace felix {
+
+void EwmaVolatility::update(double price) {
+    if (price <= 0.0) return;
+
+    if (last_price_ > 0.0) {
+        double r = std::log(price / last_price_);
+        // Seed with the first squared return so early ticks aren't biased to zero
+        variance_ = (samples_ == 0) ? r * r : lambda_ * variance_ + (1.0 - lambda_) * r * r;
+        samples_++;
+    }
+    last_price_ = price;
+}
+
+double EwmaVolatility::sigma() const {
+    return std::sqrt(variance_);
+}
+
+void RollingVolume::update(uint64_t timestamp, double volume) {
+    uint64_t day = timestamp / kNsPerDay;
+
+    if (!started_) {
+        current_day_ = day;
+        started_ = true;
+    } else if (day != current_day_) {
+        // Roll the finished day into the window
+        if (count_ == window_) {
+            size_t oldest = (head_ + kMaxDays - window_) % kMaxDays;
+            window_sum_ -= days_[oldest];
+        } else {
+            count_++;
+        }
+        days_[head_] = today_volume_;
+        window_sum_ += today_volume_;
+        head_ = (head_ + 1) % kMaxDays;
+
+        current_day_ = day;
+        today_volume_ = 0.0;
+    }
+
+    today_volume_ += volume;
+}
+
+void RollingVolume::set_window(uint32_t days) {
+    size_t window = std::clamp<size_t>(days, 1, kMaxDays);
+
+    // Drop the oldest completed days if the window shrinks
+    while (count_ > window) {
+        size_t oldest = (head_ + kMaxDays - count_) % kMaxDays;
+        window_sum_ -= days_[oldest];
+        count_--;
+    }
+    window_ = window;
+}
+
+double RollingVolume::adv() const {
+    if (count_ > 0) {
+        return window_sum_ / static_cast<double>(count_);
+    }
+    return today_volume_;
+}
+
+} // namespace felix
@@ -1,8 +1,9 @@
 #include "felix/matching.hpp"
+#include "felix/random.hpp"
 #include <algorithm>
 #include <cmath>
-#include <random>
 #include <iostream>
+#include <limits>
 #include <string>
 
 namespace felix {
@@ -10,9 +11,8 @@ namespace felix {
 MatchingEngine::MatchingEngine(const SlippageConfig& slippage)
     : slippage_config_(slippage)
     , next_order_id_(1) {
-    // Initialize random generator for stochastic slippage
-    std::random_device rd;
-    rng_.seed(rd());
+    fills_.reserve(64);
+    fill_seqs_.reserve(64);
 }
 
 void MatchingEngine::set_latency_config(const LatencyConfig& config) {
@@ -21,36 +21,207 @@ void MatchingEngine::set_latency_config(const LatencyConfig& config) {
 
 void MatchingEngine::set_slippage_config(const SlippageConfig& config) {
     slippage_config_ = config;
+    for (auto& state : market_states_) {
+        state.volatility.set_decay(config.vol_decay);
+        state.volume.set_window(config.adv_window_days);
+    }
+}
+
+void MatchingEngine::set_liquidity_config(const LiquidityConfig& config) {
+    liquidity_config_ = config;
+}
+
+void MatchingEngine::register_symbols(const SymbolTable& symbols) {
+    for (uint32_t symbol_id : symbols.symbols()) {
+        market_state_slot(symbol_id);
+    }
+}
+
+MarketState& MatchingEngine::market_state_slot(uint32_t symbol_id) {
+    uint32_t index = symbols_.intern(symbol_id);
+    if (index >= market_states_.size()) {
+        MarketState& state = market_states_.emplace_back();
+        state.volatility.set_decay(slippage_config_.vol_decay);
+        state.volume.set_window(slippage_config_.adv_window_days);
+    }
+    return market_states_[index];
+}
+
+MarketState* MatchingEngine::find_market_state(uint32_t symbol_id) {
+    uint32_t index = symbols_.find(symbol_id);
+    if (index == SymbolTable::kNoIndex || !market_states_[index].has_data) {
+        return nullptr;
+    }
+    return &market_states_[index];
+}
+
+const MarketState* MatchingEngine::find_market_state(uint32_t symbol_id) const {
+    return const_cast<MatchingEngine*>(this)->find_market_state(symbol_id);
 }
 
 void MatchingEngine::update_market_state(const TickRecord& tick) {
     /**
      * Section 6 - Update market state from tick
      */
-    MarketState& state = market_states_[tick.symbol_id];
+    clock_ = std::max(clock_, tick.timestamp);
+    MarketState& state = market_state_slot(tick.symbol_id);
+    state.has_data = true;
     state.last_price = tick.price;
     state.bid = tick.bid;
     state.ask = tick.ask;
     state.bid_size = tick.bid_size;
     state.ask_size = tick.ask_size;
     state.last_timestamp = tick.timestamp;
+
+    // Fresh displayed liquidity each tick; a zero size means the feed has no depth
+    constexpr double unlimited = std::numeric_limits<double>::infinity();
+    state.bid_available = (tick.bid_size > 0) ? tick.bid_size : unlimited;
+    state.ask_available = (tick.ask_size > 0) ? tick.ask_size : unlimited;
+    state.bid_swept = 0.0;
+    state.ask_swept = 0.0;
+
+    // O(1) estimator updates - Section 8.3
+    state.volatility.update(tick.price);
+    state.volume.update(tick.timestamp, tick.volume);
 }
 
 uint64_t MatchingEngine::submit_order(Order order) {
-    // Assign order ID
-    order.order_id = next_order_id_++;
+    // Assign order ID (and the active strategy's tag)
+    stamp_order(order);
+
+    if (!risk_accepts(order)) {
+        // Order rejected by risk checks
+        archive_order(order, OrderStatus::REJECTED);
+        return 0;  // Return 0 or invalid order_id to indicate rejection
+    }
 
+    return enqueue_order(order);
+}
+
+std::vector<SubmitResult> MatchingEngine::submit_orders(std::vector<Order> orders) {
+    /**
+     * Section 6.1 & 8.4 - Batch Submission
+     * Ids are assigned in batch order, the whole batch is risk checked
+     * against one portfolio snapshot, then accepted orders are queued.
+     */
+    std::vector<SubmitResult> results(orders.size());
+    std::vector<RiskRule> verdicts(orders.size(), RiskRule::COUNT);
+    for (Order& order : orders) {
+        stamp_order(order);
+    }
     if (risk_engine_ && portfolio_) {
-        double cash = portfolio_->cash();
-        double equity = portfolio_->equity();
-        double initial = portfolio_->initial_cash();
-        
-        if (!risk_engine_->check_order(order, cash, equity, initial)) {
-            // Order rejected by risk checks
-            return 0;  // Return 0 or invalid order_id to indicate rejection
+        risk_engine_->check_batch(orders.data(), orders.size(), *portfolio_, verdicts.data());
+    }
+
+    size_t accepted = 0;
+    for (size_t i = 0; i < orders.size(); ++i) {
+        if (verdicts[i] != RiskRule::COUNT) {
+            archive_order(orders[i], OrderStatus::REJECTED);
+            results[i].reject = verdicts[i];
+            continue;
+        }
+        results[i].order_id = enqueue_order(orders[i], false);
+        ++accepted;
+    }
+
+    if (verbose_) {
+        std::cout << "[Engine] Batch of " << orders.size() << " orders: " << accepted
+                  << " submitted, " << (orders.size() - accepted) << " rejected" << std::endl;
+    }
+    return results;
+}
+
+std::pair<uint64_t, uint64_t> MatchingEngine::submit_oco(Order first, Order second) {
+    /**
+     * Section 6.4 - One-Cancels-Other
+     * Both legs share one exit quantity; a fill on either shrinks the other.
+     */
+    stamp_order(first);
+    stamp_order(second);
+
+    if (!risk_accepts(first) || !risk_accepts(second)) {
+        archive_order(first, OrderStatus::REJECTED);
+        archive_order(second, OrderStatus::REJECTED);
+        return {0, 0};
+    }
+
+    uint32_t group = create_group(std::max(first.size, second.size), true);
+    first.oco_group = group;
+    second.oco_group = group;
+
+    return {enqueue_order(first), enqueue_order(second)};
+}
+
+BracketOrder MatchingEngine::submit_bracket(Order entry, double stop_loss, double take_profit,
+                                            double trail_offset, bool trail_percent) {
+    /**
+     * Section 6.4 - Bracket Order
+     * Entry plus an OCO pair of exits (stop-loss, take-profit). The exits are
+     * armed by the entry's fills, so they never trade more than was bought.
+     * A positive trail_offset makes the stop-loss a trailing stop (absolute,
+     * or a fraction of the water mark with trail_percent).
+     */
+    BracketOrder ids;
+    stamp_order(entry);
+
+    // Only the entry is risk checked. Exits are armed by its fills, so they can
+    // only close what the check already allowed; checking them too would let a
+    // drawdown or daily-loss halt strip an open position of its stop-loss.
+    if (!risk_accepts(entry)) {
+        archive_order(entry, OrderStatus::REJECTED);
+        return ids;
+    }
+
+    const bool has_stop = stop_loss > 0 || trail_offset > 0;
+    const bool has_target = take_profit > 0;
+    uint32_t group = (has_stop || has_target) ? create_group(0.0, false) : 0;
+    entry.child_group = group;
+    ids.entry_id = enqueue_order(entry);
+
+    Order exit;
+    exit.symbol_id = entry.symbol_id;
+    exit.side = (entry.side == Side::BUY) ? Side::SELL : Side::BUY;
+    exit.size = entry.size;
+    exit.timestamp = entry.timestamp;
+    exit.parent_id = entry.order_id;
+    exit.oco_group = group;
+    exit.strategy_id = entry.strategy_id;
+
+    if (has_stop) {
+        Order stop = exit;
+        stop.order_id = next_order_id_++;
+        if (trail_offset > 0) {
+            stop.order_type = OrderType::TRAILING_STOP;
+            stop.trail_offset = trail_offset;
+            stop.trail_percent = trail_percent;
+        } else {
+            stop.order_type = OrderType::STOP;
+            stop.price = stop_loss;
         }
+        ids.stop_loss_id = enqueue_order(stop);
+    }
+
+    if (has_target) {
+        Order target = exit;
+        target.order_id = next_order_id_++;
+        target.order_type = OrderType::LIMIT;
+        target.price = take_profit;
+        ids.take_profit_id = enqueue_order(target);
     }
 
+    return ids;
+}
+
+void MatchingEngine::stamp_order(Order& order) {
+    order.order_id = next_order_id_++;
+    if (active_strategy_ != 0) order.strategy_id = active_strategy_;
+}
+
+bool MatchingEngine::risk_accepts(const Order& order) const {
+    return !(risk_engine_ && portfolio_) || risk_engine_->check_order(order, *portfolio_);
+}
+
+uint64_t MatchingEngine::enqueue_order(Order& order, bool log) {
     order.status = OrderStatus::PENDING;
     
     // Calculate activation time with latency model (Section 8.1)
@@ -58,7 +229,11 @@ uint64_t MatchingEngine::submit_order(Order order) {
     order.activation_time = order.timestamp + total_latency;
     
     // Add to pending orders
+    if (order.oco_group != 0) groups_[order.oco_group - 1].live_orders++;
+    if (order.child_group != 0) groups_[order.child_group - 1].live_orders++;
     pending_orders_.push_back(order);
+    if (journal_) journal_->order_submitted(order);
+    if (!log || !verbose_) return order.order_id;
     
     std::cout << "[Engine] Order " << order.order_id << " submitted: "
               << (order.side == Side::BUY ? "BUY" : "SELL") << " "
@@ -69,6 +244,55 @@ uint64_t MatchingEngine::submit_order(Order order) {
     return order.order_id;
 }
 
+uint32_t MatchingEngine::create_group(double armed_qty, bool entry_done) {
+    // 1-based, 0 means no group; closed groups' slots are reused first
+    uint32_t id;
+    if (!free_groups_.empty()) {
+        id = free_groups_.back();
+        free_groups_.pop_back();
+        groups_[id - 1] = ContingentGroup{};
+    } else {
+        groups_.emplace_back();
+        id = static_cast<uint32_t>(groups_.size());
+    }
+    ContingentGroup& group = groups_[id - 1];
+    group.armed_qty = armed_qty;
+    group.entry_done = entry_done;
+    return id;
+}
+
+void MatchingEngine::release_group(uint32_t group) {
+    if (group != 0 && --groups_[group - 1].live_orders == 0) {
+        free_groups_.push_back(group);
+    }
+}
+
+void MatchingEngine::remove_closed_legs() {
+    /**
+     * Drop OCO legs whose group has nothing left to exit
+     */
+    std::erase_if(pending_orders_, [this](const Order& o) {
+        if (o.oco_group == 0) return false;
+        const ContingentGroup& group = groups_[o.oco_group - 1];
+        if (group.entry_done && group.open_qty() <= kMinFillSize) {
+            archive_order(o, OrderStatus::CANCELLED);
+            return true;
+        }
+        return false;
+    });
+    groups_dirty_ = false;
+}
+
+void MatchingEngine::archive_order(const Order& order, OrderStatus status) {
+    Order record = order;
+    record.status = status;
+    order_history_.push_back(record);
+    // Orders rejected at submission carry no group ids yet
+    release_group(order.oco_group);
+    release_group(order.child_group);
+    if (journal_) journal_->order_closed(order, status, std::max(clock_, order.timestamp));
+}
+
 void MatchingEngine::set_risk_engine(RiskEngine* risk_engine) {
     risk_engine_ = risk_engine;
 }
@@ -82,93 +306,231 @@ bool MatchingEngine::cancel_order(uint64_t order_id) {
         [order_id](const Order& o) { return o.order_id == order_id; });
     
     if (it != pending_orders_.end()) {
-        it->status = OrderStatus::CANCELLED;
+        archive_order(*it, OrderStatus::CANCELLED);
+        uint32_t child_group = it->child_group;
         pending_orders_.erase(it);
+        
+        // A cancelled bracket entry arms nothing further
+        if (child_group != 0) {
+            groups_[child_group - 1].entry_done = true;
+            remove_closed_legs();
+        }
         return true;
     }
     return false;
 }
 
-std::vector<Fill> MatchingEngine::process_pending_orders(uint64_t current_timestamp) {
+const std::vector<Fill>& MatchingEngine::process_pending_orders(uint64_t current_timestamp) {
     /**
      * Section 6 - Process orders that are now active
      * 
      * For each pending order:
      * 1. Check if order is now active (latency elapsed)
      * 2. Check if order can be matched
-     * 3. Apply slippage model (Section 8.3)
-     * 4. Generate fill
+     * 3. Split into fills against available liquidity (Section 6.2)
+     * 4. Apply slippage model (Section 8.3) per fill
+     *
+     * Pending orders are compacted in place and fills go into a reused
+     * buffer, so steady-state processing does not allocate.
      */
     
-    std::vector<Fill> fills;
-    std::vector<Order> remaining_orders;
+    clock_ = std::max(clock_, current_timestamp);
+    fills_.clear();
+    fill_seqs_.clear();
+    size_t kept = 0;
     
-    for (auto& order : pending_orders_) {
+    for (size_t i = 0; i < pending_orders_.size(); ++i) {
+        Order& order = pending_orders_[i];
+        bool keep = true;
+        
         // Check if order is active yet (Section 8.1 - Latency)
-        if (current_timestamp < order.activation_time) {
-            remaining_orders.push_back(order);
-            continue;
+        if (current_timestamp >= order.activation_time) {
+            keep = process_active_order(order, current_timestamp);
         }
         
-        // Order is now active
+        if (keep) {
+            if (kept != i) {
+                pending_orders_[kept] = order;
+            }
+            ++kept;
+        } else {
+            archive_order(order, order.status);
+        }
+    }
+    
+    pending_orders_.erase(pending_orders_.begin() + kept, pending_orders_.end());
+    
+    // Siblings of legs that filled this pass may now be closed
+    if (groups_dirty_) {
+        remove_closed_legs();
+    }
+    
+    // Apply slippage (Section 8.3) to the whole batch of fills
+    apply_slippage(fills_);
+    return fills_;
+}
+
+bool MatchingEngine::process_active_order(Order& order, uint64_t current_timestamp) {
+    /**
+     * Returns true while the order should stay in the pending list
+     */
+    
+    // Order is now active
+    if (order.status == OrderStatus::PENDING) {
         order.status = OrderStatus::ACTIVE;
-        
-        // Get market state for this symbol
-        auto state_it = market_states_.find(order.symbol_id);
-        if (state_it == market_states_.end()) {
-            remaining_orders.push_back(order);
-            continue;
+    }
+    
+    // Get market state for this symbol
+    MarketState* state = find_market_state(order.symbol_id);
+    if (!state) {
+        return true;
+    }
+    
+    MarketState& market = *state;
+    // Nothing to trade - pre-trade limits are enforced at submission (Section 8.4)
+    if (order.size <= kMinFillSize) {
+        order.status = OrderStatus::REJECTED;
+        if (order.child_group != 0) {
+            groups_[order.child_group - 1].entry_done = true;
+            groups_dirty_ = true;
         }
-        
-        const MarketState& market = state_it->second;
-        // ---- RISK CLIP: enforce max position / max order size ----
-	if (has_risk_limits_) {
-    		// clamp per-order size
-    		if ((int)order.size > (int)risk_limits_.max_order_size) {
-        		order.size = risk_limits_.max_order_size;
-    		}
-
-    		// enforce max position size (simple cap for BUY)
-    		if (order.side == Side::BUY) {
-        		if ((int)order.size > (int)risk_limits_.max_position_size) {
-            			order.size = risk_limits_.max_position_size;
-        		}
-    		}
-
-    		// reject if nothing left
-    		if ((int)order.size <= 0) {
-        		continue;
-    		}
-	}
-	// ---- END RISK CLIP ----
-
-        // Try to match order
-        Fill fill;
-        bool matched = false;
-        
-        if (order.order_type == OrderType::MARKET) {
-            matched = match_market_order(order, market, fill);
-        } else if (order.order_type == OrderType::LIMIT) {
-            matched = match_limit_order(order, market, fill);
-        } else if (order.order_type == OrderType::STOP) {
-            matched = match_stop_order(order, market, fill);
+        return false;
+    }
+
+    // OCO legs trade only the quantity still open in their group (Section 6.4)
+    double quantity = order.remaining();
+    ContingentGroup* group = order.oco_group ? &groups_[order.oco_group - 1] : nullptr;
+    if (group) {
+        if (group->open_qty() <= kMinFillSize) {
+            if (group->entry_done) {
+                order.status = OrderStatus::CANCELLED;
+                return false;
+            }
+            return true;  // Waiting for the bracket entry to fill
         }
-        
+        quantity = std::min(quantity, group->open_qty());
+    }
+
+    // Try to match order
+    Fill touch;
+    bool matched = false;
+    
+    if (order.order_type == OrderType::MARKET) {
+        matched = match_market_order(order, market, touch);
+    } else if (order.order_type == OrderType::LIMIT) {
+        matched = match_limit_order(order, market, touch);
+    } else if (order.order_type == OrderType::STOP) {
+        matched = match_stop_order(order, market, touch);
         if (matched) {
-            // Apply slippage (Section 8.3)
-            apply_slippage(fill, order, market);
-            
-            fill.timestamp = current_timestamp;
-            fills.push_back(fill);
-            order.status = OrderStatus::FILLED;
-        } else {
-            // Order not filled yet, keep it
-            remaining_orders.push_back(order);
+            // Triggered stop: any unfilled remainder works as a market order
+            order.order_type = OrderType::MARKET;
         }
+    } else if (order.order_type == OrderType::STOP_LIMIT) {
+        matched = match_stop_limit_order(order, market, touch);
+    } else if (order.order_type == OrderType::TRAILING_STOP) {
+        matched = match_trailing_stop(order, market, touch);
+        if (matched) {
+            order.order_type = OrderType::MARKET;
+        }
+    }
+    
+    if (!matched) {
+        // Order not filled yet, keep it
+        return true;
     }
     
-    pending_orders_ = std::move(remaining_orders);
-    return fills;
+    double filled_before = order.filled_size;
+    execute_order(order, market, touch.price, quantity, current_timestamp);
+    double filled = order.filled_size - filled_before;
+    
+    if (group) {
+        group->exited_qty += filled;
+        groups_dirty_ = true;
+    }
+    if (order.child_group != 0) {
+        // Entry fills arm the bracket's exit legs
+        ContingentGroup& armed = groups_[order.child_group - 1];
+        armed.armed_qty += filled;
+        if (order.remaining() <= kMinFillSize) {
+            armed.entry_done = true;
+        }
+    }
+    
+    if (order.remaining() <= kMinFillSize ||
+        (group && group->entry_done && group->open_qty() <= kMinFillSize)) {
+        order.status = OrderStatus::FILLED;
+        return false;
+    }
+    
+    if (order.filled_size > 0.0) {
+        order.status = OrderStatus::PARTIAL;
+    }
+    return true;
+}
+
+void MatchingEngine::execute_order(Order& order, MarketState& market, double touch_price, double quantity,
+                                   uint64_t timestamp) {
+    /**
+     * Section 6.2 - Liquidity-capped execution
+     * Takes the displayed size at the touch first, then walks simulated
+     * depth levels (each the displayed size, level_spacing_bps apart).
+     * Whatever is left stays on the order as a PARTIAL remainder.
+     */
+    
+    double remaining = quantity;
+    
+    if (!liquidity_config_.cap_to_displayed) {
+        emit_fill(order, market, touch_price, remaining, timestamp);
+        return;
+    }
+    
+    const bool is_buy = (order.side == Side::BUY);
+    double& available = is_buy ? market.ask_available : market.bid_available;
+    double& swept = is_buy ? market.ask_swept : market.bid_swept;
+    const double displayed = is_buy ? market.ask_size : market.bid_size;
+    
+    // Level 0 - displayed size at the touch
+    double qty = std::min(remaining, available);
+    if (qty > kMinFillSize) {
+        emit_fill(order, market, touch_price, qty, timestamp);
+        available -= qty;
+        remaining -= qty;
+    }
+    
+    // Levels 1..N - simulated depth behind the touch
+    const double depth = liquidity_config_.sweep_levels * displayed;
+    while (remaining > kMinFillSize && displayed > 0 && swept < depth) {
+        double level = std::floor(swept / displayed) + 1.0;
+        double offset = level * liquidity_config_.level_spacing_bps / 10000.0;
+        double price = is_buy ? touch_price * (1.0 + offset) : touch_price * (1.0 - offset);
+        
+        // Limit orders never sweep through their limit price
+        if (order.order_type == OrderType::LIMIT &&
+            (is_buy ? price > order.price : price < order.price)) {
+            break;
+        }
+        
+        qty = std::min(remaining, level * displayed - swept);
+        emit_fill(order, market, price, qty, timestamp);
+        swept += qty;
+        remaining -= qty;
+    }
+}
+
+void MatchingEngine::emit_fill(Order& order, const MarketState& market, double price, double volume, uint64_t timestamp) {
+    Fill fill;
+    fill.order_id = order.order_id;
+    fill.symbol_id = order.symbol_id;
+    fill.side = order.side;
+    fill.price = price;
+    fill.volume = volume;
+    fill.slippage = deterministic_slippage_bps(order, market);  // Finalized in apply_slippage
+    fill.timestamp = timestamp;
+    fill.strategy_id = order.strategy_id;
+    
+    fills_.push_back(fill);
+    fill_seqs_.push_back(order.fill_count++);
+    order.filled_size += volume;
 }
 
 bool MatchingEngine::match_market_order(const Order& order, const MarketState& market, Fill& fill) {
@@ -180,7 +542,7 @@ bool MatchingEngine::match_market_order(const Order& order, const MarketState& m
     fill.order_id = order.order_id;
     fill.symbol_id = order.symbol_id;
     fill.side = order.side;
-    fill.volume = order.size;
+    fill.volume = order.remaining();
     
     if (order.side == Side::BUY) {
         // Buy at ask price
@@ -225,7 +587,7 @@ bool MatchingEngine::match_limit_order(const Order& order, const MarketState& ma
         fill.order_id = order.order_id;
         fill.symbol_id = order.symbol_id;
         fill.side = order.side;
-        fill.volume = order.size;
+        fill.volume = order.remaining();
     }
     
     return can_fill;
@@ -252,7 +614,7 @@ bool MatchingEngine::match_stop_order(const Order& order, const MarketState& mar
         fill.order_id = order.order_id;
         fill.symbol_id = order.symbol_id;
         fill.side = order.side;
-        fill.volume = order.size;
+        fill.volume = order.remaining();
         fill.price = market.last_price;
         return true;
     }
@@ -260,58 +622,207 @@ bool MatchingEngine::match_stop_order(const Order& order, const MarketState& mar
     return false;
 }
 
-void MatchingEngine::apply_slippage(Fill& fill, const Order& order, const MarketState& market) {
+bool MatchingEngine::match_stop_limit_order(Order& order, const MarketState& market, Fill& fill) {
+    /**
+     * Section 6.4 - Stop-Limit Order Matching
+     * Becomes a limit order at `price` once last trade crosses `stop_price`
+     */
+    
+    bool triggered = (order.side == Side::BUY) ? market.last_price >= order.stop_price
+                                               : market.last_price <= order.stop_price;
+    if (!triggered) {
+        return false;
+    }
+    
+    order.order_type = OrderType::LIMIT;
+    return match_limit_order(order, market, fill);
+}
+
+bool MatchingEngine::match_trailing_stop(Order& order, const MarketState& market, Fill& fill) {
+    /**
+     * Section 6.4 - Trailing Stop Matching
+     * Tracks the high-water mark (SELL) or low-water mark (BUY) natively and
+     * keeps the stop trail_offset behind it; `price` always holds the live stop.
+     */
+    
+    const double last = market.last_price;
+    if (order.side == Side::SELL) {
+        if (order.trail_anchor <= 0 || last > order.trail_anchor) {
+            order.trail_anchor = last;
+        }
+    } else {
+        if (order.trail_anchor <= 0 || last < order.trail_anchor) {
+            order.trail_anchor = last;
+        }
+    }
+    
+    double offset = order.trail_percent ? order.trail_anchor * order.trail_offset : order.trail_offset;
+    order.price = (order.side == Side::SELL) ? order.trail_anchor - offset : order.trail_anchor + offset;
+    
+    return match_stop_order(order, market, fill);
+}
+
+double MatchingEngine::deterministic_slippage_bps(const Order& order, const MarketState& market) const {
     /**
      * Section 8.3 - Slippage Model
      * 
      * Slippage = fixed_bps + volatility_mult * σ + size_impact * (size/ADV)
-     * Plus optional stochastic component
+     * Plus optional stochastic component (added in apply_slippage)
      */
     
     double slippage_bps = slippage_config_.fixed_bps;
     
-    // Add volatility component (simplified - would need historical vol calculation)
-    // slippage_bps += slippage_config_.volatility_mult * estimated_volatility;
-    
-    // Add size impact (simplified)
-    // slippage_bps += slippage_config_.size_impact * (order.size / average_daily_volume);
+    // Add volatility component - σ is the EWMA tick volatility, in bps
+    if (slippage_config_.volatility_mult > 0) {
+        slippage_bps += slippage_config_.volatility_mult * market.volatility.sigma() * 10000.0;
+    }
     
-    // Add stochastic component if enabled
-    if (slippage_config_.use_stochastic && slippage_config_.stochastic_std > 0) {
-        std::normal_distribution<double> dist(0.0, slippage_config_.stochastic_std);
-        slippage_bps += dist(rng_);
+    // Add size impact against the rolling average daily volume
+    double adv = market.volume.adv();
+    if (slippage_config_.size_impact > 0 && adv > 0) {
+        slippage_bps += slippage_config_.size_impact * (order.size / adv);
     }
     
-    // Ensure non-negative slippage
-    slippage_bps = std::max(0.0, slippage_bps);
+    return slippage_bps;
+}
+
+void MatchingEngine::apply_slippage(std::vector<Fill>& fills) {
+    /**
+     * Section 8.3 - Stochastic component and price adjustment
+     * 
+     * Each fill's normal draw is keyed by (seed, order_id, fill number) on a
+     * counter-based generator, so any fill reproduces in isolation. Draws for
+     * the whole batch are generated in one vectorized pass.
+     */
     
-    // Apply slippage to fill price
-    double slippage_mult = slippage_bps / 10000.0;  // Convert bps to decimal
+    if (fills.empty()) return;
     
-    if (fill.side == Side::BUY) {
-        // Buying: slippage increases price
-        fill.price *= (1.0 + slippage_mult);
-    } else {
-        // Selling: slippage decreases price
-        fill.price *= (1.0 - slippage_mult);
+    const bool stochastic = slippage_config_.use_stochastic && slippage_config_.stochastic_std > 0;
+    if (stochastic) {
+        rng_streams_.resize(fills.size());
+        normals_.resize(fills.size());
+        for (size_t i = 0; i < fills.size(); ++i) {
+            rng_streams_[i] = fills[i].order_id;
+        }
+        philox_normal_batch(slippage_config_.seed, rng_streams_.data(), fill_seqs_.data(),
+                            normals_.data(), fills.size());
     }
     
-    fill.slippage = slippage_bps;
+    for (size_t i = 0; i < fills.size(); ++i) {
+        Fill& fill = fills[i];
+        double slippage_bps = fill.slippage;
+        
+        if (stochastic) {
+            slippage_bps += slippage_config_.stochastic_std * normals_[i];
+        }
+        
+        // Ensure non-negative slippage
+        slippage_bps = std::max(0.0, slippage_bps);
+        
+        // Apply slippage to fill price
+        double slippage_mult = slippage_bps / 10000.0;  // Convert bps to decimal
+        
+        if (fill.side == Side::BUY) {
+            // Buying: slippage increases price
+            fill.price *= (1.0 + slippage_mult);
+        } else {
+            // Selling: slippage decreases price
+            fill.price *= (1.0 - slippage_mult);
+        }
+        
+        fill.slippage = slippage_bps;
+    }
 }
 
 double MatchingEngine::get_best_bid(uint32_t symbol_id) const {
-    auto it = market_states_.find(symbol_id);
-    return (it != market_states_.end()) ? it->second.bid : 0.0;
+    const MarketState* state = find_market_state(symbol_id);
+    return state ? state->bid : 0.0;
 }
 
 double MatchingEngine::get_best_ask(uint32_t symbol_id) const {
-    auto it = market_states_.find(symbol_id);
-    return (it != market_states_.end()) ? it->second.ask : 0.0;
+    const MarketState* state = find_market_state(symbol_id);
+    return state ? state->ask : 0.0;
 }
 
 double MatchingEngine::get_last_price(uint32_t symbol_id) const {
-    auto it = market_states_.find(symbol_id);
-    return (it != market_states_.end()) ? it->second.last_price : 0.0;
+    const MarketState* state = find_market_state(symbol_id);
+    return state ? state->last_price : 0.0;
+}
+
+double MatchingEngine::get_volatility(uint32_t symbol_id) const {
+    const MarketState* state = find_market_state(symbol_id);
+    return state ? state->volatility.sigma() : 0.0;
+}
+
+double MatchingEngine::get_adv(uint32_t symbol_id) const {
+    const MarketState* state = find_market_state(symbol_id);
+    return state ? state->volume.adv() : 0.0;
+}
+
+void MatchingEngine::collect_triggers(TriggerEnvelope& envelope, const SymbolTable& symbols) const {
+    /**
+     * Section 5.3 - Trigger envelope for fast-forward
+     * Bands are conservative: a tick outside them may still do nothing,
+     * but a tick inside them is guaranteed not to change any order.
+     */
+    for (const Order& order : pending_orders_) {
+        uint32_t index = symbols.find(order.symbol_id);
+        if (index == SymbolTable::kNoIndex) {
+            continue;  // No ticks will ever arrive for this symbol
+        }
+        
+        // Latency pending: nothing happens before activation
+        if (order.status == OrderStatus::PENDING) {
+            envelope.trigger_at_time(order.activation_time);
+            continue;
+        }
+        
+        if (!find_market_state(order.symbol_id)) {
+            envelope.trigger_always(index);
+            continue;
+        }
+        
+        if (order.oco_group != 0) {
+            const ContingentGroup& group = groups_[order.oco_group - 1];
+            if (group.open_qty() <= kMinFillSize) {
+                if (group.entry_done) {
+                    envelope.trigger_always(index);  // Leg is about to be cancelled
+                }
+                continue;  // Armed only by an entry fill, which triggers itself
+            }
+        }
+        
+        const bool is_buy = (order.side == Side::BUY);
+        switch (order.order_type) {
+            case OrderType::MARKET:
+                envelope.trigger_always(index);
+                break;
+            case OrderType::LIMIT:
+                if (is_buy) envelope.trigger_at_or_below(index, order.price);
+                else envelope.trigger_at_or_above(index, order.price);
+                break;
+            case OrderType::STOP:
+                if (is_buy) envelope.trigger_at_or_above(index, order.price);
+                else envelope.trigger_at_or_below(index, order.price);
+                break;
+            case OrderType::STOP_LIMIT:
+                if (is_buy) envelope.trigger_at_or_above(index, order.stop_price);
+                else envelope.trigger_at_or_below(index, order.stop_price);
+                break;
+            case OrderType::TRAILING_STOP:
+                if (order.trail_anchor <= 0) {
+                    envelope.trigger_always(index);
+                } else if (is_buy) {
+                    // New low moves the anchor; price holds the live stop
+                    envelope.trigger_at_or_below(index, order.trail_anchor);
+                    envelope.trigger_at_or_above(index, order.price);
+                } else {
+                    envelope.trigger_at_or_above(index, order.trail_anchor);
+                    envelope.trigger_at_or_below(index, order.price);
+                }
+                break;
+        }
+    }
 }
 
 size_t MatchingEngine::pending_order_count() const {
@@ -0,0 +1,76 @@
+#include "felix/random.hpp"
+#include <cmath>
+
+namespace felix {
+
+namespace {
+
+constexpr size_t kLanes = 8;
+constexpr double kTwoPi = 6.283185307179586476925286766559;
+
+Philox4x32::Key make_key(uint64_t seed) {
+    return {static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)};
+}
+
+Philox4x32::Counter make_counter(uint64_t stream, uint32_t index) {
+    return {index, 0u, static_cast<uint32_t>(stream), static_cast<uint32_t>(stream >> 32)};
+}
+
+// Box-Muller on two 53-bit uniforms in (0, 1)
+double to_normal(const Philox4x32::Counter& bits) {
+    uint64_t a = (static_cast<uint64_t>(bits[0]) << 32) | bits[1];
+    uint64_t b = (static_cast<uint64_t>(bits[2]) << 32) | bits[3];
+    double u1 = (static_cast<double>(a >> 11) + 0.5) * 0x1.0p-53;
+    double u2 = (static_cast<double>(b >> 11) + 0.5) * 0x1.0p-53;
+    return std::sqrt(-2.0 * std::log(u1)) * std::cos(kTwoPi * u2);
+}
+
+} // namespace
+
+double philox_normal(uint64_t seed, uint64_t stream, uint32_t index) {
+    return to_normal(Philox4x32::generate(make_counter(stream, index), make_key(seed)));
+}
+
+void philox_normal_batch(uint64_t seed, const uint64_t* streams, const uint32_t* indices,
+                         double* out, size_t n) {
+    const Philox4x32::Key key = make_key(seed);
+    size_t i = 0;
+
+    // Full blocks: structure-of-arrays lanes so each round vectorizes
+    for (; i + kLanes <= n; i += kLanes) {
+        uint32_t c0[kLanes], c1[kLanes], c2[kLanes], c3[kLanes];
+        for (size_t l = 0; l < kLanes; ++l) {
+            c0[l] = indices[i + l];
+            c1[l] = 0u;
+            c2[l] = static_cast<uint32_t>(streams[i + l]);
+            c3[l] = static_cast<uint32_t>(streams[i + l] >> 32);
+        }
+
+        uint32_t k0 = key[0], k1 = key[1];
+        for (int r = 0; r < Philox4x32::kRounds; ++r) {
+            for (size_t l = 0; l < kLanes; ++l) {
+                uint64_t p0 = static_cast<uint64_t>(0xD2511F53u) * c0[l];
+                uint64_t p1 = static_cast<uint64_t>(0xCD9E8D57u) * c2[l];
+                uint32_t n0 = static_cast<uint32_t>(p1 >> 32) ^ c1[l] ^ k0;
+                uint32_t n2 = static_cast<uint32_t>(p0 >> 32) ^ c3[l] ^ k1;
+                c1[l] = static_cast<uint32_t>(p1);
+                c3[l] = static_cast<uint32_t>(p0);
+                c0[l] = n0;
+                c2[l] = n2;
+            }
+            k0 += 0x9E3779B9u;
+            k1 += 0xBB67AE85u;
+        }
+
+        for (size_t l = 0; l < kLanes; ++l) {
+            out[i + l] = to_normal({c0[l], c1[l], c2[l], c3[l]});
+        }
+    }
+
+    // Tail
+    for (; i < n; ++i) {
+        out[i] = philox_normal(seed, streams[i], indices[i]);
+    }
+}
+
+} // namespace felix
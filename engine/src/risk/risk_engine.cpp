@@ -1,87 +1,170 @@
 #include "felix/risk.hpp"
+#include <algorithm>
+#include <bit>
 #include <cmath>
 #include <iostream>
+#include <numeric>
+#include <unordered_map>
 
 namespace felix {
 
-RiskEngine::RiskEngine(const RiskLimits& limits)
-    : limits_(limits)
-    , halted_(false)
-    , daily_pnl_(0.0)
-    , last_day_(0) {}
+const char* risk_rule_name(RiskRule rule) {
+    switch (rule) {
+        case RiskRule::HALTED: return "HALTED";
+        case RiskRule::ORDER_SIZE: return "ORDER_SIZE";
+        case RiskRule::NOTIONAL: return "NOTIONAL";
+        case RiskRule::CASH: return "CASH";
+        case RiskRule::POSITION: return "POSITION";
+        case RiskRule::DRAWDOWN: return "DRAWDOWN";
+        case RiskRule::DAILY_LOSS: return "DAILY_LOSS";
+        case RiskRule::COUNT: break;
+    }
+    return "NONE";
+}
+
+RiskEngine::RiskEngine(const RiskLimits& limits) {
+    set_limits(limits);
+}
+
+void RiskEngine::set_limits(const RiskLimits& limits) {
+    /**
+     * Section 8.4 - Compile the limits once.
+     * Unlimited settings become +inf so every rule is a plain comparison.
+     */
+    limits_ = limits;
+    thresholds_.order_size = limits.max_order_size;
+    thresholds_.position = limits.max_position_size;
+    thresholds_.drawdown = limits.max_drawdown;
+    thresholds_.notional = (limits.max_notional > 0) ? limits.max_notional : kUnlimited;
+    thresholds_.daily_loss = (limits.max_daily_loss > 0) ? limits.max_daily_loss : kUnlimited;
+}
 
-bool RiskEngine::check_order(const Order& order, double portfolio_cash, double current_equity, double initial_cash) const {
+uint32_t RiskEngine::violations(const Order& order, double portfolio_cash, double position_quantity) const {
     /**
      * Section 8.4 - Pre-trade Risk Checks
-     * Only checks that can be done with primitive values passed in.
-     * Position limits are checked separately via check_position_limit().
+     * All rules are evaluated; the result has one bit per violated rule.
+     * A halted engine still accepts orders that reduce the position.
      */
-    
-    if (halted_) {
-        std::cout << "[Risk] REJECTED: System halted" << std::endl;
-        return false;
-    }
-    
-    double notional = order.price * order.size;
-    
-    // Check order size limit
-    if (order.size > limits_.max_order_size) {
-        std::cout << "[Risk] REJECTED: Order size " << order.size 
-                  << " exceeds max " << limits_.max_order_size << std::endl;
-        return false;
-    }
-    
-    // Check notional limit
-    if (notional > limits_.max_notional && limits_.max_notional > 0) {
-        std::cout << "[Risk] REJECTED: Notional " << notional 
-                  << " exceeds max " << limits_.max_notional << std::endl;
-        return false;
-    }
-    
-    // Check cash for BUY orders
-    if (order.side == Side::BUY) {
-        if (notional > portfolio_cash) {
-            std::cout << "[Risk] REJECTED: Insufficient cash. Need " << notional 
-                      << ", have " << portfolio_cash << std::endl;
-            return false;
+    const bool buy = order.side == Side::BUY;
+    const double notional = order.price * order.size;
+    const double after = position_quantity + (buy ? order.size : -order.size);
+    // Orders that reduce the position are always within the position limit
+    const bool grows = std::abs(after) > std::abs(position_quantity);
+
+    auto bit = [](bool violated, RiskRule rule) {
+        return static_cast<uint32_t>(violated) << static_cast<uint32_t>(rule);
+    };
+    return bit(halted_ && grows, RiskRule::HALTED) |
+           bit(order.size > thresholds_.order_size, RiskRule::ORDER_SIZE) |
+           bit(notional > thresholds_.notional, RiskRule::NOTIONAL) |
+           bit(buy && notional > portfolio_cash, RiskRule::CASH) |
+           bit(grows && std::abs(after) > thresholds_.position, RiskRule::POSITION);
+}
+
+bool RiskEngine::check_order(const Order& order, double portfolio_cash, double position_quantity) {
+    ++orders_checked_;
+    uint32_t mask = violations(order, portfolio_cash, position_quantity);
+    if (mask == 0) return true;
+    // Counted once, under the first violated rule
+    ++rejections_[std::countr_zero(mask)];
+    return false;
+}
+
+bool RiskEngine::check_order(const Order& order, const Portfolio& portfolio) {
+    return check_order(order, portfolio.cash(), portfolio.get_position(order.symbol_id).quantity);
+}
+
+size_t RiskEngine::check_batch(const Order* orders, size_t count, const Portfolio& portfolio,
+                               RiskRule* results) {
+    /**
+     * Section 8.4 - Batch Pre-trade Checks
+     * Sells are not credited until they fill, so cash only goes down.
+     * The notional limit also caps the batch's accepted notional in total.
+     */
+    double cash = portfolio.cash();
+    double batch_notional = 0.0;
+    std::unordered_map<uint32_t, double> projected;
+    projected.reserve(count);
+    size_t accepted = 0;
+
+    for (size_t i = 0; i < count; ++i) {
+        const Order& order = orders[i];
+        auto [it, inserted] = projected.try_emplace(order.symbol_id, 0.0);
+        if (inserted) {
+            it->second = portfolio.get_position(order.symbol_id).quantity;
         }
+
+        ++orders_checked_;
+        const double notional = order.price * order.size;
+        uint32_t mask = violations(order, cash, it->second);
+        if (batch_notional + notional > thresholds_.notional) {
+            mask |= 1u << static_cast<uint32_t>(RiskRule::NOTIONAL);
+        }
+        if (mask != 0) {
+            auto rule = static_cast<RiskRule>(std::countr_zero(mask));
+            ++rejections_[static_cast<size_t>(rule)];
+            results[i] = rule;
+            continue;
+        }
+
+        const bool buy = order.side == Side::BUY;
+        if (buy) cash -= notional;
+        batch_notional += notional;
+        it->second += buy ? order.size : -order.size;
+        results[i] = RiskRule::COUNT;
+        ++accepted;
     }
-    
-    return true;
+    return accepted;
 }
 
-void RiskEngine::check_and_update_halt(double current_equity, double initial_capital, double daily_pnl) {
-    if (halted_) return;  // Already halted
-    
-    // Update peak equity
-    if (current_equity > peak_equity_) {
-        peak_equity_ = current_equity;
-    }
-    
-    // Initialize peak if zero
-    if (peak_equity_ <= 0.0) {
-        peak_equity_ = initial_capital;
-    }
-    
-    // Check max drawdown
-    if (peak_equity_ > 0) {
-        double drawdown = (peak_equity_ - current_equity) / peak_equity_;
-        if (drawdown > limits_.max_drawdown) {
-            halted_ = true;
-            std::cout << "[RISK] Max drawdown exceeded! Halting strategy." << std::endl;
-            return;
+void RiskEngine::start(double equity) {
+    started_ = true;
+    peak_equity_ = equity;
+    last_equity_ = equity;
+    day_start_equity_ = equity;
+    drawdown_ = 0.0;
+    day_ = kNoDay;
+    halted_ = false;
+    halt_reason_ = RiskRule::COUNT;
+    rejections_.fill(0);
+    orders_checked_ = 0;
+}
+
+bool RiskEngine::on_equity(uint64_t timestamp, double equity) {
+    /**
+     * Section 8.4 - Per-tick risk state.
+     * The first tick of a new day opens it at the previous tick's equity
+     * and lifts a daily loss halt; a drawdown halt stays until reset().
+     */
+    if (!started_) start(equity);
+
+    const uint64_t offset = limits_.day_offset_ns % kDayNs;
+    const uint64_t day = (timestamp + kDayNs - offset) / kDayNs;
+    if (day != day_) {
+        if (day_ != kNoDay) day_start_equity_ = last_equity_;
+        day_ = day;
+        if (halted_ && halt_reason_ == RiskRule::DAILY_LOSS) {
+            halted_ = false;
+            halt_reason_ = RiskRule::COUNT;
+            if (verbose_) std::cout << "[Risk] Daily loss halt lifted" << std::endl;
         }
     }
-    
-    // Check max daily loss
-    if (daily_pnl < -limits_.max_daily_loss && limits_.max_daily_loss > 0) {
-        halted_ = true;
-        std::cout << "[RISK] Max daily loss exceeded! Halting strategy." << std::endl;
-        return;
+
+    last_equity_ = equity;
+    peak_equity_ = std::max(peak_equity_, equity);
+    drawdown_ = (peak_equity_ > 0.0) ? (peak_equity_ - equity) / peak_equity_ : 0.0;
+
+    if (!halted_) {
+        if (drawdown_ > thresholds_.drawdown) {
+            halt_for(RiskRule::DRAWDOWN);
+        } else if (equity - day_start_equity_ < -thresholds_.daily_loss) {
+            halt_for(RiskRule::DAILY_LOSS);
+        }
     }
+    return halted_;
 }
 
-bool RiskEngine::check_drawdown(const Portfolio& portfolio, double peak_equity) {
+bool RiskEngine::check_drawdown(const Portfolio& portfolio, double peak_equity) const {
     /**
      * Section 8.4 - Drawdown Check
      */
@@ -91,55 +174,46 @@ bool RiskEngine::check_drawdown(const Portfolio& portfolio, double peak_equity)
     double current_equity = portfolio.equity();
     double drawdown = (peak_equity - current_equity) / peak_equity;
     
-    if (drawdown > limits_.max_drawdown) {
-        return false;
-    }
-    
-    return true;
+    return drawdown <= limits_.max_drawdown;
 }
 
-bool RiskEngine::check_position_limit(const Portfolio& portfolio, uint32_t symbol_id, double proposed_size) {
+bool RiskEngine::check_position_limit(const Portfolio& portfolio, uint32_t symbol_id, double proposed_size) const {
     /**
      * Section 8.4 - Position Limit Check
      */
     
-    const Position& pos = portfolio.get_position(symbol_id);
+    Position pos = portfolio.get_position(symbol_id);
     double total_position = std::abs(pos.quantity) + std::abs(proposed_size);
     
     return total_position <= limits_.max_position_size;
 }
 
-bool RiskEngine::check_daily_loss(double pnl_change) {
-    /**
-     * Section 8.4 - Daily Loss Limit
-     */
-    
-    daily_pnl_ += pnl_change;
-    
-    if (daily_pnl_ < -limits_.max_daily_loss && limits_.max_daily_loss > 0) {
-        std::cout << "[Risk] Daily loss limit exceeded: " << daily_pnl_ << std::endl;
-        return false;
-    }
-    
-    return true;
+uint64_t RiskEngine::total_rejections() const {
+    return std::accumulate(rejections_.begin(), rejections_.end(), uint64_t{0});
 }
 
-void RiskEngine::reset_daily() {
-    daily_pnl_ = 0.0;
+void RiskEngine::halt_for(RiskRule reason) {
+    halted_ = true;
+    halt_reason_ = reason;
+    if (verbose_) {
+        std::cout << "[Risk] System HALTED (" << risk_rule_name(reason) << ")" << std::endl;
+    }
 }
 
 void RiskEngine::halt() {
-    halted_ = true;
-    std::cout << "[Risk] System HALTED" << std::endl;
+    if (!halted_) halt_for(RiskRule::HALTED);
 }
 
 void RiskEngine::reset() {
     halted_ = false;
-    daily_pnl_ = 0.0;
+    halt_reason_ = RiskRule::COUNT;
+    peak_equity_ = last_equity_;
+    drawdown_ = 0.0;
+    day_start_equity_ = last_equity_;
 }
 
-// bool RiskEngine::is_halted() const {
-//     return halted_;
-// }
+void RiskEngine::reset_daily() {
+    day_start_equity_ = last_equity_;
+}
 
-} // namespace felix
\ No newline at end of file
+} // namespace felix
@@ -6,7 +6,8 @@ from datetime import datetime
 
 
 def compute_returns(equity_curve: List[float]) -> np.ndarray:
-    eq = np.array(equity_curve)
+    # asarray: engine exports (Portfolio.equity_array()["equity"]) are used without a copy
+    eq = np.asarray(equity_curve, dtype=np.float64)
     returns = np.diff(eq) / eq[:-1]
     return returns
 
@@ -29,24 +30,17 @@ def sortino_ratio(returns: np.ndarray, risk_free_rate: float = 0.0, periods_per_
 
 
 def max_drawdown(equity_curve: List[float]) -> Tuple[float, int, int]:
-    eq = np.array(equity_curve)
-    peak = eq[0]
-    peak_idx = 0
-    max_dd = 0.0
-    max_dd_peak_idx = 0
-    max_dd_trough_idx = 0
-    
-    for i, val in enumerate(eq):
-        if val > peak:
-            peak = val
-            peak_idx = i
-        dd = (peak - val) / peak
-        if dd > max_dd:
-            max_dd = dd
-            max_dd_peak_idx = peak_idx
-            max_dd_trough_idx = i
-    
-    return max_dd, max_dd_peak_idx, max_dd_trough_idx
+    eq = np.asarray(equity_curve, dtype=np.float64)
+    if eq.size == 0:
+        return 0.0, 0, 0
+    peaks = np.maximum.accumulate(eq)
+    drawdowns = (peaks - eq) / peaks
+    trough_idx = int(np.argmax(drawdowns))
+    max_dd = float(drawdowns[trough_idx])
+    if max_dd <= 0.0:
+        return 0.0, 0, 0
+    peak_idx = int(np.argmax(eq[:trough_idx + 1]))
+    return max_dd, peak_idx, trough_idx
 
 
 def cagr(equity_curve: List[float], periods_per_year: int = 252) -> float:
@@ -58,35 +52,56 @@ def cagr(equity_curve: List[float], periods_per_year: int = 252) -> float:
     return (equity_curve[-1] / equity_curve[0]) ** (1 / years) - 1
 
 
-def win_rate(trades: List[dict]) -> float:
-    if not trades:
+def _is_trade_array(trades) -> bool:
+    # Structured array from Portfolio.trades_array()
+    return isinstance(trades, np.ndarray) and trades.dtype.names is not None
+
+
+def trade_pnls(trades) -> np.ndarray:
+    if _is_trade_array(trades):
+        return trades['pnl']
+    return np.asarray([t.get('pnl', 0) for t in trades], dtype=np.float64)
+
+
+def trade_records(trades) -> List[dict]:
+    if _is_trade_array(trades):
+        names = trades.dtype.names
+        return [dict(zip(names, row)) for row in trades.tolist()]
+    return list(trades)
+
+
+def win_rate(trades) -> float:
+    pnls = trade_pnls(trades)
+    if len(pnls) == 0:
         return 0.0
-    wins = sum(1 for t in trades if t.get('pnl', 0) > 0)
-    return wins / len(trades)
+    return float(np.count_nonzero(pnls > 0)) / len(pnls)
 
 
-def average_win_loss(trades: List[dict]) -> Tuple[float, float]:
-    wins = [t['pnl'] for t in trades if t.get('pnl', 0) > 0]
-    losses = [t['pnl'] for t in trades if t.get('pnl', 0) < 0]
-    avg_win = np.mean(wins) if wins else 0.0
-    avg_loss = np.mean(losses) if losses else 0.0
+def average_win_loss(trades) -> Tuple[float, float]:
+    pnls = trade_pnls(trades)
+    wins = pnls[pnls > 0]
+    losses = pnls[pnls < 0]
+    avg_win = float(np.mean(wins)) if len(wins) else 0.0
+    avg_loss = float(np.mean(losses)) if len(losses) else 0.0
     return avg_win, avg_loss
 
 
 
 class BacktestResults:
-    def __init__(self, equity_curve: List[float], trades: List[dict], 
+    def __init__(self, equity_curve: List[float], trades, 
                  initial_capital: float = 100000.0,
                  start_date: datetime = None, end_date: datetime = None):
-        self.equity_curve = equity_curve
+        # equity_curve stays a list for callers; metrics use the array view
+        self.equity_array = np.asarray(equity_curve, dtype=np.float64)
+        self.equity_curve = self.equity_array.tolist()
         self.trades = trades
         self.initial_capital = initial_capital
         self.starts_at = start_date
         self.ends_at = end_date
-        self.returns = compute_returns(equity_curve) if len(equity_curve) > 1 else np.array([])
+        self.returns = compute_returns(self.equity_array) if len(self.equity_array) > 1 else np.array([])
         
     def summary(self) -> dict:
-        max_dd, peak_idx, trough_idx = max_drawdown(self.equity_curve)
+        max_dd, peak_idx, trough_idx = max_drawdown(self.equity_array)
         avg_win, avg_loss = average_win_loss(self.trades)
         
         # Calculate duration in years for correct annualization
@@ -98,21 +113,22 @@ class BacktestResults:
             if duration > 0:
                 years = duration / (365.25 * 24 * 3600)
                 # Dynamic periods per year based on tick resolution
-                if len(self.equity_curve) > 1:
-                    total_ticks = len(self.equity_curve)
+                if len(self.equity_array) > 1:
+                    total_ticks = len(self.equity_array)
                     periods_per_year = total_ticks / years
 
         # Re-calc CAGR with time
         cagr_val = 0.0
-        final_eq = self.equity_curve[-1] if self.equity_curve else self.initial_capital
+        has_curve = len(self.equity_array) > 0
+        final_eq = float(self.equity_array[-1]) if has_curve else self.initial_capital
         if years > 0 and self.initial_capital > 0 and final_eq > 0:
              cagr_val = (final_eq / self.initial_capital) ** (1 / years) - 1
 
         return {
             'initial_capital': self.initial_capital,
-            'final_equity': self.equity_curve[-1] if self.equity_curve else self.initial_capital,
-            'total_pnl': self.equity_curve[-1] - self.initial_capital if self.equity_curve else 0.0,
-            'total_return_pct': (self.equity_curve[-1] / self.initial_capital - 1) * 100 if self.equity_curve else 0.0,
+            'final_equity': final_eq,
+            'total_pnl': final_eq - self.initial_capital if has_curve else 0.0,
+            'total_return_pct': (final_eq / self.initial_capital - 1) * 100 if has_curve else 0.0,
             'sharpe_ratio': sharpe_ratio(self.returns, periods_per_year=periods_per_year),
             'sortino_ratio': sortino_ratio(self.returns, periods_per_year=periods_per_year),
             'max_drawdown_pct': max_dd * 100,
@@ -153,7 +169,7 @@ class BacktestResults:
         data = {
             'summary': self.summary(),
             'equity_curve': self.equity_curve,
-            'trades': self.trades,
+            'trades': trade_records(self.trades),
         }
         with open(filepath, 'w') as f:
             json.dump(data, f, indent=2, default=str)
@@ -161,11 +177,12 @@ class BacktestResults:
     
     def export_trades_csv(self, filepath: str):
         """Export trade log to CSV."""
-        if not self.trades:
+        if len(self.trades) == 0:
             print("No trades to export.")
             return
+        records = trade_records(self.trades)
         with open(filepath, 'w', newline='') as f:
-            writer = csv.DictWriter(f, fieldnames=self.trades[0].keys())
+            writer = csv.DictWriter(f, fieldnames=records[0].keys())
             writer.writeheader()
-            writer.writerows(self.trades)
+            writer.writerows(records)
         print(f"Trade log exported to {filepath}")
@@ -0,0 +1,203 @@
+"""Reader for the engine's columnar results file (results_file.hpp).
+
+Tables are "fills", "trades" and "equity", returned as {column: array},
+plus the downsampled equity pyramid "equity_lod0".."equity_lodN"
+(downsample.hpp) that read_equity_level picks from for a chart's range.
+felix_engine.read_results decodes natively when the engine is importable;
+the NumPy decoder below reads the same files without it.
+"""
+import struct
+from typing import Dict, Iterable, List, Optional, Tuple
+
+import numpy as np
+
+MAGIC = b"FELIXRES"
+VERSION = 1
+
+_DTYPES = {0: np.uint8, 1: np.uint32, 2: np.uint64, 3: np.float64}
+_CODEC_RAW, _CODEC_DELTA_VARINT, _CODEC_XOR_DOUBLE = 0, 1, 2
+
+
+def _decode_deltas(data: np.ndarray, rows: int) -> np.ndarray:
+    # Zigzag varint deltas: each value ends at the first byte below 0x80
+    if rows == 0:
+        return np.zeros(0, dtype=np.uint64)
+    ends = np.flatnonzero(data < 0x80)
+    if len(ends) != rows or ends[-1] != len(data) - 1:
+        raise ValueError("bad varint column")
+    starts = np.concatenate(([0], ends[:-1] + 1))
+    shifts = 7 * (np.arange(len(data)) - np.repeat(starts, ends - starts + 1))
+    parts = (data & 0x7F).astype(np.uint64) << shifts.astype(np.uint64)
+    zz = np.bitwise_or.reduceat(parts, starts)
+    one = np.uint64(1)
+    deltas = (zz >> one) ^ (~(zz & one) + one)
+    return np.cumsum(deltas, dtype=np.uint64)
+
+
+def _decode_doubles(data: np.ndarray, rows: int) -> np.ndarray:
+    # XOR with the previous value; header byte = leading << 4 | trailing zero bytes
+    headers = np.empty(rows, dtype=np.int64)
+    pos = 0
+    raw = data.tobytes()
+    for i in range(rows):
+        headers[i] = pos
+        h = raw[pos]
+        pos += 9 - (h >> 4) - (h & 0x0F)
+    if pos != len(data):
+        raise ValueError("bad double column")
+    if rows == 0:
+        return np.zeros(0, dtype=np.float64)
+    h = data[headers].astype(np.int64)
+    trail = h & 0x0F
+    lengths = 8 - (h >> 4) - trail
+    owner = np.repeat(np.arange(rows), lengths)
+    first = np.repeat(headers + 1, lengths)
+    offset = np.arange(lengths.sum()) - np.repeat(np.cumsum(lengths) - lengths, lengths)
+    shifts = (8 * (np.repeat(trail, lengths) + offset)).astype(np.uint64)
+    x = np.zeros(rows, dtype=np.uint64)
+    np.bitwise_or.at(x, owner, data[first + offset].astype(np.uint64) << shifts)
+    return np.bitwise_xor.accumulate(x).view(np.float64)
+
+
+def _scan(buf: bytes):
+    """Yield (table, rows, [(name, type, codec, offset, size)]) per complete chunk."""
+    if len(buf) < 16 or buf[:8] != MAGIC or struct.unpack_from("<I", buf, 8)[0] != VERSION:
+        raise ValueError("not a results file")
+    pos = 16
+    while pos < len(buf):
+        try:
+            n = buf[pos]
+            table = buf[pos + 1:pos + 1 + n].decode()
+            pos += 1 + n
+            rows, ncols = struct.unpack_from("<IB", buf, pos)
+            pos += 5
+            columns = []
+            for _ in range(ncols):
+                n = buf[pos]
+                name = buf[pos + 1:pos + 1 + n].decode()
+                pos += 1 + n
+                ctype, codec, size = struct.unpack_from("<BBI", buf, pos)
+                pos += 6
+                if pos + size > len(buf):
+                    return   # Truncated: keep the chunks before it
+                columns.append((name, ctype, codec, pos, size))
+                pos += size
+        except (IndexError, UnicodeDecodeError, struct.error):
+            return
+        yield table, rows, columns
+
+
+def _decode(data: np.ndarray, rows: int, ctype: int, codec: int) -> np.ndarray:
+    dtype = _DTYPES[ctype]
+    if codec == _CODEC_RAW:
+        values = data.view(np.dtype(dtype).newbyteorder("<")).astype(dtype)
+    elif codec == _CODEC_DELTA_VARINT:
+        values = _decode_deltas(data, rows).astype(dtype)
+    elif codec == _CODEC_XOR_DOUBLE:
+        values = _decode_doubles(data, rows)
+    else:
+        raise ValueError(f"unknown codec {codec}")
+    if len(values) != rows:
+        raise ValueError("column length")
+    return values
+
+
+def _read(path: str) -> bytes:
+    with open(path, "rb") as f:
+        buf = f.read()
+    if len(buf) < 16 or buf[:8] != MAGIC:
+        raise ValueError(f"not a results file: {path}")
+    return buf
+
+
+def results_index(path: str) -> Dict[str, int]:
+    """Row count per table, from the chunk headers alone."""
+    counts: Dict[str, int] = {}
+    for table, rows, _ in _scan(_read(path)):
+        counts[table] = counts.get(table, 0) + rows
+    return counts
+
+
+def read_results_numpy(path: str, tables: Optional[Iterable[str]] = None) -> Dict[str, Dict[str, np.ndarray]]:
+    """Decode a results file with NumPy only; a truncated last chunk is dropped.
+
+    With `tables`, chunks of other tables are skipped without decoding.
+    """
+    buf = _read(path)
+    data = np.frombuffer(buf, dtype=np.uint8)
+    wanted = set(tables) if tables is not None else None
+
+    chunks: Dict[str, list] = {}
+    for table, rows, columns in _scan(buf):
+        if wanted is not None and table not in wanted:
+            continue
+        try:
+            decoded = {name: _decode(data[offset:offset + size], rows, ctype, codec)
+                       for name, ctype, codec, offset, size in columns}
+        except (ValueError, IndexError, KeyError):
+            break   # Corrupt: keep the chunks before it
+        chunks.setdefault(table, []).append(decoded)
+
+    return {table: {name: np.concatenate([c[name] for c in parts]) for name in parts[0]}
+            for table, parts in chunks.items()}
+
+
+def read_results(path: str, tables: Optional[Iterable[str]] = None) -> Dict[str, Dict[str, np.ndarray]]:
+    """{table: {column: array}}, decoded by the engine when it is available."""
+    try:
+        import felix_engine as fe
+    except ImportError:
+        return read_results_numpy(path, tables)
+    return fe.read_results(path, None if tables is None else list(tables))
+
+
+def read_results_frames(path: str, tables: Optional[Iterable[str]] = None) -> dict:
+    """One pandas DataFrame per table."""
+    import pandas as pd
+    return {table: pd.DataFrame(columns) for table, columns in read_results(path, tables).items()}
+
+
+def equity_levels(path: str) -> List[Tuple[str, int]]:
+    """(table, rows) of the equity pyramid, coarsest first, then the full curve."""
+    counts = results_index(path)
+    levels = sorted((t for t in counts if t.startswith("equity_lod")), key=lambda t: int(t[10:]))
+    return [(t, counts[t]) for t in levels + ["equity"] if t in counts]
+
+
+def read_equity_level(path: str, points: int = 2000, start: Optional[int] = None,
+                      end: Optional[int] = None) -> Dict[str, np.ndarray]:
+    """Equity and drawdown between start and end (ns, inclusive) at the coarsest
+    level that still has `points` points there; only that level is decoded.
+    "level" in the result names the table that was read.
+
+    Levels span the whole curve, so the coarsest one (a few thousand rows)
+    maps the time range to a share of the full curve's rows first.
+    """
+    levels = equity_levels(path)
+    if not levels:
+        return {}
+    total = levels[-1][1]
+    share = 1.0
+    if len(levels) > 1 and (start is not None or end is not None):
+        coarse = read_results(path, [levels[0][0]])[levels[0][0]]
+        lo = np.searchsorted(coarse["timestamp"], start if start is not None else 0, "left")
+        hi = np.searchsorted(coarse["timestamp"], end if end is not None else np.iinfo(np.uint64).max, "right")
+        first = coarse["index"][max(lo - 1, 0)]
+        last = coarse["index"][min(hi, len(coarse["index"]) - 1)]
+        share = (int(last) - int(first) + 1) / max(total, 1)
+
+    table = next((t for t, rows in levels if rows * share >= points), levels[-1][0])
+    columns = read_results(path, [table])[table]
+    if table == "equity":
+        # Full resolution: drawdown from the running peak, as the levels store it
+        equity = columns["equity"]
+        peak = np.maximum.accumulate(equity)
+        columns = {"index": np.arange(total, dtype=np.uint64), "timestamp": columns["timestamp"],
+                   "equity": equity,
+                   "drawdown": np.divide(peak - equity, peak, out=np.zeros_like(equity), where=peak > 0)}
+    ts = columns["timestamp"]
+    lo = np.searchsorted(ts, start, "left") if start is not None else 0
+    hi = np.searchsorted(ts, end, "right") if end is not None else len(ts)
+    out = {name: values[lo:hi] for name, values in columns.items()}
+    out["level"] = table
+    return out
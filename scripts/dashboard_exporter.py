@@ -1,4 +1,5 @@
 import csv
+import json
 import os
 import pandas as pd
 from datetime import datetime, timedelta
@@ -15,6 +16,7 @@ class DashboardExporter:
         """
         print(f"Exporting dashboard data to {self.output_dir}...")
         self._export_equity_curve(equity_curve, initial_capital)
+        self._export_equity_pyramid(equity_curve, initial_capital)
         self._export_baskets_and_trades(trades)
         print("Export Complete.")
 
@@ -34,6 +36,38 @@ class DashboardExporter:
         df = pd.DataFrame(data)
         df.to_csv(os.path.join(self.output_dir, "equity_curve.csv"), index=False)
 
+    def _export_equity_pyramid(self, equity_curve, initial_capital):
+        """
+        Downsampled copies of a long equity curve (equity_curve_lod0.csv is the
+        coarsest), with the full curve's drawdown, plus equity_pyramid.json so
+        a chart loads only the resolution its zoom needs
+        """
+        try:
+            import felix_engine as fe
+            import numpy as np
+        except ImportError:
+            return
+
+        start_date = datetime(2021, 1, 1)
+        day_ns = 86400 * 10**9
+        start_ns = int(start_date.timestamp()) * 10**9
+        timestamps = start_ns + np.arange(len(equity_curve), dtype=np.uint64) * day_ns
+        levels = fe.equity_pyramid(timestamps, np.asarray(equity_curve, dtype=np.float64))
+
+        manifest = {'full': {'file': 'equity_curve.csv', 'rows': len(equity_curve)}, 'levels': []}
+        for k, level in enumerate(levels):
+            name = f"equity_curve_lod{k}.csv"
+            pd.DataFrame({
+                'date': [(start_date + timedelta(days=int(i))).strftime('%Y-%m-%d') for i in level['index']],
+                'total_equity': [f"{eq:.2f}" for eq in level['equity']],
+                'capital': f"{initial_capital:.2f}",
+                'drawdown': [f"{dd:.6f}" for dd in level['drawdown']]
+            }).to_csv(os.path.join(self.output_dir, name), index=False)
+            manifest['levels'].append({'file': name, 'rows': len(level)})
+
+        with open(os.path.join(self.output_dir, "equity_pyramid.json"), 'w') as f:
+            json.dump(manifest, f, indent=2)
+
     def _export_baskets_and_trades(self, trades):
         basket_data = []
         trade_log = []
@@ -330,8 +330,9 @@ def main():
     total_pnl = final_equity - initial_capital
     total_return_pct = (total_pnl / initial_capital) * 100
     
-    equity_curve = portfolio.get_equity_values()
-    timestamps = portfolio.get_timestamps()
+    curve = portfolio.equity_array()  # zero-copy view over the engine's equity points
+    equity_curve = curve["equity"]
+    timestamps = curve["timestamp"]
     trades = strategy.get_trades()
     stats = strategy.get_stats()
     
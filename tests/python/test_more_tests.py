@@ -1,6 +1,7 @@
 import os
 import sys
 import struct
+import tempfile
 import unittest
 
 project_root = os.path.dirname(os.path.dirname(os.path.dirname(os.path.abspath(__file__))))
@@ -172,6 +173,53 @@ def run_stream(engine, portfolio, risk_engine, stream_file, strategy):
     }
 
 
+def indicator_references(prices, volumes, n, width):
+    """NumPy reference for each IndicatorKind on raw ticks (period n)"""
+    import numpy as np
+
+    p = np.asarray(prices, dtype=np.float64)
+    v = np.asarray(volumes, dtype=np.float64)
+    size = len(p)
+    ref = {name: np.full(size, np.nan) for name in
+           ("SMA", "EMA", "WMA", "STDDEV", "BOLLINGER", "UPPER", "LOWER",
+            "RSI", "ATR", "VWAP", "MIN", "MAX", "ZSCORE")}
+    for i in range(n - 1, size):
+        w = p[i - n + 1:i + 1]
+        mean, std = w.mean(), w.std()
+        ref["SMA"][i] = mean
+        ref["WMA"][i] = np.dot(w, np.arange(1, n + 1)) / (n * (n + 1) / 2)
+        ref["STDDEV"][i] = std
+        ref["BOLLINGER"][i] = mean
+        ref["UPPER"][i] = mean + width * std
+        ref["LOWER"][i] = mean - width * std
+        ref["VWAP"][i] = np.dot(w, v[i - n + 1:i + 1]) / v[i - n + 1:i + 1].sum()
+        ref["MIN"][i] = w.min()
+        ref["MAX"][i] = w.max()
+        ref["ZSCORE"][i] = (p[i] - mean) / std if std > 0 else 0.0
+    # EMA seeded with the first window's mean; RSI / ATR Wilder smoothed after a simple seed
+    alpha = 2.0 / (n + 1)
+    ema = p[:n].mean()
+    ref["EMA"][n - 1] = ema
+    for i in range(n, size):
+        ema += alpha * (p[i] - ema)
+        ref["EMA"][i] = ema
+    changes = np.diff(p)
+    gain, loss = np.maximum(changes, 0.0), np.maximum(-changes, 0.0)
+    avg_gain, avg_loss = gain[:n].mean(), loss[:n].mean()
+    for i in range(n, size):
+        if i > n:
+            avg_gain = (avg_gain * (n - 1) + gain[i - 1]) / n
+            avg_loss = (avg_loss * (n - 1) + loss[i - 1]) / n
+        ref["RSI"][i] = 100.0 - 100.0 / (1.0 + avg_gain / avg_loss) if avg_loss > 0 else (100.0 if avg_gain > 0 else 50.0)
+    ranges = np.concatenate(([0.0], np.abs(changes)))   # high = low = close on ticks
+    atr = ranges[:n].mean()
+    ref["ATR"][n - 1] = atr
+    for i in range(n, size):
+        atr = (atr * (n - 1) + ranges[i]) / n
+        ref["ATR"][i] = atr
+    return ref
+
+
 class TestMoreCriticalCases(unittest.TestCase):
     @classmethod
     def setUpClass(cls):
@@ -362,6 +410,1130 @@ class TestMoreCriticalCases(unittest.TestCase):
         self.assertGreater(res["ticks_processed"], 3, "Event loop should keep processing ticks")
         self.assertEqual(res["fills_generated"], 2, "But no more fills should occur after HALT")
 
+    def test_10_liquidity_cap_produces_partial_fills(self):
+        test_file = os.path.join(self.test_data_dir, "more_partial_fills.bin")
+        ticks = [create_test_tick(1_000_000_000 * (i + 1), 1, 100.0) for i in range(6)]  # 100 shown per side
+        write_test_data(test_file, ticks)
+
+        engine, portfolio, risk_engine = make_engine_portfolio_risk(initial_capital=100_000.0)
+        liquidity = fe.LiquidityConfig()
+        liquidity.cap_to_displayed = True
+        engine.set_liquidity_config(liquidity)
+
+        strat = ScriptedOrdersStrategy(engine, portfolio, [{"tick": 2, "side": "BUY", "size": 250}])
+        res = run_stream(engine, portfolio, risk_engine, test_file, strat)
+
+        volumes = [float(f.volume) for f in res["fills"]]
+        self.assertEqual(volumes, [100.0, 100.0, 50.0], "Fills must be capped at displayed size per tick")
+        self.assertEqual(len({f.order_id for f in res["fills"]}), 1, "All fills belong to one parent order")
+        self.assertAlmostEqual(portfolio.get_position(1).quantity, 250.0, delta=1e-9)
+        self.assertEqual(engine.pending_order_count(), 0)
+
+    def test_11_stochastic_slippage_is_reproducible(self):
+        test_file = os.path.join(self.test_data_dir, "more_seeded_slippage.bin")
+        ticks = [create_test_tick(1_000_000_000 * (i + 1), 1, 100.0) for i in range(6)]
+        write_test_data(test_file, ticks)
+
+        def run_once(seed):
+            engine, portfolio, risk_engine = make_engine_portfolio_risk(initial_capital=100_000.0, slippage_bps=5.0)
+            slippage = fe.SlippageConfig()
+            slippage.fixed_bps = 5.0
+            slippage.use_stochastic = True
+            slippage.stochastic_std = 3.0
+            slippage.seed = seed
+            engine.set_slippage_config(slippage)
+            strat = ScriptedOrdersStrategy(
+                engine,
+                portfolio,
+                [{"tick": 2, "side": "BUY", "size": 10}, {"tick": 4, "side": "SELL", "size": 10}],
+            )
+            res = run_stream(engine, portfolio, risk_engine, test_file, strat)
+            return [(f.order_id, f.slippage) for f in res["fills"]]
+
+        first = run_once(1234)
+        self.assertEqual(first, run_once(1234), "Same seed must reproduce every fill")
+        for order_id, slippage in first:
+            expected = max(0.0, 5.0 + 3.0 * fe.philox_normal(1234, order_id, 0))
+            self.assertAlmostEqual(slippage, expected, delta=1e-12)
+
+    def test_12_fast_forward_matches_full_replay(self):
+        test_file = os.path.join(self.test_data_dir, "more_fast_forward.bin")
+        prices = [100.0, 100.5, 101.0, 100.2, 99.0, 98.0, 97.5, 99.5, 102.0, 103.0]
+        ticks = [create_test_tick(1_000_000_000 * (i + 1), 1, p) for i, p in enumerate(prices)]
+        write_test_data(test_file, ticks)
+
+        def run_once(fast_forward):
+            engine, portfolio, risk_engine = make_engine_portfolio_risk(initial_capital=100_000.0)
+            strat = ScriptedOrdersStrategy(engine, portfolio, [])
+            stream = fe.DataStream()
+            stream.load(test_file)
+            loop = fe.EventLoop()
+            loop.set_matching_engine(engine)
+            loop.set_portfolio(portfolio)
+            loop.set_risk_engine(risk_engine)
+            loop.set_fast_forward(fast_forward)
+            wake = fe.WakeFilter()
+            wake.enabled = True
+            wake.price_below = 98.5  # only wake the strategy on a sharp drop
+            loop.set_wake_filter(wake)
+            resting = fe.Order()
+            resting.symbol_id = 1
+            resting.side = fe.Side.BUY
+            resting.order_type = fe.OrderType.LIMIT
+            resting.size = 10
+            resting.price = 99.1
+            resting.timestamp = 0
+            engine.submit_order(resting)
+            loop.run(stream, strat, engine, portfolio)
+            return loop, strat, portfolio
+
+        full_loop, full_strat, full_portfolio = run_once(False)
+        fast_loop, fast_strat, fast_portfolio = run_once(True)
+
+        self.assertEqual(full_strat.tick_count, 2, "Strategy only wakes below the filter price")
+        self.assertEqual(fast_strat.tick_count, full_strat.tick_count)
+        self.assertGreater(fast_loop.ticks_fast_forwarded(), 0)
+        self.assertEqual(full_loop.ticks_fast_forwarded(), 0)
+        self.assertEqual([(f.order_id, f.price) for f in fast_strat.fills],
+                         [(f.order_id, f.price) for f in full_strat.fills])
+        self.assertEqual(fast_portfolio.get_equity_values(), full_portfolio.get_equity_values())
+
+    def test_13_equity_sampling_and_spill(self):
+        test_file = os.path.join(self.test_data_dir, "more_equity_sampling.bin")
+        ticks = [create_test_tick(1_000_000_000 * (i + 1), 1, 100.0 + i) for i in range(25)]
+        write_test_data(test_file, ticks)
+
+        engine, portfolio, risk_engine = make_engine_portfolio_risk(initial_capital=100_000.0)
+        recording = fe.EquityRecordingConfig()
+        recording.sampling = fe.EquitySampling.EVERY_N_TICKS
+        recording.every_n_ticks = 10
+        recording.block_size = 2
+        recording.spill_path = os.path.join(self.test_data_dir, "no_such_dir", "more_equity_sampling.spill")
+        self.assertFalse(portfolio.set_equity_recording_config(recording))
+        recording.spill_path = os.path.join(self.test_data_dir, "more_equity_sampling.spill")
+        self.assertTrue(portfolio.set_equity_recording_config(recording))
+
+        strat = ScriptedOrdersStrategy(engine, portfolio, [{"tick": 1, "side": "BUY", "size": 10}])
+        res = run_stream(engine, portfolio, risk_engine, test_file, strat)
+
+        # Initial point, ticks 10 and 20, and the final tick flushed at the end of the run
+        expected_ts = [0] + [1_000_000_000 * n for n in (10, 20, 25)]
+        self.assertEqual(res["timestamps"], expected_ts)
+        self.assertGreater(portfolio.equity_spilled_bytes(), 0)
+        self.assertAlmostEqual(res["equity_curve"][-1], portfolio.equity(), delta=1e-9)
+        self.assertEqual([p.timestamp for p in portfolio.equity_curve()], expected_ts)
+
+    def test_14_numpy_export_views_engine_memory(self):
+        test_file = os.path.join(self.test_data_dir, "more_numpy_export.bin")
+        ticks = [create_test_tick(1_000_000_000 * (i + 1), 1, 100.0 + i) for i in range(6)]
+        write_test_data(test_file, ticks)
+
+        engine, portfolio, risk_engine = make_engine_portfolio_risk(initial_capital=100_000.0)
+        strat = ScriptedOrdersStrategy(
+            engine, portfolio, [{"tick": 2, "side": "BUY", "size": 10}, {"tick": 4, "side": "SELL", "size": 10}]
+        )
+        res = run_stream(engine, portfolio, risk_engine, test_file, strat)
+
+        curve = portfolio.equity_array()
+        self.assertFalse(curve.flags.writeable)
+        self.assertEqual(curve["equity"].tolist(), res["equity_curve"])
+        self.assertEqual(curve["timestamp"].tolist(), res["timestamps"])
+
+        fills = portfolio.fills_array()
+        self.assertEqual(fills["order_id"].tolist(), [f.order_id for f in res["fills"]])
+        self.assertEqual(fills["price"].tolist(), [f.price for f in res["fills"]])
+
+        orders = engine.orders_array()
+        self.assertEqual(len(orders), 2)
+        self.assertTrue((orders["status"] == int(fe.OrderStatus.FILLED)).all())
+
+    def test_15_native_performance_matches_python_metrics(self):
+        from felix.analytics import metrics
+
+        test_file = os.path.join(self.test_data_dir, "more_performance.bin")
+        prices = [100.0, 101.0, 99.5, 102.0, 98.0, 103.0, 104.5, 97.0, 101.0, 105.0]
+        ticks = [create_test_tick(1_000_000_000 * (i + 1), 1, p) for i, p in enumerate(prices)]
+        write_test_data(test_file, ticks)
+
+        engine, portfolio, risk_engine = make_engine_portfolio_risk(initial_capital=100_000.0)
+        strat = ScriptedOrdersStrategy(
+            engine, portfolio, [{"tick": 1, "side": "BUY", "size": 100}, {"tick": 6, "side": "SELL", "size": 100}]
+        )
+        res = run_stream(engine, portfolio, risk_engine, test_file, strat)
+
+        curve = res["equity_curve"]
+        returns = metrics.compute_returns(curve)
+        max_dd, peak_idx, trough_idx = metrics.max_drawdown(curve)
+
+        for summary in (portfolio.performance_summary(), fe.compute_performance(curve)):
+            self.assertAlmostEqual(summary.sharpe_ratio, metrics.sharpe_ratio(returns), delta=1e-9)
+            self.assertAlmostEqual(summary.sortino_ratio, metrics.sortino_ratio(returns), delta=1e-9)
+            self.assertAlmostEqual(summary.max_drawdown, max_dd, delta=1e-12)
+            self.assertEqual((summary.max_drawdown_peak, summary.max_drawdown_trough), (peak_idx, trough_idx))
+            self.assertAlmostEqual(summary.cagr, metrics.cagr(curve), delta=1e-9)
+
+        native = portfolio.performance_summary()
+        self.assertEqual(native.total_trades, 1)
+        self.assertEqual(native.win_rate, 1.0)
+
+        # No drawdown is measured until the curve has a positive peak
+        from_zero = fe.compute_performance([0.0, -5.0, 10.0, 5.0])
+        self.assertAlmostEqual(from_zero.max_drawdown, 0.5, delta=1e-12)
+        self.assertEqual((from_zero.max_drawdown_peak, from_zero.max_drawdown_trough), (2, 3))
+
+        # BacktestResults keeps equity_curve a list, with the array alongside
+        results = metrics.BacktestResults(portfolio.equity_array()["equity"], [], 100_000.0)
+        self.assertIsInstance(results.equity_curve, list)
+        self.assertEqual(results.equity_curve, list(curve))
+        self.assertAlmostEqual(results.summary()["max_drawdown_pct"], max_dd * 100, delta=1e-9)
+
+    def test_16_run_journal_diff(self):
+        test_file = os.path.join(self.test_data_dir, "more_journal.bin")
+        ticks = [create_test_tick(1_000_000_000 * (i + 1), 1, 100.0 + i) for i in range(8)]
+        write_test_data(test_file, ticks)
+
+        def run_once(name, slippage_bps):
+            engine, portfolio, risk_engine = make_engine_portfolio_risk(
+                initial_capital=100_000.0, slippage_bps=slippage_bps
+            )
+            strat = ScriptedOrdersStrategy(
+                engine, portfolio, [{"tick": 2, "side": "BUY", "size": 10}, {"tick": 5, "side": "SELL", "size": 10}]
+            )
+            stream = fe.DataStream()
+            stream.load(test_file)
+            loop = fe.EventLoop()
+            loop.set_matching_engine(engine)
+            loop.set_portfolio(portfolio)
+            loop.set_risk_engine(risk_engine)
+            journal = fe.JournalConfig()
+            journal.path = os.path.join(self.test_data_dir, name)
+            journal.hash_interval_ticks = 4
+            loop.set_journal_config(journal)
+            loop.run(stream, strat, engine, portfolio)
+            return journal.path
+
+        base = run_once("more_journal_a.fjl", 0.0)
+        same = run_once("more_journal_b.fjl", 0.0)
+        slipped = run_once("more_journal_c.fjl", 5.0)
+
+        records = fe.read_journal(base)
+        events = records["event"].tolist()
+        self.assertEqual(events[0], int(fe.JournalEvent.RUN_START))
+        self.assertEqual(events[-1], int(fe.JournalEvent.RUN_END))
+        self.assertEqual(events.count(int(fe.JournalEvent.FILL)), 2)
+        self.assertEqual(events.count(int(fe.JournalEvent.STATE_HASH)), 2)
+
+        self.assertTrue(fe.diff_journals(base, same).identical)
+        diff = fe.diff_journals(base, slipped)
+        self.assertFalse(diff.identical)
+        self.assertEqual(diff.left_event, fe.JournalEvent.FILL)
+        self.assertEqual(diff.index, events.index(int(fe.JournalEvent.FILL)))
+
+        # A resting order closes when it fills; a run that throws still leaves
+        # a readable journal and results file
+        prices = [100.0, 100.0, 100.0, 98.0, 97.0, 96.0]
+        resting_file = os.path.join(self.test_data_dir, "more_journal_resting.bin")
+        write_test_data(resting_file, [create_test_tick(1_000_000_000 * (i + 1), 1, p) for i, p in enumerate(prices)])
+
+        class RestingThenFail(ScriptedOrdersStrategy):
+            def on_tick(self, tick):
+                self.tick_count += 1
+                if self.tick_count == 2:
+                    order = fe.Order()
+                    order.symbol_id = tick.symbol_id
+                    order.side = fe.Side.BUY
+                    order.order_type = fe.OrderType.LIMIT
+                    order.size = 10
+                    order.price = 99.0
+                    order.timestamp = tick.timestamp
+                    self.engine.submit_order(order)
+                if self.tick_count == 5:
+                    raise RuntimeError("strategy failed")
+
+        engine, portfolio, risk_engine = make_engine_portfolio_risk()
+        stream = fe.DataStream()
+        stream.load(resting_file)
+        loop = fe.EventLoop()
+        loop.set_matching_engine(engine)
+        loop.set_portfolio(portfolio)
+        loop.set_risk_engine(risk_engine)
+        journal = fe.JournalConfig()
+        journal.path = os.path.join(self.test_data_dir, "more_journal_failed.fjl")
+        loop.set_journal_config(journal)
+        results = fe.ResultsFileConfig()
+        results.path = os.path.join(self.test_data_dir, "more_journal_failed.fxr")
+        loop.set_results_config(results)
+        with self.assertRaises(RuntimeError):
+            loop.run(stream, RestingThenFail(engine, portfolio, []), engine, portfolio)
+
+        records = fe.read_journal(journal.path)
+        events = records["event"].tolist()
+        self.assertEqual(events[0], int(fe.JournalEvent.RUN_START))
+        self.assertNotIn(int(fe.JournalEvent.RUN_END), events)
+        submit = records[records["event"] == int(fe.JournalEvent.ORDER_SUBMIT)][0]
+        close = records[records["event"] == int(fe.JournalEvent.ORDER_CLOSE)][0]
+        self.assertEqual(submit["timestamp"], 2_000_000_000)
+        self.assertEqual(close["timestamp"], 4_000_000_000)
+        self.assertEqual(len(fe.read_results(results.path)["fills"]), 1)
+
+    def test_17_daily_loss_rolls_over_and_rejections_are_counted(self):
+        test_file = os.path.join(self.test_data_dir, "more_daily_rollover.bin")
+        second = 1_000_000_000
+        day = 86_400 * second
+        # Lose 80 on each of two days: over the limit in total, not per day
+        points = [(second, 100.0), (2 * second, 100.0), (3 * second, 92.0),
+                  (day + second, 92.0), (day + 2 * second, 84.0), (day + 3 * second, 84.0)]
+        ticks = [create_test_tick(ts, 1, p) for ts, p in points]
+        write_test_data(test_file, ticks)
+
+        engine, portfolio, risk_engine = make_engine_portfolio_risk(
+            initial_capital=10_000.0,
+            max_daily_loss=100.0,
+            max_order_size=500,
+            max_position_size=1000,
+        )
+        strat = ScriptedOrdersStrategy(
+            engine, portfolio, [{"tick": 2, "side": "BUY", "size": 10}, {"tick": 6, "side": "BUY", "size": 600}]
+        )
+        res = run_stream(engine, portfolio, risk_engine, test_file, strat)
+
+        self.assertFalse(risk_engine.is_halted(), "Each day's loss stays under max_daily_loss")
+        self.assertAlmostEqual(risk_engine.daily_pnl(), -80.0, delta=1e-6)
+        self.assertAlmostEqual(res["final_equity"], 10_000.0 - 160.0, delta=1e-6)
+        self.assertEqual(len(res["fills"]), 1)
+        self.assertEqual(risk_engine.rejections(fe.RiskRule.ORDER_SIZE), 1)
+        self.assertEqual(risk_engine.total_rejections(), 1)
+        self.assertEqual(risk_engine.orders_checked(), 2)
+
+    def test_18_batch_submission_shares_one_risk_snapshot(self):
+        import numpy as np
+
+        engine, portfolio, risk_engine = make_engine_portfolio_risk(initial_capital=10_000.0, max_order_size=500)
+        engine.set_risk_engine(risk_engine)
+        engine.set_portfolio(portfolio)
+
+        def leg(symbol_id, side, size, price):
+            order = fe.Order()
+            order.symbol_id = symbol_id
+            order.side = side
+            order.size = size
+            order.price = price
+            return order
+
+        # Each buy fits in cash alone; the third no longer does after the first two
+        results = engine.submit_orders([
+            leg(1, fe.Side.BUY, 40, 100.0),
+            leg(2, fe.Side.BUY, 40, 100.0),
+            leg(3, fe.Side.BUY, 40, 100.0),
+            leg(1, fe.Side.SELL, 10, 100.0),
+        ])
+        self.assertEqual(results["order_id"].tolist(), [1, 2, 0, 4])
+        self.assertEqual(results["reject"][2], int(fe.RiskRule.CASH))
+        self.assertTrue((results["reject"][[0, 1, 3]] == int(fe.RiskRule.NONE)).all())
+
+        basket = np.zeros(2, dtype=[("symbol_id", "u4"), ("side", "u1"), ("size", "f8"), ("price", "f8")])
+        basket["symbol_id"] = [5, 6]
+        basket["side"] = int(fe.Side.BUY)
+        basket["size"] = [600, 10]
+        basket["price"] = [1.0, 1.0]
+        results = engine.submit_orders(basket)
+        self.assertEqual(results["reject"].tolist(), [int(fe.RiskRule.ORDER_SIZE), int(fe.RiskRule.NONE)])
+        self.assertEqual(engine.pending_order_count(), 4)
+        self.assertEqual(risk_engine.total_rejections(), 2)
+
+        # max_notional caps the batch's accepted total, not just each order
+        engine, portfolio, risk_engine = make_engine_portfolio_risk(initial_capital=10_000.0, max_notional=5_000.0)
+        engine.set_risk_engine(risk_engine)
+        engine.set_portfolio(portfolio)
+        results = engine.submit_orders([
+            leg(1, fe.Side.BUY, 30, 100.0),
+            leg(2, fe.Side.BUY, 30, 100.0),
+            leg(1, fe.Side.SELL, 10, 100.0),
+        ])
+        self.assertEqual(results["reject"].tolist(),
+                         [int(fe.RiskRule.NONE), int(fe.RiskRule.NOTIONAL), int(fe.RiskRule.NONE)])
+        self.assertEqual(risk_engine.rejections(fe.RiskRule.NOTIONAL), 1)
+
+        # Out-of-range enum values are rejected before anything is submitted
+        bad = np.zeros(1, dtype=[("symbol_id", "u4"), ("side", "i8"), ("size", "f8"), ("order_type", "i8")])
+        bad["side"] = 7
+        with self.assertRaises(ValueError):
+            engine.submit_orders(bad)
+        bad["side"] = int(fe.Side.SELL)
+        bad["order_type"] = 9
+        with self.assertRaises(ValueError):
+            engine.submit_orders(bad)
+        self.assertEqual(engine.pending_order_count(), 2)
+
+    def test_19_signal_array_mode_trades_target_changes(self):
+        import numpy as np
+
+        test_file = os.path.join(self.test_data_dir, "more_signals.bin")
+        ticks = [create_test_tick(1_000_000_000 * (i + 1), 1, 100.0 + i) for i in range(8)]
+        write_test_data(test_file, ticks)
+
+        engine, portfolio, risk_engine = make_engine_portfolio_risk(initial_capital=100_000.0)
+        stream = fe.DataStream()
+        stream.load(test_file)
+        loop = fe.EventLoop()
+        loop.set_matching_engine(engine)
+        loop.set_portfolio(portfolio)
+        loop.set_risk_engine(risk_engine)
+
+        # NaN holds the previous target
+        targets = np.array([np.nan, 10, np.nan, 10, -5, np.nan, 0, np.nan])
+        orders = loop.run_signals(stream, targets)
+
+        self.assertEqual(orders, 3, "Only target changes trade")
+        self.assertAlmostEqual(portfolio.get_position(1).quantity, 0.0, delta=1e-9)
+
+        with self.assertRaises(ValueError):
+            loop.run_signals(stream, targets[:4])
+
+    def test_20_native_indicators_update_before_on_tick(self):
+        import numpy as np
+
+        test_file = os.path.join(self.test_data_dir, "more_indicators.bin")
+        prices = [100.0, 102.0, 101.0, 105.0, 103.0, 99.0, 104.0, 104.0, 107.0, 100.0, 98.0, 101.0]
+        volumes = [1000, 3000, 2000, 5000, 4000, 1000, 2000, 3000, 1000, 6000, 2000, 4000]
+        ticks = [create_test_tick(1_000_000_000 * (i + 1), 1, p, v) for i, (p, v) in enumerate(zip(prices, volumes))]
+        ticks.insert(3, create_test_tick(3_500_000_000, 2, 50.0))
+        write_test_data(test_file, ticks)
+
+        kinds = ["SMA", "EMA", "WMA", "STDDEV", "BOLLINGER", "RSI", "ATR", "VWAP", "MIN", "MAX", "ZSCORE"]
+        indicators = fe.IndicatorSet()
+        handles = {name: indicators.add(getattr(fe.IndicatorKind, name), symbol_id=1, period=3, param=2.0)
+                   for name in kinds}
+        bands = handles["BOLLINGER"]
+
+        class Recorder(ScriptedOrdersStrategy):
+            def __init__(self, engine, portfolio):
+                super().__init__(engine, portfolio, [])
+                self.seen = []
+
+            def on_tick(self, tick):
+                if tick.symbol_id == 1:
+                    row = {name: indicators.value(h) for name, h in handles.items()}
+                    row["UPPER"] = indicators.upper(bands)
+                    row["LOWER"] = indicators.lower(bands)
+                    self.seen.append(row)
+
+        engine, portfolio, risk_engine = make_engine_portfolio_risk()
+        strat = Recorder(engine, portfolio)
+        stream = fe.DataStream()
+        stream.load(test_file)
+        loop = fe.EventLoop()
+        loop.set_matching_engine(engine)
+        loop.set_portfolio(portfolio)
+        loop.set_risk_engine(risk_engine)
+        loop.set_indicators(indicators)
+        loop.run(stream, strat, engine, portfolio)
+
+        self.assertEqual(len(strat.seen), len(prices))
+        self.assertTrue(all(v != v for v in strat.seen[1].values()), "NaN until the window is full")
+        reference = indicator_references(prices, volumes, 3, 2.0)
+        for name, expected in reference.items():
+            actual = np.array([row[name] for row in strat.seen])
+            np.testing.assert_allclose(actual, expected, atol=1e-9, equal_nan=True, err_msg=name)
+        self.assertEqual(indicators.updates(), len(kinds) * len(prices), "Other symbols do not touch these indicators")
+        self.assertAlmostEqual(indicators.values()[handles["SMA"]], strat.seen[-1]["SMA"], delta=1e-12)
+
+    def test_21_tick_window_views_recent_history(self):
+        test_file = os.path.join(self.test_data_dir, "more_tick_window.bin")
+        prices = [100.0 + i for i in range(10)]
+        ticks = [create_test_tick(1_000_000_000 * (i + 1), 1, p) for i, p in enumerate(prices)]
+        write_test_data(test_file, ticks)
+
+        config = fe.TickWindowConfig()
+        config.tick_capacity = 3
+        config.bar_capacity = 2
+        config.bar_ns = 4_000_000_000
+        window = fe.TickWindow(config)
+
+        class Recorder(ScriptedOrdersStrategy):
+            def __init__(self, engine, portfolio):
+                super().__init__(engine, portfolio, [])
+                self.history = []
+                self.closes = []
+
+            def on_tick(self, tick):
+                recent = window.ticks(tick.symbol_id)
+                self.history.append(recent["price"].tolist())
+                self.closes = window.bars(tick.symbol_id)["close"].tolist()
+
+        engine, portfolio, risk_engine = make_engine_portfolio_risk()
+        strat = Recorder(engine, portfolio)
+        stream = fe.DataStream()
+        stream.load(test_file)
+        loop = fe.EventLoop()
+        loop.set_matching_engine(engine)
+        loop.set_portfolio(portfolio)
+        loop.set_risk_engine(risk_engine)
+        loop.set_tick_window(window)
+        loop.run(stream, strat, engine, portfolio)
+
+        self.assertEqual(strat.history[0], [100.0])
+        self.assertEqual(strat.history[2], [100.0, 101.0, 102.0])
+        self.assertEqual(strat.history[-1], [107.0, 108.0, 109.0], "Oldest first, current tick last")
+        # Bars [0,4s) [4,8s) [8,12s): the last one is still open
+        self.assertEqual(strat.closes, [102.0, 106.0])
+        self.assertEqual(len(window.ticks(42)), 0)
+
+    def test_22_walk_forward_selects_in_sample_and_stitches_out_of_sample(self):
+        import numpy as np
+
+        test_file = os.path.join(self.test_data_dir, "more_walk_forward.bin")
+        ticks = [create_test_tick(1_000_000_000 * (i + 1), 1, 100.0 + i) for i in range(40)]
+        write_test_data(test_file, ticks)
+        stream = fe.DataStream()
+        stream.load(test_file)
+
+        # Candidate 0 stays flat, candidate 1 is long in a rising market
+        signals = np.zeros((2, len(ticks)))
+        signals[1, :] = 10.0
+
+        config = fe.WalkForwardConfig()
+        config.in_sample_ns = 10_000_000_000
+        config.out_of_sample_ns = 5_000_000_000
+        config.metric = fe.WalkForwardMetric.TOTAL_RETURN
+        config.threads = 4
+        result = fe.walk_forward(stream, signals, config)
+
+        self.assertEqual(len(result.folds), 6)
+        self.assertEqual(result.scores.shape, (6, 2))
+        self.assertTrue(all(f.best_candidate == 1 for f in result.folds))
+        self.assertTrue(all(f.in_sample_ticks == 10 and f.out_of_sample_ticks == 5 for f in result.folds))
+        curve = result.equity_curve
+        self.assertEqual(len(curve), 1 + 30, "Start point plus every out-of-sample tick")
+        self.assertTrue((np.diff(curve["timestamp"].astype(np.int64)) >= 0).all())
+        self.assertGreater(curve["equity"][-1], config.initial_capital)
+        self.assertAlmostEqual(result.out_of_sample.final_equity, curve["equity"][-1], delta=1e-9)
+
+        with self.assertRaises(ValueError):
+            fe.walk_forward(stream, signals[:, :10], config)
+
+        view = stream.view(10, 20)
+        self.assertEqual(view.size(), 10)
+        self.assertEqual(view.peek().timestamp, 11_000_000_000)
+
+    def test_23_monte_carlo_paths_are_seeded_and_summarized(self):
+        import numpy as np
+
+        pnls = np.array([120.0, -80.0, 45.0, -30.0, 200.0, -150.0, 60.0, 10.0])
+        config = fe.MonteCarloConfig()
+        config.paths = 200
+        config.seed = 7
+        config.threads = 4
+
+        shuffled = fe.monte_carlo_trades(pnls, 10_000.0, config)
+        self.assertEqual(len(shuffled.final_equity), 200)
+        self.assertEqual(len(shuffled.final_equity_pct), len(config.percentiles))
+        # A shuffle reorders the same trades: only the path, not the end, changes
+        self.assertTrue(np.allclose(shuffled.final_equity, 10_000.0 + pnls.sum()))
+        self.assertGreater(shuffled.max_drawdown.max(), shuffled.max_drawdown.min())
+
+        config.threads = 1
+        again = fe.monte_carlo_trades(pnls, 10_000.0, config)
+        self.assertTrue(np.array_equal(shuffled.max_drawdown, again.max_drawdown),
+                        "Same seed must give the same paths on any thread count")
+
+        config.with_replacement = True
+        bootstrap = fe.monte_carlo_trades(pnls, 10_000.0, config)
+        self.assertGreater(bootstrap.final_equity.std(), 0.0)
+        pct = bootstrap.final_equity_pct
+        self.assertTrue((np.diff(pct) >= 0).all())
+
+        equity = 10_000.0 * np.cumprod(1.0 + np.tile([0.01, -0.005, 0.002], 50))
+        config.block_size = 5
+        returns = fe.monte_carlo_returns(equity, config)
+        self.assertEqual(len(returns.sharpe), 200)
+
+    def test_24_multi_strategy_single_pass_with_books(self):
+        test_file = os.path.join(self.test_data_dir, "more_multi_strategy.bin")
+        ticks = [create_test_tick(1_000_000_000 * (i + 1), 1, 100.0 + i) for i in range(10)]
+        write_test_data(test_file, ticks)
+
+        def run(capital):
+            stream = fe.DataStream()
+            stream.load(test_file)
+            engine, combined, risk_engine = make_engine_portfolio_risk(200_000.0, max_position_size=10)
+            books = [fe.Portfolio(100_000.0), fe.Portfolio(100_000.0)]
+            first = ScriptedOrdersStrategy(engine, books[0], [{"tick": 1, "side": "BUY", "size": 6}])
+            second = ScriptedOrdersStrategy(engine, books[1], [{"tick": 4, "side": "BUY", "size": 6}])
+            loop = fe.EventLoop()
+            loop.set_matching_engine(engine)
+            loop.set_portfolio(combined)
+            loop.set_risk_engine(risk_engine)
+            loop.run_multi(stream, [(first, books[0]), (second, books[1])], engine, capital)
+            self.assertEqual(loop.ticks_processed(), len(ticks), "One pass for both strategies")
+            return combined, books, first, second
+
+        # Shared pool: the second buy would take the combined position past the limit
+        combined, books, first, second = run(fe.CapitalMode.SHARED)
+        self.assertEqual(combined.get_position(1).quantity, 6)
+        self.assertEqual([f.strategy_id for f in first.fills], [1])
+        self.assertEqual(second.fills, [])
+
+        # Isolated books: each strategy is checked against its own position
+        combined, books, first, second = run(fe.CapitalMode.ISOLATED)
+        self.assertEqual(combined.get_position(1).quantity, 12)
+        self.assertEqual([b.get_position(1).quantity for b in books], [6, 6])
+        self.assertEqual([f.strategy_id for f in second.fills], [2])
+        self.assertEqual(combined.fills_array()["strategy_id"].tolist(), [1, 2])
+        self.assertAlmostEqual(combined.equity() - 200_000.0,
+                               sum(b.equity() - 100_000.0 for b in books), delta=1e-6)
+
+    def test_25_python_strategy_sweep_runs_jobs_in_isolation(self):
+        test_file = os.path.join(self.test_data_dir, "more_strategy_sweep.bin")
+        ticks = [create_test_tick(1_000_000_000 * (i + 1), 1, 100.0 + i) for i in range(10)]
+        write_test_data(test_file, ticks)
+        stream = fe.DataStream()
+        stream.load(test_file)
+
+        # Jobs import their strategy by name, so it has to live in a module
+        module_dir = tempfile.TemporaryDirectory()
+        self.addCleanup(module_dir.cleanup)
+        with open(os.path.join(module_dir.name, "sweep_strategies.py"), "w") as f:
+            f.write(
+                "import felix_engine as fe\n"
+                "class BuyOnce:\n"
+                "    def __init__(self, engine, portfolio, size=1):\n"
+                "        self.engine, self.size, self.done = engine, size, False\n"
+                "    def on_tick(self, tick):\n"
+                "        if self.done:\n"
+                "            return\n"
+                "        self.done = True\n"
+                "        order = fe.Order()\n"
+                "        order.symbol_id = tick.symbol_id\n"
+                "        order.size = self.size\n"
+                "        order.timestamp = tick.timestamp\n"
+                "        self.engine.submit_order(order)\n"
+            )
+        sys.path.insert(0, module_dir.name)
+        self.addCleanup(sys.path.remove, module_dir.name)
+        self.addCleanup(sys.modules.pop, "sweep_strategies", None)
+
+        jobs = [fe.StrategyJob("sweep_strategies:BuyOnce", '{"size": %d}' % size) for size in (1, 5, 10)]
+        jobs.append(fe.StrategyJob("sweep_strategies:Missing"))
+        jobs[0].keep_curve = True
+
+        isolations = [fe.StrategyIsolation.THREAD]
+        if fe.SUBINTERPRETERS:
+            isolations.append(fe.StrategyIsolation.SUBINTERPRETER)
+        for isolation in isolations:
+            results = fe.run_strategies(stream, jobs, threads=2, isolation=isolation)
+            self.assertEqual([r.fills for r in results[:3]], [1, 1, 1])
+            gains = [r.summary.final_equity - 100_000.0 for r in results[:3]]
+            self.assertAlmostEqual(gains[1], 5 * gains[0], delta=1e-6)
+            self.assertAlmostEqual(gains[2], 10 * gains[0], delta=1e-6)
+            self.assertEqual(len(results[0].equity_curve), len(ticks) + 1)
+            self.assertIsNone(results[1].equity_curve)
+            self.assertFalse(results[3].ok)
+            self.assertIn("Missing", results[3].error)
+        self.assertEqual(stream.current_index(), 0, "Runs read views, not the shared cursor")
+
+    def test_26_native_callbacks_trade_through_the_c_abi(self):
+        import ctypes
+        import numpy as np
+
+        test_file = os.path.join(self.test_data_dir, "more_native_strategy.bin")
+        ticks = [create_test_tick(1_000_000_000 * (i + 1), 1, 100.0 + i) for i in range(6)]
+        write_test_data(test_file, ticks)
+        stream = fe.DataStream()
+        stream.load(test_file)
+        engine, portfolio, _ = make_engine_portfolio_risk()
+        loop = fe.EventLoop()
+        loop.set_matching_engine(engine)
+        loop.set_portfolio(portfolio)
+
+        # ctypes mirrors of felix_tick / felix_fill, checked against the exported dtypes
+        def as_struct(dtype):
+            kinds = {"u8": ctypes.c_uint64, "u4": ctypes.c_uint32, "i4": ctypes.c_int32,
+                     "f4": ctypes.c_float, "f8": ctypes.c_double}
+            fields = [(name, kinds[dtype.fields[name][0].str[1:]]) for name in dtype.names]
+            return type("View", (ctypes.Structure,), {"_fields_": fields})
+
+        abi = fe.strategy_abi()
+        self.assertEqual(abi["version"], 1)
+        Tick, FillView = as_struct(abi["tick_dtype"]), as_struct(abi["fill_dtype"])
+        self.assertEqual(ctypes.sizeof(Tick), abi["tick_dtype"].itemsize)
+        self.assertEqual(ctypes.sizeof(FillView), abi["fill_dtype"].itemsize)
+
+        submit = ctypes.CFUNCTYPE(ctypes.c_uint64, ctypes.c_void_p, ctypes.c_uint32, ctypes.c_int32,
+                                  ctypes.c_int32, ctypes.c_double, ctypes.c_double,
+                                  ctypes.c_uint64)(abi["submit"])
+        position = ctypes.CFUNCTYPE(ctypes.c_double, ctypes.c_void_p, ctypes.c_uint32)(abi["position"])
+        state = (ctypes.c_double * 2)()   # ticks seen, position after the fill
+
+        @ctypes.CFUNCTYPE(None, ctypes.c_void_p, ctypes.POINTER(Tick), ctypes.c_void_p)
+        def on_tick(ctx, tick, user):
+            seen = ctypes.cast(user, ctypes.POINTER(ctypes.c_double))
+            seen[0] += 1
+            if seen[0] == 2:
+                submit(ctx, tick.contents.symbol_id, int(fe.Side.BUY), int(fe.OrderType.MARKET), 10.0, 0.0, 0)
+
+        fills = []
+
+        @ctypes.CFUNCTYPE(None, ctypes.c_void_p, ctypes.POINTER(FillView), ctypes.c_void_p)
+        def on_fill(ctx, fill, user):
+            fills.append((fill.contents.price, fill.contents.volume, fill.contents.side))
+            ctypes.cast(user, ctypes.POINTER(ctypes.c_double))[1] = position(ctx, fill.contents.symbol_id)
+
+        address = lambda f: ctypes.cast(f, ctypes.c_void_p).value
+        orders = loop.run_native(stream, on_tick=address(on_tick), on_fill=address(on_fill),
+                                 state=ctypes.addressof(state))
+        self.assertEqual(orders, 1)
+        self.assertEqual(state[0], len(ticks))
+        self.assertEqual(fills, [(101.0, 10.0, int(fe.Side.BUY))])
+        self.assertEqual(state[1], 10.0)
+        self.assertEqual(portfolio.get_position(1).quantity, 10)
+
+        with self.assertRaises(ValueError):
+            loop.run_native(stream)
+
+    def test_27_results_file_round_trips_fills_trades_and_equity(self):
+        import numpy as np
+        from felix.analytics.results_file import read_results_numpy
+
+        test_file = os.path.join(self.test_data_dir, "more_results_file.bin")
+        ticks = [create_test_tick(1_000_000_000 * (i + 1), 1, 100.0 + i) for i in range(8)]
+        write_test_data(test_file, ticks)
+        stream = fe.DataStream()
+        stream.load(test_file)
+        engine, portfolio, _ = make_engine_portfolio_risk()
+        loop = fe.EventLoop()
+        loop.set_matching_engine(engine)
+        loop.set_portfolio(portfolio)
+
+        # Streamed during the run, in small chunks so the tables span several
+        streamed = os.path.join(self.test_data_dir, "more_results_streamed.fxr")
+        config = fe.ResultsFileConfig()
+        config.path = streamed
+        config.chunk_rows = 3
+        loop.set_results_config(config)
+        loop.run_signals(stream, np.array([np.nan, 10, np.nan, 0, 5, np.nan, -5, np.nan]))
+
+        exported = os.path.join(self.test_data_dir, "more_results_exported.fxr")
+        raw = os.path.join(self.test_data_dir, "more_results_raw.fxr")
+        self.assertTrue(fe.write_results(exported, portfolio))
+        self.assertTrue(fe.write_results(raw, portfolio, compress=False))
+        self.assertLess(os.path.getsize(exported), os.path.getsize(raw))
+
+        expected = {"fills": portfolio.fills_array(), "trades": portfolio.trades_array(),
+                    "equity": portfolio.equity_array()}
+        for path in (streamed, exported, raw):
+            for tables in (fe.read_results(path), read_results_numpy(path)):
+                for name, records in expected.items():
+                    self.assertEqual(set(tables[name]), set(records.dtype.names))
+                    for column, values in tables[name].items():
+                        self.assertTrue(np.array_equal(values, records[column]), f"{path} {name}.{column}")
+        self.assertEqual(len(expected["trades"]), 2)
+
+        # A cut-off file keeps its complete chunks
+        with open(streamed, "rb") as f:
+            data = f.read()
+        with open(streamed, "wb") as f:
+            f.write(data[:len(data) // 2])
+        rows = 0
+        for name, columns in read_results_numpy(streamed).items():
+            for column, values in columns.items():
+                self.assertTrue(np.array_equal(values, expected[name][column][:len(values)]))
+            rows += len(values)
+        self.assertLess(rows, sum(len(records) for records in expected.values()))
+
+
+    def test_28_equity_pyramid_keeps_drawdown_and_serves_zoom_levels(self):
+        import numpy as np
+        from felix.analytics.results_file import equity_levels, read_equity_level, read_results_numpy
+
+        # Noisy curve with one deep, narrow drawdown that a plain stride would miss
+        rng = np.random.default_rng(7)
+        equity = 10_000 + np.cumsum(rng.normal(0, 1, 20_000))
+        equity[12_345] -= 400
+        timestamps = np.arange(1, len(equity) + 1, dtype=np.uint64) * 1_000_000
+        peak = np.maximum.accumulate(equity)
+        drawdown = (peak - equity) / peak
+
+        picked = fe.lttb_indices(timestamps.astype(np.float64), equity, 500)
+        self.assertEqual(len(picked), 500)
+        self.assertEqual((picked[0], picked[-1]), (0, len(equity) - 1))
+        self.assertTrue(np.all(np.diff(picked.astype(np.int64)) > 0))
+
+        config = fe.EquityPyramidConfig()
+        config.base_points = 256
+        levels = fe.equity_pyramid(timestamps, equity, config)
+        self.assertGreater(len(levels), 1)
+        for k, level in enumerate(levels):
+            self.assertLessEqual(len(level), 256 * 4 ** k)
+            self.assertEqual(level["drawdown"].max(), drawdown.max())
+            self.assertEqual(level["equity"].max(), equity.max())
+            self.assertTrue(np.array_equal(level["equity"], equity[level["index"].astype(np.int64)]))
+
+        # Exported results carry the pyramid; narrower ranges read finer levels
+        test_file = os.path.join(self.test_data_dir, "more_pyramid.bin")
+        ticks = [create_test_tick(1_000_000_000 * (i + 1), 1, 100.0 + np.sin(i / 5.0)) for i in range(200)]
+        write_test_data(test_file, ticks)
+        stream = fe.DataStream()
+        stream.load(test_file)
+        engine, portfolio, _ = make_engine_portfolio_risk()
+        loop = fe.EventLoop()
+        loop.set_matching_engine(engine)
+        loop.set_portfolio(portfolio)
+        loop.run_signals(stream, np.where(np.arange(200) % 20 == 0, 10.0, np.nan))
+
+        path = os.path.join(self.test_data_dir, "more_pyramid.fxr")
+        results = fe.ResultsFileConfig()
+        results.path = path
+        results.pyramid.base_points = 8
+        results.pyramid.factor = 2
+        writer = fe.ResultsWriter()
+        self.assertTrue(writer.open(results))
+        with writer:
+            writer.append(portfolio)
+            self.assertGreater(writer.pyramid_levels(), 1)
+
+        names = [name for name, _ in equity_levels(path)]
+        self.assertEqual(names[0], "equity_lod0")
+        self.assertEqual(names[-1], "equity")
+        self.assertEqual(list(fe.read_results(path, ["equity_lod0"])), ["equity_lod0"])
+        self.assertEqual(list(read_results_numpy(path, ["equity_lod0"])), ["equity_lod0"])
+
+        ts = portfolio.equity_array()["timestamp"]
+        coarse = read_equity_level(path, points=8)
+        fine = read_equity_level(path, points=8, start=int(ts[10]), end=int(ts[40]))
+        self.assertEqual(coarse["level"], "equity_lod0")
+        self.assertGreater(names.index(fine["level"]), 0)
+        self.assertTrue(np.all((fine["timestamp"] >= ts[10]) & (fine["timestamp"] <= ts[40])))
+
+
+    def test_29_volatility_and_adv_estimators_track_the_stream(self):
+        import numpy as np
+
+        test_file = os.path.join(self.test_data_dir, "more_estimators.bin")
+        day_ns = 86_400 * 1_000_000_000
+        prices = [100.0, 100.5, 99.8, 101.2, 100.9, 102.0, 101.1, 100.4, 101.7, 102.3, 101.9, 103.0]
+        ticks = []
+        for i, price in enumerate(prices):
+            # Three ticks per day over four days; volume grows with the day
+            day = i // 3
+            ticks.append(create_test_tick(day * day_ns + (i % 3 + 1) * 1_000_000_000, 1, price, 1000 * (day + 1)))
+        write_test_data(test_file, ticks)
+
+        engine, portfolio, risk_engine = make_engine_portfolio_risk()
+        slippage = fe.SlippageConfig()
+        slippage.vol_decay = 0.9
+        slippage.adv_window_days = 2
+        engine.set_slippage_config(slippage)
+        run_stream(engine, portfolio, risk_engine, test_file, ScriptedOrdersStrategy(engine, portfolio, []))
+
+        # Ticks carry float32 prices; EWMA seeded with the first squared return
+        returns = np.diff(np.log(np.array(prices, dtype=np.float32).astype(np.float64)))
+        variance = returns[0] ** 2
+        for r in returns[1:]:
+            variance = 0.9 * variance + 0.1 * r * r
+        self.assertAlmostEqual(engine.get_volatility(1), np.sqrt(variance), delta=1e-12)
+
+        # Days 2 and 3 complete the window (3 * 2000, 3 * 3000); day 4 is still open
+        self.assertAlmostEqual(engine.get_adv(1), (6000 + 9000) / 2, delta=1e-9)
+
+        # Unknown symbols have no estimator state
+        self.assertEqual(engine.get_volatility(99), 0.0)
+        self.assertEqual(engine.get_adv(99), 0.0)
+
+
+    def test_30_symbol_table_dense_indices_are_stable(self):
+        big = 2_000_000  # Beyond the direct-lookup range, served by the sparse map
+        first_file = os.path.join(self.test_data_dir, "more_symbols_a.bin")
+        other_file = os.path.join(self.test_data_dir, "more_symbols_b.bin")
+        ids = [7, 3, 7, big, 3, big, 7, 3]
+        write_test_data(first_file, [create_test_tick(1_000_000_000 * (i + 1), sid, 100.0 + sid % 5)
+                                     for i, sid in enumerate(ids)])
+        write_test_data(other_file, [create_test_tick(1_000_000_000 * (i + 1), sid, 50.0)
+                                     for i, sid in enumerate([11, 3])])
+
+        stream = fe.DataStream()
+        stream.load(first_file)
+        table = stream.symbols()
+        self.assertEqual(table.symbols(), [7, 3, big])
+        self.assertEqual([table.find(sid) for sid in (7, 3, big)], [0, 1, 2])
+        self.assertEqual([table.symbol_id(i) for i in range(len(table))], [7, 3, big])
+        for unknown in (0, 5, 8, big + 1, 2**32 - 1):
+            self.assertEqual(table.find(unknown), fe.SymbolTable.NO_INDEX)
+        with self.assertRaises(ValueError):
+            table.symbol_id(3)
+
+        # Reloading rebuilds the same mapping, whatever was loaded in between
+        stream.load(other_file)
+        self.assertEqual(stream.symbols().symbols(), [11, 3])
+        stream.load(first_file)
+        self.assertEqual(stream.symbols().symbols(), table.symbols())
+
+        # Interning is idempotent and appends new ids after the existing ones
+        self.assertEqual(table.intern(big), 2)
+        self.assertEqual(table.intern(42), 3)
+        self.assertEqual(table.intern(7), 0)
+        self.assertEqual(len(table), 4)
+
+        # Positions land in the right dense slot, including the sparse id
+        engine, portfolio, risk_engine = make_engine_portfolio_risk()
+        strat = ScriptedOrdersStrategy(engine, portfolio, [
+            {"tick": 2, "side": "BUY", "size": 4},     # symbol 3
+            {"tick": 4, "side": "BUY", "size": 6},     # symbol big
+            {"tick": 7, "side": "BUY", "size": 1},     # symbol 7
+        ])
+        res = run_stream(engine, portfolio, risk_engine, first_file, strat)
+        self.assertEqual(len(res["fills"]), 3)
+        self.assertEqual(portfolio.get_position(3).quantity, 4)
+        self.assertEqual(portfolio.get_position(big).quantity, 6)
+        self.assertEqual(portfolio.get_position(7).quantity, 1)
+        self.assertEqual(portfolio.get_position(11).quantity, 0)
+        self.assertAlmostEqual(portfolio.get_position(big).avg_price, 100.0 + big % 5, delta=1e-9)
+
+
+    def test_31_closed_contingent_groups_are_recycled(self):
+        test_file = os.path.join(self.test_data_dir, "more_group_recycling.bin")
+        # Entry on even ticks, take-profit on the odd ticks
+        ticks = [create_test_tick(1_000_000_000 * (i + 1), 1, 100.0 if i % 2 == 0 else 102.0) for i in range(400)]
+        write_test_data(test_file, ticks)
+
+        class RepeatedBrackets(ScriptedOrdersStrategy):
+            def on_tick(self, tick):
+                self.tick_count += 1
+                if self.tick_count % 2 == 1:
+                    order = fe.create_market_order(tick.symbol_id, fe.Side.BUY, 1, tick.timestamp)
+                    order.price = tick.price
+                    self.engine.submit_bracket(order, 90.0, 101.0)
+
+        engine, portfolio, risk_engine = make_engine_portfolio_risk()
+        strat = RepeatedBrackets(engine, portfolio, [])
+        res = run_stream(engine, portfolio, risk_engine, test_file, strat)
+
+        # 200 round trips; every bracket closed, so one slot served them all
+        self.assertEqual(len(res["fills"]), 400)
+        self.assertEqual(portfolio.get_position(1).quantity, 0)
+        self.assertEqual(engine.pending_order_count(), 0)
+        self.assertEqual(engine.contingent_group_slots(), 1)
+
+
+    def test_32_consistency_check_confirms_running_totals(self):
+        import numpy as np
+
+        test_file = os.path.join(self.test_data_dir, "more_consistency.bin")
+        prices = {1: [100.0, 101.5, 99.25, 102.0, 98.5, 103.25, 100.75, 104.0],
+                  2: [50.0, 49.5, 51.25, 48.75, 52.0, 50.5, 53.25, 49.0]}
+        ticks = []
+        for i in range(8):
+            for sid in (1, 2):
+                ticks.append(create_test_tick(1_000_000_000 * (2 * i + sid), sid, prices[sid][i]))
+        write_test_data(test_file, ticks)
+
+        engine, portfolio, risk_engine = make_engine_portfolio_risk()
+        portfolio.set_consistency_check(True)
+        self.assertTrue(portfolio.consistency_check())
+        # Opens, adds and partial closes on two symbols (odd ticks are symbol 1)
+        strat = ScriptedOrdersStrategy(engine, portfolio, [
+            {"tick": 1, "side": "BUY", "size": 30},
+            {"tick": 2, "side": "BUY", "size": 40},
+            {"tick": 5, "side": "BUY", "size": 20},
+            {"tick": 8, "side": "SELL", "size": 25},
+            {"tick": 9, "side": "SELL", "size": 25},
+            {"tick": 12, "side": "SELL", "size": 10},
+        ])
+        res = run_stream(engine, portfolio, risk_engine, test_file, strat)
+        self.assertEqual(len(res["fills"]), 6)
+        self.assertEqual(portfolio.consistency_mismatches(), 0)
+
+        # Running totals equal a recomputation from the live positions
+        market = unrealized = realized = 0.0
+        for sid in (1, 2):
+            pos = portfolio.get_position(sid)
+            last = float(np.float32(prices[sid][-1]))
+            market += pos.quantity * last
+            unrealized += pos.quantity * (last - pos.avg_price)
+            realized += pos.realized_pnl
+        self.assertAlmostEqual(portfolio.market_value(), market, delta=1e-6)
+        self.assertAlmostEqual(portfolio.total_unrealized_pnl(), unrealized, delta=1e-6)
+        self.assertAlmostEqual(portfolio.total_realized_pnl(), realized, delta=1e-6)
+        self.assertAlmostEqual(portfolio.equity(), portfolio.cash() + market, delta=1e-6)
+
+        # Exported snapshots agree with the live state
+        self.assertEqual(len(portfolio.fills_array()), 6)
+        self.assertAlmostEqual(float(portfolio.equity_array()["equity"][-1]), portfolio.equity(), delta=1e-6)
+
+
+    def test_33_batched_revaluation_matches_per_symbol_updates(self):
+        import numpy as np
+
+        rng = np.random.default_rng(11)
+        symbols = np.array([1, 2, 3, 5, 8, 13, 21, 34, 55, 89, 144], dtype=np.uint32)
+        quantities = rng.integers(-50, 51, len(symbols)).astype(np.float64)
+        quantities[4] = 0.0   # Never traded, but priced like the rest
+
+        per_symbol = fe.Portfolio(1_000_000.0)
+        batched = fe.Portfolio(1_000_000.0)
+        for book in (per_symbol, batched):
+            for n, (sid, qty) in enumerate(zip(symbols, quantities)):
+                if qty == 0:
+                    continue
+                fill = fe.Fill()
+                fill.order_id = n + 1
+                fill.symbol_id = int(sid)
+                fill.side = fe.Side.BUY if qty >= 0 else fe.Side.SELL
+                fill.price = 100.0 + n
+                fill.volume = abs(qty)
+                fill.timestamp = 1_000
+                book.on_fill(fill)
+
+        for step in range(5):
+            # Every symbol repriced, plus one the book has never traded
+            ids = np.append(symbols, np.uint32(999))
+            prices = 100.0 + rng.normal(0, 5, len(ids))
+            for sid, price in zip(ids, prices):
+                per_symbol.update_prices(int(sid), float(price))
+            batched.update_prices_batch(ids, prices)
+
+            self.assertAlmostEqual(batched.equity(), per_symbol.equity(), delta=1e-6)
+            self.assertAlmostEqual(batched.total_unrealized_pnl(), per_symbol.total_unrealized_pnl(), delta=1e-6)
+            self.assertAlmostEqual(batched.market_value(), per_symbol.market_value(), delta=1e-6)
+
+            # SoA exposure scan against a NumPy reference
+            market = quantities * prices[:-1]
+            avg = np.array([batched.get_position(int(sid)).avg_price for sid in symbols])
+            for book in (batched, per_symbol):
+                book_exposure = book.exposure()
+                self.assertAlmostEqual(book_exposure.market_value, market.sum(), delta=1e-6)
+                self.assertAlmostEqual(book_exposure.unrealized_pnl, (quantities * (prices[:-1] - avg)).sum(), delta=1e-6)
+                self.assertAlmostEqual(book_exposure.gross_exposure, np.abs(market).sum(), delta=1e-6)
+                self.assertAlmostEqual(book_exposure.long_exposure, market[quantities > 0].sum(), delta=1e-6)
+                self.assertAlmostEqual(book_exposure.short_exposure, market[quantities < 0].sum(), delta=1e-6)
+                self.assertEqual(book_exposure.long_positions, int((quantities > 0).sum()))
+                self.assertEqual(book_exposure.short_positions, int((quantities < 0).sum()))
+
+    def test_34_daily_loss_halt_lifts_on_the_next_day(self):
+        test_file = os.path.join(self.test_data_dir, "more_daily_halt_lift.bin")
+        second = 1_000_000_000
+        day = 86_400 * second
+        # Lose 150 on day 1 (limit 100), then trade again on day 2
+        points = [(second, 100.0), (2 * second, 100.0), (3 * second, 85.0), (4 * second, 85.0),
+                  (day + second, 85.0), (day + 2 * second, 85.0)]
+        write_test_data(test_file, [create_test_tick(ts, 1, p) for ts, p in points])
+
+        plan = [{"tick": 2, "side": "BUY", "size": 10},
+                {"tick": 4, "side": "BUY", "size": 10},   # Day 1, halted: rejected
+                {"tick": 5, "side": "BUY", "size": 10}]   # Day 2: accepted
+        engine, portfolio, risk_engine = make_engine_portfolio_risk(
+            initial_capital=10_000.0, max_daily_loss=100.0, max_order_size=500, max_position_size=1000,
+        )
+        res = run_stream(engine, portfolio, risk_engine, test_file, ScriptedOrdersStrategy(engine, portfolio, plan))
+
+        self.assertFalse(risk_engine.is_halted(), "A daily loss halt lifts at the day rollover")
+        self.assertEqual(len(res["fills"]), 2)
+        self.assertEqual(portfolio.get_position(1).quantity, 20)
+        self.assertEqual(risk_engine.rejections(fe.RiskRule.HALTED), 1)
+
+        # Reusing the risk engine: start() clears a manual halt and the counters
+        risk_engine.halt()
+        engine, portfolio, _ = make_engine_portfolio_risk(
+            initial_capital=10_000.0, max_daily_loss=100.0, max_order_size=500, max_position_size=1000,
+        )
+        res = run_stream(engine, portfolio, risk_engine, test_file, ScriptedOrdersStrategy(engine, portfolio, plan))
+
+        self.assertEqual(len(res["fills"]), 2)
+        self.assertEqual(risk_engine.rejections(fe.RiskRule.HALTED), 1)
+        self.assertEqual(risk_engine.orders_checked(), 3)
+
+    def test_35_signal_mode_drops_cancelled_orders_from_outstanding(self):
+        import numpy as np
+
+        test_file = os.path.join(self.test_data_dir, "more_signal_cancel.bin")
+        write_test_data(test_file, [create_test_tick(1_000_000_000 * (i + 1), 1, 100.0) for i in range(6)])
+        # The BUY 10 is still resting when the target drops to 4
+        targets = np.array([10, 4, np.nan, np.nan, np.nan, np.nan])
+
+        for cancel_unfilled in (False, True):
+            engine, portfolio, risk_engine = make_engine_portfolio_risk(
+                initial_capital=100_000.0, strategy_latency_ns=1_500_000_000
+            )
+            stream = fe.DataStream()
+            stream.load(test_file)
+            loop = fe.EventLoop()
+            loop.set_matching_engine(engine)
+            loop.set_portfolio(portfolio)
+            loop.set_risk_engine(risk_engine)
+            orders = loop.run_signals(stream, targets, cancel_unfilled=cancel_unfilled)
+
+            # Netted: BUY 10 then SELL 6. Replaced: the cancelled BUY 10 no
+            # longer counts, so the new order is BUY 4, not SELL 6
+            statuses = [o.status for o in engine.order_history()]
+            self.assertEqual(orders, 2)
+            self.assertEqual(portfolio.get_position(1).quantity, 4)
+            self.assertEqual(statuses.count(fe.OrderStatus.CANCELLED), int(cancel_unfilled))
+
+    def test_36_monte_carlo_execution_perturbs_slippage_and_latency(self):
+        import numpy as np
+
+        test_file = os.path.join(self.test_data_dir, "more_monte_carlo_execution.bin")
+        write_test_data(test_file, [create_test_tick(1_000_000_000 * (i + 1), 1, 100.0 + i) for i in range(40)])
+        stream = fe.DataStream()
+        stream.load(test_file)
+        signals = np.full(40, np.nan)
+        signals[[0, 20, 25, 35]] = [10, 0, 10, 0]
+
+        # Reference: the same signals through the event loop, unperturbed
+        engine, portfolio, _ = make_engine_portfolio_risk(100_000.0)
+        loop = fe.EventLoop()
+        loop.set_matching_engine(engine)
+        loop.set_portfolio(portfolio)
+        loop.run_signals(stream, signals)
+        base = portfolio.equity()
+
+        backtest = fe.SignalBacktestConfig()
+        config = fe.MonteCarloConfig()
+        config.paths = 16
+        config.seed = 3
+        config.threads = 4
+        perturbation = fe.ExecutionPerturbation()
+        flat = fe.monte_carlo_execution(stream, signals, backtest, perturbation, config)
+        self.assertTrue(np.allclose(flat.final_equity, base), "No perturbation reproduces the backtest")
+
+        # Extra slippage only ever costs
+        perturbation.slippage_bps_std = 5.0
+        slipped = fe.monte_carlo_execution(stream, signals, backtest, perturbation, config)
+        self.assertTrue((slipped.final_equity < base).all())
+        self.assertGreater(slipped.final_equity.std(), 0.0)
+
+        perturbation.latency_jitter_ns = 2_000_000_000
+        jittered = fe.monte_carlo_execution(stream, signals, backtest, perturbation, config)
+        config.threads = 1
+        again = fe.monte_carlo_execution(stream, signals, backtest, perturbation, config)
+        self.assertTrue(np.array_equal(jittered.final_equity, again.final_equity),
+                        "Same seed must give the same paths on any thread count")
+        self.assertEqual(len(jittered.final_equity_pct), len(config.percentiles))
+
+        with self.assertRaises(ValueError):
+            fe.monte_carlo_execution(stream, signals[:10], backtest, perturbation, config)
+
+    def test_37_reused_loop_wakes_the_strategy_after_a_drawdown_halt(self):
+        test_file = os.path.join(self.test_data_dir, "more_drawdown_rerun.bin")
+        prices = [100.0, 50.0, 50.0, 50.0]
+        write_test_data(test_file, [create_test_tick(1_000_000_000 * (i + 1), 1, p) for i, p in enumerate(prices)])
+
+        loop = fe.EventLoop()
+        _, _, risk_engine = make_engine_portfolio_risk(max_drawdown=0.001)
+        for _ in range(2):
+            engine, portfolio, _ = make_engine_portfolio_risk()
+            strat = ScriptedOrdersStrategy(engine, portfolio, [{"tick": 1, "side": "BUY", "size": 10}])
+            stream = fe.DataStream()
+            stream.load(test_file)
+            loop.set_matching_engine(engine)
+            loop.set_portfolio(portfolio)
+            loop.set_risk_engine(risk_engine)
+            loop.run(stream, strat, engine, portfolio)
+
+            # Woken on the first tick, then the drawdown halt stops it
+            self.assertEqual(strat.tick_count, 1)
+            self.assertEqual(risk_engine.halt_reason(), fe.RiskRule.DRAWDOWN)
+
 
 if __name__ == "__main__":
     unittest.main(verbosity=2)
\ No newline at end of file
@@ -469,6 +469,29 @@ class TestEdgeCases(unittest.TestCase):
         
         print("✓ PASSED")
 
+    def test_13_trade_ledger_flip(self):
+        """Buy 100 @ $100, Sell 150 @ $110, Buy 50 @ $105 -> two round trips"""
+        print("\n" + "="*60)
+        print("TEST: Trade Ledger Through a Flip")
+        print("="*60)
+        
+        prices = [100.0, 100.0, 110.0, 110.0, 105.0, 105.0]
+        ticks = [create_test_tick(1000000000 * (i+1), 1, p) for i, p in enumerate(prices)]
+        write_test_data(self.test_file, ticks)
+        
+        result = run_backtest(self.test_file, [(1, 'BUY', 100), (3, 'SELL', 150), (5, 'BUY', 50)])
+        portfolio = result['portfolio']
+        trades = portfolio.trades_array()
+        
+        # Long 100: +$1,000; short 50 from $110 covered at $105: +$250
+        self.assertEqual(len(trades), 2)
+        self.assertEqual(trades['quantity'].tolist(), [100.0, 50.0])
+        self.assertEqual(trades['pnl'].tolist(), [1000.0, 250.0])
+        self.assertEqual(int(trades['side'][1]), int(fe.Side.SELL))
+        self.assertAlmostEqual(float(trades['pnl'].sum()), portfolio.total_realized_pnl(), delta=1e-9)
+        
+        print("✓ PASSED")
+
 
 if __name__ == "__main__":
     print("="*60)
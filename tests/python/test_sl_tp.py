@@ -127,6 +127,44 @@ class SLTPStrategy(Strategy):
         pass
 
 
+class NativeBracketStrategy(Strategy):
+    """Submits one native bracket order; exits are managed by the engine"""
+    
+    def __init__(self, engine, portfolio, entry_tick, entry_size,
+                 stop_loss=0.0, take_profit=0.0, trail_offset=0.0, trail_percent=False):
+        self.engine = engine
+        self.portfolio = portfolio
+        self.entry_tick = entry_tick
+        self.entry_size = entry_size
+        self.stop_loss = stop_loss
+        self.take_profit = take_profit
+        self.trail_offset = trail_offset
+        self.trail_percent = trail_percent
+        self.tick_count = 0
+        self.bracket = None
+        self.fills = []
+    
+    def on_start(self):
+        pass
+    
+    def on_tick(self, tick):
+        self.tick_count += 1
+        if self.tick_count == self.entry_tick:
+            order = fe.create_market_order(tick.symbol_id, fe.Side.BUY, self.entry_size, tick.timestamp)
+            order.price = tick.price
+            self.bracket = self.engine.submit_bracket(order, self.stop_loss, self.take_profit,
+                                                      self.trail_offset, self.trail_percent)
+    
+    def on_fill(self, fill):
+        self.fills.append({'order_id': fill.order_id, 'price': fill.price, 'volume': fill.volume})
+    
+    def on_bar(self, bar):
+        pass
+    
+    def on_end(self):
+        pass
+
+
 def create_engine_components(initial_capital=100000.0):
     """Create fresh engine components"""
     slippage = fe.SlippageConfig()
@@ -607,6 +645,58 @@ class TestSLTPCombined(unittest.TestCase):
         print("✓ PASSED")
 
 
+class TestNativeContingentOrders(unittest.TestCase):
+    """Bracket / OCO / trailing stops handled inside the engine"""
+    
+    @classmethod
+    def setUpClass(cls):
+        cls.test_data_dir = os.path.join(project_root, "data", "test")
+        os.makedirs(cls.test_data_dir, exist_ok=True)
+        cls.test_file = os.path.join(cls.test_data_dir, "test_native_bracket.bin")
+    
+    def _run(self, prices, **kwargs):
+        ticks = [create_test_tick(1000000000 * (i + 1), 1, float(p)) for i, p in enumerate(prices)]
+        write_test_data(self.test_file, ticks)
+        
+        stream = fe.DataStream()
+        stream.load(self.test_file)
+        engine, portfolio, risk_engine = create_engine_components()
+        strategy = NativeBracketStrategy(engine, portfolio, entry_tick=2, entry_size=100, **kwargs)
+        
+        event_loop = fe.EventLoop()
+        event_loop.set_matching_engine(engine)
+        event_loop.set_portfolio(portfolio)
+        event_loop.set_risk_engine(risk_engine)
+        event_loop.run(stream, strategy, engine, portfolio)
+        return engine, portfolio, strategy
+    
+    def test_11_bracket_stop_loss_cancels_take_profit(self):
+        engine, portfolio, strategy = self._run([100, 100, 100, 98, 96, 94, 93, 120], stop_loss=95.0, take_profit=110.0)
+        
+        self.assertEqual([f['order_id'] for f in strategy.fills],
+                         [strategy.bracket.entry_id, strategy.bracket.stop_loss_id])
+        self.assertAlmostEqual(strategy.fills[1]['price'], 94.0, delta=0.01)  # stops fill at last trade
+        self.assertEqual(portfolio.get_position(1).quantity, 0)
+        self.assertEqual(engine.pending_order_count(), 0, "Take-profit leg must be cancelled")
+    
+    def test_12_bracket_take_profit(self):
+        engine, portfolio, strategy = self._run([100, 100, 105, 111, 80], stop_loss=95.0, take_profit=110.0)
+        
+        self.assertEqual(len(strategy.fills), 2)
+        self.assertEqual(strategy.fills[1]['order_id'], strategy.bracket.take_profit_id)
+        self.assertEqual(portfolio.get_position(1).quantity, 0)
+        self.assertEqual(engine.pending_order_count(), 0)
+    
+    def test_13_native_trailing_stop_percent(self):
+        prices = [100, 100, 100, 105, 110, 115, 120, 118, 115, 112, 110]
+        engine, portfolio, strategy = self._run(prices, trail_offset=0.05, trail_percent=True)
+        
+        # High-water mark $120 -> stop $114, first tick at or below is $112
+        self.assertEqual(len(strategy.fills), 2)
+        self.assertAlmostEqual(strategy.fills[1]['price'], 112.0, delta=0.01)
+        self.assertEqual(portfolio.get_position(1).quantity, 0)
+
+
 if __name__ == "__main__":
     print("="*60)
     print("FELIX ENGINE - STOP LOSS & TAKE PROFIT TESTS")